@@ -33,19 +33,19 @@ else
     # Build Server
     echo "🔧 Building ServiceMN (Server)..."
     cd src/Server
-    g++ -std=c++17 -O3 -Wall -pthread -o ../../build/ServiceMN main.cpp ProcessRunner.cpp
+    g++ -std=c++20 -O3 -Wall -pthread -o ../../build/ServiceMN *.cpp
     cd ../..
     
     # Build Interface
     echo "🔧 Building interface (CLI Client)..."
     cd src/Interface
-    g++ -std=c++17 -O3 -Wall -pthread -o ../../build/interface main.cpp
+    g++ -std=c++20 -O3 -Wall -pthread -o ../../build/interface main.cpp
     cd ../..
     
     # Build Website
     echo "🔧 Building website (Web Server)..."
     cd src/website
-    g++ -std=c++17 -O3 -Wall -pthread -o ../../build/website main.cpp
+    g++ -std=c++20 -O3 -Wall -pthread -o ../../build/website main.cpp
     cd ../..
     
     # Copy HTML file
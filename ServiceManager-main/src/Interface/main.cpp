@@ -7,6 +7,12 @@
  * 
  * Command-line interface for interacting with the Process Management Server.
  * Provides interactive commands to list, start, and stop processes remotely.
+ * On the server's host, --status and --status-line read the server's
+ * shared-memory status page instead of calling the API, and
+ * "wait <service> --state STATE" blocks on the page's futex words until
+ * the service reaches a state. "audit <file>" decodes the server's
+ * binary audit trail, and "boot" renders the blame ranking and critical
+ * chain of the server's most recent dependency boot.
  */
 
 #include "httplib.h"
@@ -16,10 +22,33 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <deque>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <csignal>
+#include <cstdint>
+#include <ctime>
+
+#include "../Server/StatusPageFormat.hpp"
+#include "../Server/AuditFormat.hpp"
 
 // Configuration constants
 constexpr const char* DEFAULT_SERVER_HOST = "localhost";
 constexpr int DEFAULT_SERVER_PORT = 6755;
+constexpr const char* DEFAULT_STATUS_PAGE_PREFIX = "/dev/shm/servicemn-";
+constexpr int STATUS_READ_ATTEMPTS = 1000;
+constexpr int64_t STATUS_WAIT_RECHECK_MS = 1000;
+constexpr int64_t STATUS_STALE_MS = 2000;  // 20 missed refreshes of the server
+constexpr size_t AUDIT_READ_CHUNK = 1 << 20;
 
 /**
  * @brief Structure to hold process information from server
@@ -214,6 +243,552 @@ bool sendControlCommand(httplib::Client& client, const std::string& function, in
     }
 }
 
+/**
+ * @brief Read-only mapping of the server's status page
+ */
+struct StatusPageMap {
+    void*                             Map = nullptr;
+    size_t                            Size = 0;
+    ino_t                             Inode = 0;  ///< Identifies the file mapped
+    const StatusPageHeader*           Header = nullptr;
+    const StatusSlot*                 Slots = nullptr;
+    const std::atomic<uint32_t>*      Futexes = nullptr;  ///< One futex word per slot
+};
+
+/**
+ * @brief Map the status page read-only
+ * @param path Status page file
+ * @param page Receives the mapping
+ * @return false if the page is missing or not a compatible page
+ */
+bool mapStatusPage(const std::string& path, StatusPageMap& page) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "❌ Cannot open status page " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(StatusPageHeader)) {
+        std::cerr << "❌ Status page " << path << " is truncated" << std::endl;
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "❌ Cannot map status page " << path << std::endl;
+        return false;
+    }
+    
+    const auto* header = static_cast<const StatusPageHeader*>(map);
+    size_t slotCount = header->SlotCount;
+    if (header->Magic != STATUS_PAGE_MAGIC || header->Version != STATUS_PAGE_VERSION ||
+        header->SlotSize != sizeof(StatusSlot) ||
+        size < sizeof(StatusPageHeader) + slotCount * (sizeof(StatusSlot) + sizeof(std::atomic<uint32_t>))) {
+        std::cerr << "❌ " << path << " is not a compatible status page" << std::endl;
+        munmap(map, size);
+        return false;
+    }
+    
+    page.Map = map;
+    page.Size = size;
+    page.Inode = info.st_ino;
+    page.Header = header;
+    page.Slots = reinterpret_cast<const StatusSlot*>(static_cast<const char*>(map) + sizeof(StatusPageHeader));
+    page.Futexes = reinterpret_cast<const std::atomic<uint32_t>*>(page.Slots + slotCount);
+    return true;
+}
+
+/**
+ * @brief Unmap a status page mapped by mapStatusPage()
+ */
+void unmapStatusPage(StatusPageMap& page) {
+    if (page.Map) {
+        munmap(page.Map, page.Size);
+        page = StatusPageMap();
+    }
+}
+
+/**
+ * @brief Copy the slots of a mapped page consistently (seqlock read)
+ * @return false if the server kept writing during every attempt
+ */
+bool copyStatusSlots(const StatusPageMap& page, std::vector<StatusSlot>& slots) {
+    // Retry while the server is writing or wrote during the copy
+    for (int attempt = 0; attempt < STATUS_READ_ATTEMPTS; ++attempt) {
+        uint64_t before = page.Header->Sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        slots.assign(page.Slots, page.Slots + page.Header->SlotCount);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page.Header->Sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    std::cerr << "❌ Status page kept changing while being read" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Read a consistent copy of the server's status page
+ * @param path Status page file
+ * @param slots Receives one slot per service
+ * @param heartbeatMs Receives the time of the server's latest refresh
+ * @return false if the page is missing, invalid or kept changing
+ */
+bool readStatusPage(const std::string& path, std::vector<StatusSlot>& slots, int64_t& heartbeatMs) {
+    StatusPageMap page;
+    if (!mapStatusPage(path, page)) {
+        return false;
+    }
+    bool consistent = copyStatusSlots(page, slots);
+    heartbeatMs = page.Header->HeartbeatMs.load(std::memory_order_acquire);
+    unmapStatusPage(page);
+    return consistent;
+}
+
+/**
+ * @brief Parse a state name for "wait"
+ * @param name "DEAD", "RUNNING" or "READY" (case-insensitive)
+ * @param state Receives the state
+ * @return false if the name is unknown
+ */
+bool parseWaitState(std::string name, uint32_t& state) {
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    if (name == "DEAD") {
+        state = STATUS_DEAD;
+    } else if (name == "RUNNING") {
+        state = STATUS_RUNNING;
+    } else if (name == "READY") {
+        state = STATUS_READY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Check that the server publishing a page is still alive
+ * @param page Mapped status page
+ * @return false, after printing why, if its process is gone or its heartbeat is stale
+ */
+bool statusPageAlive(const StatusPageMap& page) {
+    pid_t server = page.Header->ServerPid;
+    if (server > 0 && kill(server, 0) != 0 && errno == ESRCH) {
+        std::cerr << "❌ Server (PID " << server << ") is no longer running" << std::endl;
+        return false;
+    }
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    int64_t age = now - page.Header->HeartbeatMs.load(std::memory_order_acquire);
+    if (age > STATUS_STALE_MS) {
+        std::cerr << "❌ Server has not refreshed the status page for " << age / 1000 << "s" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Block until a service reaches a state, sleeping on its futex word
+ * @param path Status page file
+ * @param service Service description or index
+ * @param state Awaited state (RUNNING is also satisfied by READY, DEAD by
+ *              an instance exiting even if it was replaced at once)
+ * @param timeoutMs Give up after this long (negative = never)
+ * @return 0 once reached, 1 on errors (including a dead server), 2 on timeout
+ *
+ * Each wait is bounded by STATUS_WAIT_RECHECK_MS so that a page replaced by
+ * a restarted server is noticed and remapped, and a page left behind by a
+ * server that died is reported instead of waited on forever; wakeups
+ * themselves come from the server's FUTEX_WAKE, not from polling.
+ */
+int waitForState(const std::string& path, const std::string& service, uint32_t state, int64_t timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    StatusPageMap page;
+    std::vector<StatusSlot> slots;
+    size_t index = SIZE_MAX;
+    int64_t exitedMs = -1;  // ExitedMs when the wait began (DEAD only)
+    
+    for (;;) {
+        if (!page.Map) {
+            if (!mapStatusPage(path, page)) {
+                return 1;
+            }
+            if (!copyStatusSlots(page, slots)) {
+                unmapStatusPage(page);
+                return 1;
+            }
+            index = SIZE_MAX;
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (std::string(slots[i].Desc, strnlen(slots[i].Desc, sizeof(slots[i].Desc))) == service ||
+                    std::to_string(i) == service) {
+                    index = i;
+                    break;
+                }
+            }
+            if (index == SIZE_MAX) {
+                std::cerr << "❌ Unknown service: " << service << std::endl;
+                unmapStatusPage(page);
+                return 1;
+            }
+        }
+        
+        // Load the word before checking, so a change in between fails FUTEX_WAIT at once
+        uint32_t word = page.Futexes[index].load(std::memory_order_acquire);
+        if (!statusPageAlive(page) || !copyStatusSlots(page, slots)) {
+            unmapStatusPage(page);
+            return 1;
+        }
+        uint32_t current = slots[index].State;
+        if (exitedMs < 0) {
+            exitedMs = slots[index].ExitedMs;
+        }
+        if (current == state || (state == STATUS_RUNNING && current == STATUS_READY) ||
+            (state == STATUS_DEAD && slots[index].ExitedMs > exitedMs)) {
+            unmapStatusPage(page);
+            return 0;
+        }
+        
+        int64_t waitMs = STATUS_WAIT_RECHECK_MS;
+        if (timeoutMs >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) {
+                unmapStatusPage(page);
+                return 2;
+            }
+            waitMs = std::min<int64_t>(waitMs, left);
+        }
+        struct timespec timeout = {static_cast<time_t>(waitMs / 1000), static_cast<long>(waitMs % 1000) * 1000000};
+        syscall(SYS_futex, const_cast<std::atomic<uint32_t>*>(&page.Futexes[index]), FUTEX_WAIT,
+                word, &timeout, nullptr, 0);
+        
+        // A restarted server publishes a new file; follow it
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0 || info.st_ino != page.Inode) {
+            unmapStatusPage(page);
+            if (stat(path.c_str(), &info) != 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(STATUS_WAIT_RECHECK_MS));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Format a duration as a short age ("42s", "7m", "3h", "2d")
+ */
+std::string formatAge(int64_t ms) {
+    int64_t seconds = std::max<int64_t>(ms, 0) / 1000;
+    if (seconds < 60) return std::to_string(seconds) + "s";
+    if (seconds < 3600) return std::to_string(seconds / 60) + "m";
+    if (seconds < 86400) return std::to_string(seconds / 3600) + "h";
+    return std::to_string(seconds / 86400) + "d";
+}
+
+/**
+ * @brief Display the status page as a table
+ * @param slots Slots read from the page
+ * @param heartbeatMs Time of the server's latest refresh
+ */
+void displayStatusPage(const std::vector<StatusSlot>& slots, int64_t heartbeatMs) {
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    std::cout << std::left << std::setw(4) << "ID" << std::setw(24) << "Description"
+              << std::setw(9) << "Status" << std::setw(9) << "PID"
+              << std::setw(10) << "Restarts" << "Since" << std::endl;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const StatusSlot& slot = slots[i];
+        bool running = slot.State != STATUS_DEAD;
+        const char* status = !running ? "DEAD" : slot.Adopted ? "ADOPTED" :
+                             slot.State == STATUS_READY ? "READY" : "RUNNING";
+        std::string desc(slot.Desc, strnlen(slot.Desc, sizeof(slot.Desc)));
+        int64_t since = running ? slot.StartedMs : slot.ExitedMs;
+        std::cout << std::left << std::setw(4) << i << std::setw(24) << desc
+                  << std::setw(9) << status
+                  << std::setw(9) << (running ? std::to_string(slot.Pid) : "-")
+                  << std::setw(10) << slot.Restarts
+                  << (since > 0 ? formatAge(now - since) : "-") << std::endl;
+    }
+    if (now - heartbeatMs > STATUS_STALE_MS) {
+        std::cerr << "⚠️  Server has not refreshed the page for " << formatAge(now - heartbeatMs) << std::endl;
+    }
+}
+
+/**
+ * @brief Display the status page on one line for shell prompts and status bars
+ * @param slots Slots read from the page
+ */
+void displayStatusLine(const std::vector<StatusSlot>& slots) {
+    size_t running = 0;
+    std::string down;
+    for (const auto& slot : slots) {
+        if (slot.State != STATUS_DEAD) {
+            ++running;
+        } else {
+            down += " " + std::string(slot.Desc, strnlen(slot.Desc, sizeof(slot.Desc)));
+        }
+    }
+    std::cout << running << "/" << slots.size() << " up";
+    if (!down.empty()) {
+        std::cout << ", down:" << down;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Format a wall-clock time in microseconds as local "YYYY-MM-DD HH:MM:SS.mmm"
+ */
+std::string formatTimestamp(int64_t us) {
+    time_t seconds = static_cast<time_t>(us / 1000000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+    char text[32];
+    size_t length = strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+    snprintf(text + length, sizeof(text) - length, ".%03d", static_cast<int>((us / 1000) % 1000));
+    return text;
+}
+
+/**
+ * @brief Decode and print an audit file written by the server
+ * @param path Audit file (see AuditFormat.hpp)
+ * @param service Only records targeting this command index (-1 = all)
+ * @param limit Print only the newest N matching records (0 = all)
+ * @return 0 on success, 1 if the file cannot be read
+ */
+int decodeAuditFile(const std::string& path, int service, size_t limit) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "❌ Cannot open audit file " << path << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+    
+    std::string buffer;
+    size_t position = 0;
+    uint64_t offset = 0;  // File offset of buffer[position]
+    // Make at least need bytes available at position; false at end of file
+    auto fill = [&](size_t need) {
+        if (buffer.size() - position >= need) {
+            return true;
+        }
+        buffer.erase(0, position);
+        position = 0;
+        size_t old = buffer.size();
+        buffer.resize(old + std::max(need, AUDIT_READ_CHUNK));
+        file.read(&buffer[old], static_cast<std::streamsize>(buffer.size() - old));
+        buffer.resize(old + static_cast<size_t>(file.gcount()));
+        return buffer.size() >= need;
+    };
+    
+    std::deque<std::string> lines;
+    uint64_t records = 0;
+    uint64_t blocks = 0;
+    uint64_t dropped = 0;
+    size_t need = sizeof(uint32_t);
+    AuditItem item;
+    while (fill(need)) {
+        size_t used = auditDecode(buffer.data() + position, buffer.size() - position, item, need);
+        if (used == 0) {
+            if (need == 0) {
+                break;  // Not a record or index block
+            }
+            continue;   // Read the rest of the item
+        }
+        position += used;
+        offset += used;
+        need = sizeof(uint32_t);
+        if (item.Magic == AUDIT_INDEX_MAGIC) {
+            ++blocks;
+            dropped += item.Block.Dropped;
+            continue;
+        }
+        ++records;
+        const AuditRecordHeader& header = item.Record;
+        if (service >= 0 && header.Service != service) {
+            continue;
+        }
+        
+        std::ostringstream line;
+        line << std::left << formatTimestamp(header.TimestampUs) << "  "
+             << std::setw(22) << item.Client
+             << std::setw(12) << auditOperationName(header.Operation)
+             << std::setw(10) << item.Action
+             << std::setw(14) << (item.Target.empty() ? "-" : item.Target)
+             << std::setw(5) << header.Status
+             << std::right << std::setw(9) << std::fixed << std::setprecision(2)
+             << header.LatencyUs / 1000.0 << "ms  " << item.Result;
+        lines.push_back(line.str());
+        if (limit > 0 && lines.size() > limit) {
+            lines.pop_front();
+        }
+    }
+    bool torn = position < buffer.size();
+    
+    std::cout << std::left << std::setw(25) << "Time" << std::setw(22) << "Client"
+              << std::setw(12) << "Operation" << std::setw(10) << "Action"
+              << std::setw(14) << "Target" << std::setw(5) << "HTTP"
+              << std::right << std::setw(11) << "Latency" << "  Result" << std::endl;
+    for (const auto& line : lines) {
+        std::cout << line << std::endl;
+    }
+    std::cout << "📊 " << records << " records, " << blocks << " index blocks, "
+              << dropped << " dropped" << std::endl;
+    if (torn) {
+        std::cerr << "⚠️  Incomplete data at offset " << offset
+                  << " (the server truncates it when it reopens the file)" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Timeline of one service in a boot analysis
+ */
+struct BootEntry {
+    std::string desc;
+    std::string state;
+    std::string execError;
+    double spawnMs = -1;
+    double execMs = -1;
+    double doneMs = -1;
+    double activationMs = -1;
+};
+
+/**
+ * @brief Extract a field of the flat JSON object starting at a position
+ * @return Unquoted value, or "" if the field is missing
+ */
+std::string extractJsonField(const std::string& json, size_t pos, const std::string& fieldName) {
+    size_t end = json.find('}', pos);
+    size_t fieldPos = json.find("\"" + fieldName + "\"", pos);
+    if (fieldPos == std::string::npos || fieldPos > end) return "";
+    size_t valueStart = json.find_first_not_of(" \t\n\r", json.find(':', fieldPos) + 1);
+    if (valueStart == std::string::npos) return "";
+    if (json[valueStart] == '"') {
+        size_t valueEnd = json.find('"', valueStart + 1);
+        return valueEnd == std::string::npos ? "" : json.substr(valueStart + 1, valueEnd - valueStart - 1);
+    }
+    size_t valueEnd = json.find_first_of(",}\n\r", valueStart);
+    return valueEnd == std::string::npos ? "" : json.substr(valueStart, valueEnd - valueStart);
+}
+
+/**
+ * @brief Parse the service objects of a boot analysis array
+ * @param json Response of GET /analysis/boot
+ * @param begin Position of the array
+ * @param end Position after the array
+ */
+std::vector<BootEntry> parseBootEntries(const std::string& json, size_t begin, size_t end) {
+    std::vector<BootEntry> entries;
+    auto number = [](const std::string& text) {
+        try {
+            return text.empty() ? -1.0 : std::stod(text);
+        } catch (const std::exception&) {
+            return -1.0;
+        }
+    };
+    for (size_t pos = json.find('{', begin); pos < end; pos = json.find('{', pos + 1)) {
+        BootEntry entry;
+        entry.desc = extractJsonField(json, pos, "desc");
+        entry.state = extractJsonField(json, pos, "state");
+        entry.execError = extractJsonField(json, pos, "execError");
+        entry.spawnMs = number(extractJsonField(json, pos, "spawnMs"));
+        entry.execMs = number(extractJsonField(json, pos, "execMs"));
+        entry.doneMs = number(extractJsonField(json, pos, "doneMs"));
+        entry.activationMs = number(extractJsonField(json, pos, "activationMs"));
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+/**
+ * @brief Format milliseconds as seconds ("1.234s", "-" if not reached)
+ */
+std::string formatSeconds(double ms) {
+    if (ms < 0) {
+        return "-";
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.3fs", ms / 1000.0);
+    return text;
+}
+
+/**
+ * @brief Fetch and render the blame ranking and critical chain of a boot
+ * @param client HTTP client instance
+ * @param operation Operation ID of the boot (0 = the most recent one)
+ * @return 0 on success, 1 on errors
+ */
+int showBootAnalysis(httplib::Client& client, uint64_t operation) {
+    std::string path = "/analysis/boot";
+    if (operation != 0) {
+        path += "?operation=" + std::to_string(operation);
+    }
+    auto response = client.Get(path);
+    if (!response) {
+        std::cerr << "❌ Failed to connect to server" << std::endl;
+        return 1;
+    }
+    if (response->status != 200) {
+        std::cerr << "❌ Server returned error: " << response->status << std::endl;
+        if (!response->body.empty()) {
+            std::cerr << "   " << response->body << std::endl;
+        }
+        return 1;
+    }
+    
+    const std::string& json = response->body;
+    size_t blame = json.find("\"blame\"");
+    size_t chain = json.find("\"criticalChain\"");
+    if (blame == std::string::npos || chain == std::string::npos) {
+        std::cerr << "❌ Unexpected response from server" << std::endl;
+        return 1;
+    }
+    std::string totalText = extractJsonField(json, 0, "totalMs");
+    double totalMs = totalText.empty() ? -1 : std::stod(totalText);
+    
+    std::cout << "🥾 Boot operation " << extractJsonField(json, 0, "operation") << " ("
+              << extractJsonField(json, 0, "state") << "), "
+              << (totalMs < 0 ? "still running" : "took " + formatSeconds(totalMs)) << std::endl;
+    
+    std::cout << std::endl << "Blame (start requested until ready):" << std::endl;
+    for (const BootEntry& entry : parseBootEntries(json, blame, chain)) {
+        std::cout << std::right << std::setw(12) << formatSeconds(entry.activationMs) << "  "
+                  << std::left << std::setw(24) << entry.desc;
+        if (entry.state != "ready") {
+            std::cout << " [" << entry.state << "]";
+        }
+        if (entry.execMs >= 0 && entry.spawnMs >= 0) {
+            std::cout << " exec +" << std::fixed << std::setprecision(1)
+                      << entry.execMs - entry.spawnMs << "ms";
+            std::cout.unsetf(std::ios::floatfield);
+        }
+        if (!entry.execError.empty()) {
+            std::cout << " exec failed: " << entry.execError;
+        }
+        std::cout << std::endl;
+    }
+    
+    std::cout << std::endl << "Critical chain (@ finished, + activation):" << std::endl;
+    size_t depth = 0;
+    for (const BootEntry& entry : parseBootEntries(json, chain, json.size())) {
+        // The last service to finish first, then what each one waited for
+        if (depth > 0) {
+            std::cout << std::string(3 * (depth - 1), ' ') << "└─ ";
+        }
+        std::cout << entry.desc << " @" << formatSeconds(entry.doneMs)
+                  << " +" << formatSeconds(entry.activationMs);
+        if (entry.state != "ready") {
+            std::cout << " [" << entry.state << "]";
+        }
+        std::cout << std::endl;
+        ++depth;
+    }
+    return 0;
+}
+
 /**
  * @brief Print usage information
  */
@@ -236,18 +811,120 @@ void printUsage() {
 int main(int argc, char* argv[]) {
     std::string serverHost = DEFAULT_SERVER_HOST;
     int serverPort = DEFAULT_SERVER_PORT;
+    std::string statusPagePath;  // Empty = DEFAULT_STATUS_PAGE_PREFIX + port
+    bool statusOnly = false;
+    bool statusLine = false;
+    bool waitMode = false;
+    std::string waitService;
+    uint32_t waitState = STATUS_READY;
+    int64_t waitTimeoutMs = -1;  // Negative = wait forever
+    std::string auditPath;
+    int auditService = -1;
+    size_t auditLimit = 0;
+    bool bootMode = false;
+    uint64_t bootOperation = 0;  // 0 = the most recent boot
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg == "--help" || arg == "-h") {
             std::cout << "Usage: " << argv[0] << " [OPTIONS]" << std::endl;
+            std::cout << "       " << argv[0] << " [OPTIONS] wait <service> [--state STATE] [--timeout SECONDS]" << std::endl;
+            std::cout << "       " << argv[0] << " audit <file> [--id ID] [--limit N]" << std::endl;
+            std::cout << "       " << argv[0] << " [OPTIONS] boot [--operation ID]" << std::endl;
             std::cout << std::endl;
             std::cout << "Options:" << std::endl;
             std::cout << "  -h, --help           Show this help message" << std::endl;
             std::cout << "  --host HOST          Server hostname (default: " << DEFAULT_SERVER_HOST << ")" << std::endl;
             std::cout << "  --port PORT          Server port (default: " << DEFAULT_SERVER_PORT << ")" << std::endl;
+            std::cout << "  --status             Print statuses from the local status page and exit" << std::endl;
+            std::cout << "  --status-line        Print a one-line summary from the status page and exit" << std::endl;
+            std::cout << "  --status-page PATH   Status page file (default: " << DEFAULT_STATUS_PAGE_PREFIX << "<port>)" << std::endl;
+            std::cout << std::endl;
+            std::cout << "wait blocks until the service (description or index) reaches STATE" << std::endl;
+            std::cout << "(DEAD, RUNNING or READY; default READY) on the status page and exits" << std::endl;
+            std::cout << "with 0, or with 2 when the timeout expires (1 on errors)." << std::endl;
+            std::cout << "audit decodes the server's audit file (--audit-log), optionally only" << std::endl;
+            std::cout << "operations on process ID and only the newest N records." << std::endl;
+            std::cout << "boot shows which services slowed down the most recent dependency boot" << std::endl;
+            std::cout << "(POST /process/orchestrate?op=boot), or of boot operation ID." << std::endl;
             return 0;
+        } else if (arg == "wait" && !waitMode) {
+            if (i + 1 < argc) {
+                waitMode = true;
+                waitService = argv[++i];
+            } else {
+                std::cerr << "Error: wait requires a service" << std::endl;
+                return 1;
+            }
+        } else if (arg == "boot" && !waitMode && auditPath.empty()) {
+            bootMode = true;
+        } else if (arg == "--operation" && bootMode) {
+            try {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("Missing operation");
+                }
+                bootOperation = std::stoull(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: --operation requires an operation ID" << std::endl;
+                return 1;
+            }
+        } else if (arg == "audit" && auditPath.empty() && !waitMode) {
+            if (i + 1 < argc) {
+                auditPath = argv[++i];
+            } else {
+                std::cerr << "Error: audit requires a file" << std::endl;
+                return 1;
+            }
+        } else if ((arg == "--id" || arg == "--limit") && !auditPath.empty()) {
+            try {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("Missing value");
+                }
+                int value = std::stoi(argv[++i]);
+                if (value < 0) {
+                    throw std::out_of_range("Negative value");
+                }
+                if (arg == "--id") {
+                    auditService = value;
+                } else {
+                    auditLimit = static_cast<size_t>(value);
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Error: " << arg << " requires a non-negative number" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--state" && waitMode) {
+            if (i + 1 >= argc || !parseWaitState(argv[++i], waitState)) {
+                std::cerr << "Error: --state requires DEAD, RUNNING or READY" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--timeout" && waitMode) {
+            try {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("Missing timeout");
+                }
+                double seconds = std::stod(argv[++i]);
+                if (seconds < 0) {
+                    throw std::out_of_range("Negative timeout");
+                }
+                waitTimeoutMs = static_cast<int64_t>(seconds * 1000);
+            } catch (const std::exception&) {
+                std::cerr << "Error: --timeout requires a number of seconds" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--status") {
+            statusOnly = true;
+        } else if (arg == "--status-line") {
+            statusOnly = true;
+            statusLine = true;
+        } else if (arg == "--status-page") {
+            if (i + 1 < argc) {
+                statusPagePath = argv[++i];
+            } else {
+                std::cerr << "Error: --status-page requires a path" << std::endl;
+                return 1;
+            }
         } else if (arg == "--host") {
             if (i + 1 < argc) {
                 serverHost = argv[++i];
@@ -276,6 +953,37 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Local status reads need neither the API nor the interactive shell
+    if (statusPagePath.empty()) {
+        statusPagePath = DEFAULT_STATUS_PAGE_PREFIX + std::to_string(serverPort);
+    }
+    if (!auditPath.empty()) {
+        return decodeAuditFile(auditPath, auditService, auditLimit);
+    }
+    if (waitMode) {
+        return waitForState(statusPagePath, waitService, waitState, waitTimeoutMs);
+    }
+    if (statusOnly) {
+        std::vector<StatusSlot> slots;
+        int64_t heartbeatMs = 0;
+        if (!readStatusPage(statusPagePath, slots, heartbeatMs)) {
+            return 1;
+        }
+        if (statusLine) {
+            displayStatusLine(slots);
+        } else {
+            displayStatusPage(slots, heartbeatMs);
+        }
+        return 0;
+    }
+    
+    if (bootMode) {
+        httplib::Client client(serverHost, serverPort);
+        client.set_connection_timeout(5, 0);
+        client.set_read_timeout(10, 0);
+        return showBootAnalysis(client, bootOperation);
+    }
+    
     std::cout << "🚀 Process Management Client v1.0" << std::endl;
     std::cout << "=================================" << std::endl;
     std::cout << "🌐 Connecting to: " << serverHost << ":" << serverPort << std::endl;
@@ -0,0 +1,217 @@
+/**
+ * @file AsyncOps.cpp
+ * @brief Implementation of the awaitable process, probe and Docker operations
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "AsyncOps.hpp"
+
+#include <arpa/inet.h>      // htons, htonl
+#include <fcntl.h>          // O_NONBLOCK
+#include <netinet/in.h>     // sockaddr_in
+#include <poll.h>           // poll
+#include <unistd.h>         // close, read, write, syscall
+#include <sys/socket.h>     // socket, connect, getsockopt
+#include <sys/syscall.h>    // SYS_pidfd_open, SYS_pidfd_send_signal
+#include <sys/un.h>         // sockaddr_un
+#include <cerrno>           // errno
+#include <algorithm>        // std::min
+#include <cstdlib>          // atoi
+#include <cstring>          // strncpy
+#include <fstream>          // std::ifstream
+
+namespace {
+
+constexpr const char* DOCKER_SOCKET = "/var/run/docker.sock";
+constexpr std::chrono::milliseconds PROBE_RETRY{200};
+
+using Clock = std::chrono::steady_clock;
+
+std::chrono::milliseconds remaining(Clock::time_point deadline) {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+    return left.count() > 0 ? left : std::chrono::milliseconds(0);
+}
+
+/**
+ * @brief Finish a non-blocking connect()
+ * @return true if the socket is connected
+ */
+Task<bool> connectSocket(EventLoop& loop, int fd, const sockaddr* address, socklen_t length,
+                         std::chrono::milliseconds timeout) {
+    if (connect(fd, address, length) == 0) {
+        co_return true;
+    }
+    if (errno != EINPROGRESS) {
+        co_return false;
+    }
+    if (!co_await waitFd(loop, fd, EVENT_WRITABLE, timeout)) {
+        co_return false;
+    }
+    int error = 0;
+    socklen_t errorLength = sizeof(error);
+    co_return getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 && error == 0;
+}
+
+/**
+ * @brief Connect, send a request and read until the peer closes
+ * @return Everything the peer sent, or nullopt on connection failure or timeout
+ */
+Task<std::optional<std::string>> exchange(EventLoop& loop, sockaddr_storage address, socklen_t length,
+                                          std::string request, std::chrono::milliseconds timeout) {
+    auto deadline = Clock::now() + timeout;
+    int fd = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        co_return std::nullopt;
+    }
+    if (!co_await connectSocket(loop, fd, reinterpret_cast<const sockaddr*>(&address), length,
+                                remaining(deadline))) {
+        close(fd);
+        co_return std::nullopt;
+    }
+
+    size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t n = write(fd, request.data() + sent, request.size() - sent);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EAGAIN) {
+            if (!co_await waitFd(loop, fd, EVENT_WRITABLE, remaining(deadline))) {
+                close(fd);
+                co_return std::nullopt;
+            }
+        } else {
+            close(fd);
+            co_return std::nullopt;
+        }
+    }
+
+    std::string response;
+    char buffer[4096];
+    for (;;) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            response.append(buffer, static_cast<size_t>(n));
+        } else if (n == 0) {
+            break;
+        } else if (errno == EAGAIN) {
+            if (!co_await waitFd(loop, fd, EVENT_READABLE, remaining(deadline))) {
+                close(fd);
+                co_return std::nullopt;
+            }
+        } else {
+            close(fd);
+            co_return std::nullopt;
+        }
+    }
+    close(fd);
+    co_return response;
+}
+
+/**
+ * @brief Split an HTTP/1.x response into status and body
+ */
+HttpReply parseHttp(const std::string& response) {
+    // "HTTP/1.x NNN reason\r\n...headers...\r\n\r\nbody"
+    HttpReply reply;
+    size_t space = response.find(' ');
+    size_t bodyStart = response.find("\r\n\r\n");
+    if (response.compare(0, 5, "HTTP/") == 0 && space != std::string::npos &&
+        bodyStart != std::string::npos) {
+        reply.Status = atoi(response.c_str() + space + 1);
+        reply.Body = response.substr(bodyStart + 4);
+    }
+    return reply;
+}
+
+} // namespace
+
+int openPidfd(pid_t pid) {
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+}
+
+bool signalPidfd(int pidfd, int signal) {
+    return syscall(SYS_pidfd_send_signal, pidfd, signal, nullptr, 0) == 0;
+}
+
+pid_t pidfdPid(int pidfd) {
+    // The kernel reports the pid in the descriptor's fdinfo ("Pid:\t1234")
+    std::ifstream info("/proc/self/fdinfo/" + std::to_string(pidfd));
+    std::string line;
+    while (std::getline(info, line)) {
+        if (line.compare(0, 4, "Pid:") == 0) {
+            return static_cast<pid_t>(atoi(line.c_str() + 4));
+        }
+    }
+    return -1;
+}
+
+bool pidfdExited(int pidfd) {
+    struct pollfd pfd = {pidfd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+Task<bool> childExit(EventLoop& loop, int pidfd, std::chrono::milliseconds timeout) {
+    co_return co_await waitFd(loop, pidfd, EVENT_READABLE, timeout);
+}
+
+Task<bool> tcpReady(EventLoop& loop, uint16_t port, std::chrono::milliseconds timeout) {
+    auto deadline = Clock::now() + timeout;
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    while (Clock::now() < deadline) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            co_return false;
+        }
+        bool connected = co_await connectSocket(loop, fd, reinterpret_cast<const sockaddr*>(&address),
+                                                sizeof(address), remaining(deadline));
+        close(fd);
+        if (connected) {
+            co_return true;
+        }
+        co_await sleepFor(loop, std::min(PROBE_RETRY, remaining(deadline)));
+    }
+    co_return false;
+}
+
+Task<HttpReply> dockerRequest(EventLoop& loop, const std::string& method, const std::string& path,
+                              std::chrono::milliseconds timeout) {
+    sockaddr_storage address = {};
+    auto* local = reinterpret_cast<sockaddr_un*>(&address);
+    local->sun_family = AF_UNIX;
+    strncpy(local->sun_path, DOCKER_SOCKET, sizeof(local->sun_path) - 1);
+
+    // HTTP/1.0 so the daemon closes the connection after the (unchunked) body
+    std::string request = method + " " + path + " HTTP/1.0\r\nHost: docker\r\nContent-Length: 0\r\n\r\n";
+    auto response = co_await exchange(loop, address, sizeof(sockaddr_un), request, timeout);
+    co_return response ? parseHttp(*response) : HttpReply();
+}
+
+Task<HttpReply> httpGet(EventLoop& loop, uint16_t port, const std::string& path,
+                        std::chrono::milliseconds timeout) {
+    sockaddr_storage address = {};
+    auto* inet = reinterpret_cast<sockaddr_in*>(&address);
+    inet->sin_family = AF_INET;
+    inet->sin_port = htons(port);
+    inet->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+    auto response = co_await exchange(loop, address, sizeof(sockaddr_in), request, timeout);
+    co_return response ? parseHttp(*response) : HttpReply();
+}
+
+Task<std::optional<std::string>> readUnixSocket(EventLoop& loop, const std::string& path,
+                                                std::chrono::milliseconds timeout) {
+    sockaddr_storage address = {};
+    auto* local = reinterpret_cast<sockaddr_un*>(&address);
+    local->sun_family = AF_UNIX;
+    if (path.size() >= sizeof(local->sun_path)) {
+        co_return std::nullopt;
+    }
+    strncpy(local->sun_path, path.c_str(), sizeof(local->sun_path) - 1);
+    co_return co_await exchange(loop, address, sizeof(sockaddr_un), "", timeout);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file AsyncOps.hpp
+ * @brief Awaitable process, probe and Docker operations
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+
+/**
+ * @brief Response of an HTTP request
+ */
+struct HttpReply {
+    int         Status = 0;  ///< HTTP status (0 = the server could not be reached)
+    std::string Body;        ///< Response body
+};
+
+/**
+ * @brief Open a pidfd for a process
+ * @param pid Process ID
+ * @return pidfd, or -1 if the process is gone or pidfds are unsupported
+ */
+int openPidfd(pid_t pid);
+
+/**
+ * @brief Send a signal through a pidfd
+ * @param pidfd pidfd of the target process
+ * @param signal Signal number
+ * @return true if the signal was delivered
+ */
+bool signalPidfd(int pidfd, int signal);
+
+/**
+ * @brief Get the process ID a pidfd refers to
+ * @param pidfd pidfd of the process
+ * @return Process ID, or -1 if it cannot be determined
+ */
+pid_t pidfdPid(int pidfd);
+
+/**
+ * @brief Check without blocking whether a pidfd's process has exited
+ * @param pidfd pidfd of the process
+ */
+bool pidfdExited(int pidfd);
+
+/**
+ * @brief Wait for a process to exit
+ * @param loop Loop the coroutine runs on
+ * @param pidfd pidfd of the process (stays owned by the caller)
+ * @param timeout Maximum wait
+ * @return true if the process exited in time
+ */
+Task<bool> childExit(EventLoop& loop, int pidfd, std::chrono::milliseconds timeout);
+
+/**
+ * @brief Wait until a local TCP port accepts connections
+ * @param loop Loop the coroutine runs on
+ * @param port Port on 127.0.0.1
+ * @param timeout Overall deadline
+ * @return true once a connection succeeded
+ */
+Task<bool> tcpReady(EventLoop& loop, uint16_t port, std::chrono::milliseconds timeout);
+
+/**
+ * @brief Call the Docker Engine API over /var/run/docker.sock
+ * @param loop Loop the coroutine runs on
+ * @param method HTTP method ("GET", "POST", ...)
+ * @param path Request path, e.g. "/containers/web/stop?t=10"
+ * @param timeout Overall deadline
+ * @return Status and body
+ */
+Task<HttpReply> dockerRequest(EventLoop& loop, const std::string& method, const std::string& path,
+                              std::chrono::milliseconds timeout);
+
+/**
+ * @brief GET a path from a local HTTP server
+ * @param loop Loop the coroutine runs on
+ * @param port Port on 127.0.0.1
+ * @param path Request path, e.g. "/metrics"
+ * @param timeout Overall deadline
+ * @return Status and body
+ */
+Task<HttpReply> httpGet(EventLoop& loop, uint16_t port, const std::string& path,
+                        std::chrono::milliseconds timeout);
+
+/**
+ * @brief Read everything a Unix socket server sends after accepting
+ * @param loop Loop the coroutine runs on
+ * @param path Socket path
+ * @param timeout Overall deadline
+ * @return Received data, or nullopt if the socket could not be read in time
+ */
+Task<std::optional<std::string>> readUnixSocket(EventLoop& loop, const std::string& path,
+                                                std::chrono::milliseconds timeout);
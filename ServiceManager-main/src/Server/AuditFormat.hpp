@@ -0,0 +1,180 @@
+/**
+ * @file AuditFormat.hpp
+ * @brief On-disk layout of the audit trail of control operations
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @brief Magic value starting every audit record ("SMAR" little-endian)
+ */
+constexpr uint32_t AUDIT_RECORD_MAGIC = 0x52414d53;
+
+/**
+ * @brief Magic value starting every index block ("SMAI" little-endian)
+ */
+constexpr uint32_t AUDIT_INDEX_MAGIC = 0x49414d53;
+
+/**
+ * @brief Marks the first index block of a file (no previous block)
+ */
+constexpr uint64_t AUDIT_NO_INDEX = UINT64_MAX;
+
+/**
+ * @brief Maximum lengths of a record's text fields (longer text is truncated)
+ */
+constexpr size_t AUDIT_MAX_CLIENT = 63;
+constexpr size_t AUDIT_MAX_ACTION = 31;
+constexpr size_t AUDIT_MAX_TARGET = 63;
+constexpr size_t AUDIT_MAX_RESULT = 255;
+
+/**
+ * @brief API endpoint an audited operation arrived on
+ */
+enum AuditOperation : uint8_t {
+    AUDIT_OTHER = 0,        ///< Any other POST endpoint
+    AUDIT_CONTROL = 1,      ///< POST /process/control
+    AUDIT_ORCHESTRATE = 2,  ///< POST /process/orchestrate
+    AUDIT_ROLLOUT = 3,      ///< POST /process/rollout
+    AUDIT_CHECKPOINT = 4    ///< POST /process/checkpoint
+};
+
+/**
+ * @brief Short name of an AuditOperation ("control", "rollout", ...)
+ */
+inline const char* auditOperationName(uint8_t operation) {
+    switch (operation) {
+        case AUDIT_CONTROL:     return "control";
+        case AUDIT_ORCHESTRATE: return "orchestrate";
+        case AUDIT_ROLLOUT:     return "rollout";
+        case AUDIT_CHECKPOINT:  return "checkpoint";
+        default:                return "other";
+    }
+}
+
+/**
+ * @brief Header preceding each audit record
+ *
+ * The file is a plain sequence of records and index blocks, told apart by
+ * their magic. A record's payload is its client, action, target and result
+ * text, concatenated without terminators; the four lengths add up to
+ * Length. Records are appended in the order operations completed.
+ */
+struct AuditRecordHeader {
+    uint32_t Magic;         ///< AUDIT_RECORD_MAGIC
+    uint16_t Length;        ///< Payload length in bytes
+    uint8_t  Operation;     ///< AuditOperation
+    uint8_t  ClientLength;  ///< Client address ("addr:port")
+    int64_t  TimestampUs;   ///< Wall-clock time the request arrived, microseconds since epoch
+    uint32_t LatencyUs;     ///< Time spent handling the request
+    int32_t  Service;       ///< Command index targeted (-1 if none)
+    uint16_t Status;        ///< HTTP status returned
+    uint8_t  ActionLength;  ///< Action ("start", "restart", "abort", ...)
+    uint8_t  TargetLength;  ///< Target as requested (service ID, group, operation)
+    uint16_t ResultLength;  ///< Response body on one line
+    uint16_t Reserved;      ///< Zero
+};
+
+static_assert(sizeof(AuditRecordHeader) == 32, "AuditRecordHeader must stay 32 bytes");
+
+/**
+ * @brief Index block summarising the records written since the previous one
+ *
+ * Written every AuditLog::INDEX_EVERY records, after a quiet period and on
+ * shutdown. The blocks form a backward chain through PrevIndex, so a query
+ * for recent or time-bounded records starts at the newest block and skips
+ * whole batches by their timestamp range without reading them.
+ */
+struct AuditIndexBlock {
+    uint32_t Magic;        ///< AUDIT_INDEX_MAGIC
+    uint32_t Count;        ///< Records in the batch
+    uint64_t FirstOffset;  ///< File offset of the batch's first record
+    uint64_t PrevIndex;    ///< File offset of the previous block (AUDIT_NO_INDEX if none)
+    int64_t  FirstUs;      ///< Earliest record timestamp in the batch
+    int64_t  LastUs;       ///< Latest record timestamp in the batch
+    uint32_t Dropped;      ///< Records lost to a full queue during the batch
+    uint32_t Reserved;     ///< Zero
+};
+
+static_assert(sizeof(AuditIndexBlock) == 48, "AuditIndexBlock must stay 48 bytes");
+
+/**
+ * @brief Record or index block decoded by auditDecode()
+ *
+ * The text fields point into the decoded buffer and are only valid as long
+ * as it is.
+ */
+struct AuditItem {
+    uint32_t          Magic = 0;  ///< AUDIT_RECORD_MAGIC or AUDIT_INDEX_MAGIC
+    AuditRecordHeader Record{};   ///< Header of a record
+    AuditIndexBlock   Block{};    ///< Contents of an index block
+    std::string_view  Client;     ///< Text fields of a record
+    std::string_view  Action;
+    std::string_view  Target;
+    std::string_view  Result;
+};
+
+/**
+ * @brief Decode the record or index block at the start of a buffer
+ *
+ * Shared by the server (recovery and queries) and the command line decoder,
+ * so every reader agrees on where a file stops being valid.
+ * @param data Bytes starting at an item boundary
+ * @param length Bytes available
+ * @param item Receives the item
+ * @param need Receives the bytes the item occupies, as far as known: larger
+ *             than length if more data is required, 0 if the data is not a
+ *             valid item
+ * @return Bytes consumed, or 0 if no complete, valid item was decoded
+ */
+inline size_t auditDecode(const char* data, size_t length, AuditItem& item, size_t& need) {
+    need = sizeof(uint32_t);
+    if (length < need) {
+        return 0;
+    }
+    memcpy(&item.Magic, data, sizeof(item.Magic));
+    if (item.Magic == AUDIT_INDEX_MAGIC) {
+        need = sizeof(AuditIndexBlock);
+        if (length < need) {
+            return 0;
+        }
+        memcpy(&item.Block, data, sizeof(item.Block));
+        return need;
+    }
+    if (item.Magic != AUDIT_RECORD_MAGIC) {
+        need = 0;
+        return 0;
+    }
+
+    need = sizeof(AuditRecordHeader);
+    if (length < need) {
+        return 0;
+    }
+    const AuditRecordHeader& header = item.Record;
+    memcpy(&item.Record, data, sizeof(item.Record));
+    if (static_cast<size_t>(header.ClientLength) + header.ActionLength + header.TargetLength +
+            header.ResultLength != header.Length) {
+        need = 0;
+        return 0;
+    }
+    need += header.Length;
+    if (length < need) {
+        return 0;
+    }
+    const char* text = data + sizeof(AuditRecordHeader);
+    item.Client = std::string_view(text, header.ClientLength);
+    text += header.ClientLength;
+    item.Action = std::string_view(text, header.ActionLength);
+    text += header.ActionLength;
+    item.Target = std::string_view(text, header.TargetLength);
+    text += header.TargetLength;
+    item.Result = std::string_view(text, header.ResultLength);
+    return need;
+}
@@ -0,0 +1,384 @@
+/**
+ * @file AuditLog.cpp
+ * @brief Implementation of the audit trail of control operations
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "AuditLog.hpp"
+
+#include <unistd.h>     // pread, write, ftruncate, close
+#include <fcntl.h>      // open, O_APPEND
+#include <sys/stat.h>   // fstat
+#include <algorithm>    // std::min, std::max
+#include <cstdio>       // perror
+#include <cerrno>       // errno
+#include <cstring>      // memcpy
+#include <iostream>     // std::cerr
+
+namespace {
+
+constexpr size_t RECOVER_CHUNK = 1 << 20;
+
+int64_t steadyDeltaUs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+/**
+ * @brief Append text truncated to a field's maximum length
+ * @return Stored length
+ */
+size_t appendField(char*& out, const std::string& text, size_t max) {
+    size_t length = std::min(text.size(), max);
+    memcpy(out, text.data(), length);
+    out += length;
+    return length;
+}
+
+} // namespace
+
+AuditLog::AuditLog(const std::string& path) : path_(path) {
+}
+
+AuditLog::~AuditLog() {
+    stop();
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool AuditLog::open() {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0640);
+    if (fd_ < 0) {
+        perror("AuditLog: open failed");
+        return false;
+    }
+    if (!recover()) {
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    slots_ = std::make_unique<Slot[]>(QUEUE_CAPACITY);
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        slots_[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+    running_ = true;
+    thread_ = std::thread(&AuditLog::run, this);
+    return true;
+}
+
+void AuditLog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AuditLog::record(const AuditEntry& entry) {
+    if (!slots_) {
+        return false;
+    }
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+
+    // Claim a slot: it is free when its sequence equals the claimed position
+    uint64_t position = tail_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[position & (QUEUE_CAPACITY - 1)];
+        uint64_t sequence = slot->Sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence - position);
+        if (difference == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);  // Writer is a whole ring behind
+            return false;
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    AuditRecordHeader header{};
+    header.Magic = AUDIT_RECORD_MAGIC;
+    header.Operation = entry.Operation;
+    header.TimestampUs = entry.TimestampUs;
+    header.LatencyUs = entry.LatencyUs;
+    header.Service = entry.Service;
+    header.Status = static_cast<uint16_t>(entry.Status);
+    char* out = slot->Bytes + sizeof(header);
+    header.ClientLength = static_cast<uint8_t>(appendField(out, entry.Client, AUDIT_MAX_CLIENT));
+    header.ActionLength = static_cast<uint8_t>(appendField(out, entry.Action, AUDIT_MAX_ACTION));
+    header.TargetLength = static_cast<uint8_t>(appendField(out, entry.Target, AUDIT_MAX_TARGET));
+    header.ResultLength = static_cast<uint16_t>(appendField(out, entry.Result, AUDIT_MAX_RESULT));
+    header.Length = static_cast<uint16_t>(out - slot->Bytes - sizeof(header));
+    memcpy(slot->Bytes, &header, sizeof(header));
+    slot->Size = static_cast<uint16_t>(out - slot->Bytes);
+
+    // Publish to the writer
+    slot->Sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool AuditLog::recover() {
+    struct stat info;
+    if (fstat(fd_, &info) != 0) {
+        perror("AuditLog: fstat failed");
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(info.st_size);
+
+    // Walk records and index blocks to find the newest block and the open batch
+    std::string window;
+    uint64_t windowStart = 0;
+    auto view = [&](uint64_t offset, size_t need) -> const char* {
+        if (offset < windowStart || offset + need > windowStart + window.size()) {
+            window.resize(std::max(need, RECOVER_CHUNK));
+            ssize_t got = pread(fd_, &window[0], window.size(), static_cast<off_t>(offset));
+            window.resize(got > 0 ? static_cast<size_t>(got) : 0);
+            windowStart = offset;
+            if (window.size() < need) {
+                return nullptr;
+            }
+        }
+        return window.data() + (offset - windowStart);
+    };
+
+    uint64_t offset = 0;
+    size_t need = sizeof(uint32_t);
+    AuditItem item;
+    while (offset < fileSize) {
+        const char* data = view(offset, need);
+        if (!data) {
+            break;
+        }
+        size_t used = auditDecode(data, windowStart + window.size() - offset, item, need);
+        if (used == 0) {
+            if (need == 0) {
+                break;  // Not a record or index block
+            }
+            continue;   // Read the rest of the item
+        }
+        if (item.Magic == AUDIT_RECORD_MAGIC) {
+            int64_t timestampUs = item.Record.TimestampUs;
+            if (batch_.Count++ == 0) {
+                batch_.Offset = offset;
+                batch_.FirstUs = batch_.LastUs = timestampUs;
+            }
+            batch_.FirstUs = std::min(batch_.FirstUs, timestampUs);
+            batch_.LastUs = std::max(batch_.LastUs, timestampUs);
+            ++written_;
+        } else {
+            lastIndex_ = offset;
+            ++indexes_;
+            batch_ = Batch();
+        }
+        offset += used;
+        need = sizeof(uint32_t);
+    }
+
+    if (offset < fileSize) {
+        std::cerr << "⚠️  Audit log " << path_ << ": discarding " << (fileSize - offset)
+                  << " bytes of incomplete data at offset " << offset << std::endl;
+        if (ftruncate(fd_, static_cast<off_t>(offset)) != 0) {
+            perror("AuditLog: ftruncate failed");
+            return false;
+        }
+    }
+    size_ = offset;
+    batch_.Opened = std::chrono::steady_clock::now();
+    return true;
+}
+
+void AuditLog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        wakeup_.wait_for(lock, FLUSH_INTERVAL, [this] { return !running_; });
+        lock.unlock();
+        flush(false);
+        lock.lock();
+    }
+    lock.unlock();
+    flush(true);
+}
+
+void AuditLog::flush(bool closeBatch) {
+    uint64_t base = size_;  // Only this thread changes size_
+    uint64_t lastIndex = lastIndex_;
+    Batch previous = batch_;
+    uint64_t droppedIndexed = droppedIndexed_;
+    uint64_t records = 0;
+    uint64_t indexes = 0;
+    std::string buffer;
+
+    for (;;) {
+        Slot& slot = slots_[head_ & (QUEUE_CAPACITY - 1)];
+        if (slot.Sequence.load(std::memory_order_acquire) != head_ + 1) {
+            break;
+        }
+        AuditRecordHeader header;
+        memcpy(&header, slot.Bytes, sizeof(header));
+        if (batch_.Count++ == 0) {
+            batch_.Offset = base + buffer.size();
+            batch_.FirstUs = batch_.LastUs = header.TimestampUs;
+            batch_.Opened = std::chrono::steady_clock::now();
+        }
+        batch_.FirstUs = std::min(batch_.FirstUs, header.TimestampUs);
+        batch_.LastUs = std::max(batch_.LastUs, header.TimestampUs);
+        buffer.append(slot.Bytes, slot.Size);
+        ++records;
+
+        // Hand the slot back to producers for the next lap of the ring
+        slot.Sequence.store(head_ + QUEUE_CAPACITY, std::memory_order_release);
+        ++head_;
+
+        if (batch_.Count >= INDEX_EVERY) {
+            appendIndex(buffer, base, lastIndex);
+            ++indexes;
+        }
+    }
+    if (batch_.Count > 0 &&
+        (closeBatch || steadyDeltaUs(batch_.Opened) >= std::chrono::microseconds(INDEX_INTERVAL).count())) {
+        appendIndex(buffer, base, lastIndex);
+        ++indexes;
+    }
+    if (buffer.empty()) {
+        return;
+    }
+
+    // One append per flush; on failure keep the file at its last complete record
+    size_t done = 0;
+    while (done < buffer.size()) {
+        ssize_t n = write(fd_, buffer.data() + done, buffer.size() - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            perror("AuditLog: write failed");
+            if (ftruncate(fd_, static_cast<off_t>(base)) != 0) {
+                perror("AuditLog: ftruncate failed");
+            }
+            batch_ = previous;
+            droppedIndexed_ = droppedIndexed;
+            dropped_.fetch_add(records, std::memory_order_relaxed);
+            return;
+        }
+        done += static_cast<size_t>(n);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_ = base + buffer.size();
+    lastIndex_ = lastIndex;
+    written_ += records;
+    indexes_ += indexes;
+}
+
+void AuditLog::appendIndex(std::string& buffer, uint64_t base, uint64_t& lastIndex) {
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    AuditIndexBlock block{};
+    block.Magic = AUDIT_INDEX_MAGIC;
+    block.Count = batch_.Count;
+    block.FirstOffset = batch_.Offset;
+    block.PrevIndex = lastIndex;
+    block.FirstUs = batch_.FirstUs;
+    block.LastUs = batch_.LastUs;
+    block.Dropped = static_cast<uint32_t>(std::min<uint64_t>(dropped - droppedIndexed_, UINT32_MAX));
+    droppedIndexed_ = dropped;
+
+    lastIndex = base + buffer.size();
+    buffer.append(reinterpret_cast<const char*>(&block), sizeof(block));
+    batch_ = Batch();
+}
+
+std::vector<AuditEntry> AuditLog::query(const AuditQuery& filter) const {
+    uint64_t end;
+    uint64_t index;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        end = size_;
+        index = lastIndex_;
+    }
+    std::vector<AuditEntry> out;
+    if (fd_ < 0) {
+        return out;
+    }
+
+    // The open batch has no index block yet; read it whole
+    decodeRange(index == AUDIT_NO_INDEX ? 0 : index + sizeof(AuditIndexBlock), end, filter, out);
+
+    // Then walk the index chain backwards, skipping batches outside the time range
+    while (index != AUDIT_NO_INDEX && out.size() < filter.Limit) {
+        AuditIndexBlock block;
+        if (pread(fd_, &block, sizeof(block), static_cast<off_t>(index)) != sizeof(block) ||
+            block.Magic != AUDIT_INDEX_MAGIC) {
+            break;
+        }
+        if (block.Count > 0 && block.LastUs >= filter.SinceUs && block.FirstUs <= filter.UntilUs) {
+            decodeRange(block.FirstOffset, index, filter, out);
+        }
+        index = block.PrevIndex;
+    }
+    return out;
+}
+
+void AuditLog::decodeRange(uint64_t begin, uint64_t end, const AuditQuery& filter,
+                           std::vector<AuditEntry>& out) const {
+    if (begin >= end || out.size() >= filter.Limit) {
+        return;
+    }
+    std::string data(end - begin, '\0');
+    ssize_t got = pread(fd_, &data[0], data.size(), static_cast<off_t>(begin));
+    if (got <= 0) {
+        return;
+    }
+    data.resize(static_cast<size_t>(got));
+
+    std::vector<AuditEntry> matches;
+    size_t offset = 0;
+    size_t need;
+    AuditItem item;
+    while (size_t used = auditDecode(data.data() + offset, data.size() - offset, item, need)) {
+        offset += used;
+        const AuditRecordHeader& header = item.Record;
+        if (item.Magic != AUDIT_RECORD_MAGIC ||
+            header.TimestampUs < filter.SinceUs || header.TimestampUs > filter.UntilUs ||
+            (filter.Service >= 0 && header.Service != filter.Service) ||
+            (filter.Operation >= 0 && header.Operation != filter.Operation)) {
+            continue;
+        }
+        AuditEntry entry;
+        entry.TimestampUs = header.TimestampUs;
+        entry.LatencyUs = header.LatencyUs;
+        entry.Service = header.Service;
+        entry.Status = header.Status;
+        entry.Operation = header.Operation;
+        entry.Client = item.Client;
+        entry.Action = item.Action;
+        entry.Target = item.Target;
+        entry.Result = item.Result;
+        matches.push_back(std::move(entry));
+    }
+    for (auto it = matches.rbegin(); it != matches.rend() && out.size() < filter.Limit; ++it) {
+        out.push_back(std::move(*it));
+    }
+}
+
+AuditStats AuditLog::stats() const {
+    AuditStats stats;
+    stats.Recorded = recorded_.load(std::memory_order_relaxed);
+    stats.Dropped = dropped_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.Written = written_;
+    stats.Bytes = size_;
+    stats.Indexes = indexes_;
+    return stats;
+}
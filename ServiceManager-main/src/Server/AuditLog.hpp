@@ -0,0 +1,178 @@
+/**
+ * @file AuditLog.hpp
+ * @brief Append-only audit trail of control operations
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AuditFormat.hpp"
+
+/**
+ * @brief One decoded audit record
+ */
+struct AuditEntry {
+    int64_t     TimestampUs = 0;  ///< Wall-clock time the request arrived
+    uint32_t    LatencyUs = 0;    ///< Time spent handling the request
+    int         Service = -1;     ///< Command index targeted (-1 if none)
+    int         Status = 0;       ///< HTTP status returned
+    uint8_t     Operation = AUDIT_OTHER; ///< AuditOperation
+    std::string Client;           ///< Client address ("addr:port")
+    std::string Action;           ///< Requested action
+    std::string Target;           ///< Requested target
+    std::string Result;           ///< Response body on one line (truncated)
+};
+
+/**
+ * @brief Filter of AuditLog::query() (defaults match everything)
+ */
+struct AuditQuery {
+    int64_t SinceUs = 0;          ///< Oldest timestamp returned
+    int64_t UntilUs = INT64_MAX;  ///< Newest timestamp returned
+    int     Service = -1;         ///< Only this command index (-1 = any)
+    int     Operation = -1;       ///< Only this AuditOperation (-1 = any)
+    size_t  Limit = 100;          ///< Maximum records returned
+};
+
+/**
+ * @brief Counters of the audit trail
+ */
+struct AuditStats {
+    uint64_t Recorded = 0;  ///< Records submitted by record()
+    uint64_t Dropped = 0;   ///< Records lost because the queue was full or a write failed
+    uint64_t Written = 0;   ///< Records written to the file
+    uint64_t Bytes = 0;     ///< Current file size
+    uint64_t Indexes = 0;   ///< Index blocks in the file
+};
+
+/**
+ * @brief Records who did what to which service, without slowing them down
+ *
+ * record() is called on the HTTP worker threads. It encodes the record
+ * straight into a slot of a bounded lock-free MPSC ring (one CAS, no
+ * allocation, no syscall, no lock) and returns; if the ring is full the
+ * record is counted as dropped rather than making the caller wait. A
+ * writer thread drains the ring every FLUSH_INTERVAL and appends all
+ * pending records with a single write(), followed by an index block every
+ * INDEX_EVERY records or once a batch has been open for INDEX_INTERVAL
+ * (see AuditFormat.hpp).
+ *
+ * On open, an existing file is scanned and appended to; a record torn by a
+ * crash at the end of the file is truncated away.
+ */
+class AuditLog {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4096;  ///< Ring slots (power of two)
+    static constexpr size_t INDEX_EVERY = 256;      ///< Records per index block
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{100};
+    static constexpr std::chrono::seconds INDEX_INTERVAL{10};
+
+    /**
+     * @brief Constructor
+     * @param path Audit file to append to
+     */
+    explicit AuditLog(const std::string& path);
+
+    /**
+     * @brief Destructor - flushes pending records and stops the writer
+     */
+    ~AuditLog();
+
+    AuditLog(const AuditLog&) = delete;
+    AuditLog& operator=(const AuditLog&) = delete;
+
+    /**
+     * @brief Open (or create) the file and start the writer thread
+     * @return false if the file could not be opened
+     */
+    bool open();
+
+    /**
+     * @brief Flush pending records, close the batch with an index block and stop the writer
+     */
+    void stop();
+
+    /**
+     * @brief Queue a record (lock-free, callable from any thread)
+     * @return false if the record was dropped because the queue was full
+     */
+    bool record(const AuditEntry& entry);
+
+    /**
+     * @brief Read written records, newest first
+     * @param filter Records to return
+     */
+    std::vector<AuditEntry> query(const AuditQuery& filter) const;
+
+    /**
+     * @brief Get the trail's counters
+     */
+    AuditStats stats() const;
+
+    /**
+     * @brief Get the audit file path
+     */
+    const std::string& path() const { return path_; }
+
+private:
+    static constexpr size_t MAX_RECORD = sizeof(AuditRecordHeader) + AUDIT_MAX_CLIENT +
+        AUDIT_MAX_ACTION + AUDIT_MAX_TARGET + AUDIT_MAX_RESULT;
+
+    /**
+     * @brief Ring slot; Sequence tells producers and the writer whose turn it is
+     */
+    struct Slot {
+        std::atomic<uint64_t> Sequence{0};
+        uint16_t              Size = 0;
+        char                  Bytes[MAX_RECORD];
+    };
+
+    std::string             path_;
+    int                     fd_ = -1;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> tail_{0};  ///< Next slot claimed by a producer
+    alignas(64) uint64_t    head_ = 0;           ///< Next slot drained (writer thread only)
+    std::atomic<uint64_t>   recorded_{0};
+    std::atomic<uint64_t>   dropped_{0};
+    uint64_t                droppedIndexed_ = 0; ///< Drops already counted in an index block (writer thread only)
+
+    /**
+     * @brief Records after the newest index block
+     */
+    struct Batch {
+        uint64_t Offset = 0;  ///< File offset of the first record
+        uint32_t Count = 0;
+        int64_t  FirstUs = 0;
+        int64_t  LastUs = 0;
+        std::chrono::steady_clock::time_point Opened;
+    };
+
+    Batch                   batch_;              ///< Open batch (writer thread only)
+
+    mutable std::mutex      mutex_;              ///< Guards the fields below and wakes the writer
+    uint64_t                size_ = 0;           ///< Bytes written (complete records and blocks only)
+    uint64_t                lastIndex_ = AUDIT_NO_INDEX; ///< Offset of the newest index block
+    uint64_t                written_ = 0;
+    uint64_t                indexes_ = 0;
+    std::condition_variable wakeup_;
+    bool                    running_ = false;
+    std::thread             thread_;
+
+    bool recover();
+    void run();
+    void flush(bool closeBatch);
+    void appendIndex(std::string& buffer, uint64_t base, uint64_t& lastIndex);
+    void decodeRange(uint64_t begin, uint64_t end, const AuditQuery& filter,
+                     std::vector<AuditEntry>& out) const;
+};
@@ -0,0 +1,403 @@
+/**
+ * @file Autoscaler.cpp
+ * @brief Implementation of the replica group autoscaler
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "Autoscaler.hpp"
+#include "AsyncOps.hpp"
+#include "EventLog.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+#include "ResourceSampler.hpp"
+
+#include <algorithm>        // std::min, std::max
+#include <cmath>            // std::ceil
+#include <cstdio>           // snprintf
+#include <cstdlib>          // strtod, atoi
+#include <fstream>          // std::ifstream
+#include <map>              // std::map
+#include <sstream>          // std::istringstream, std::stringstream
+
+namespace {
+
+constexpr std::chrono::milliseconds METRIC_TIMEOUT{5000};
+constexpr double DEFAULT_CPU_TARGET = 80.0;
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::chrono::milliseconds secondsOption(const command& cmd, const std::string& key,
+                                        std::chrono::milliseconds fallback) {
+    double seconds = cmd.optionNumber(key, fallback.count() / 1000.0);
+    return std::chrono::milliseconds(static_cast<int64_t>(std::max(seconds, 0.0) * 1000));
+}
+
+/**
+ * @brief Parse a whole string as a number
+ */
+std::optional<double> parseNumber(const std::string& text) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    double value = strtod(begin, &end);
+    if (end == begin) {
+        return std::nullopt;
+    }
+    for (; *end != '\0'; ++end) {
+        if (*end != ' ' && *end != '\t' && *end != '\r' && *end != '\n') {
+            return std::nullopt;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Sum all series of a metric in Prometheus text format
+ * @param body Scraped page ("name{labels} value [timestamp]" lines)
+ * @param name Metric name
+ * @return Sum of the series, or nullopt if the metric is missing
+ */
+std::optional<double> prometheusValue(const std::string& body, const std::string& name) {
+    std::istringstream lines(body);
+    std::string line;
+    std::optional<double> sum;
+    while (std::getline(lines, line)) {
+        if (line.compare(0, name.size(), name) != 0 || line.size() == name.size()) {
+            continue;
+        }
+        size_t pos = name.size();
+        if (line[pos] == '{') {
+            pos = line.find('}', pos);
+            if (pos == std::string::npos) {
+                continue;
+            }
+            ++pos;
+        } else if (line[pos] != ' ' && line[pos] != '\t') {
+            continue;  // Longer metric name with the same prefix
+        }
+        const char* begin = line.c_str() + pos;
+        char* end = nullptr;
+        double value = strtod(begin, &end);
+        if (end != begin) {
+            sum = sum.value_or(0) + value;
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+Autoscaler::Autoscaler(ProcessRunner& runner, Orchestrator& orchestrator, ResourceSampler& sampler,
+                       EventLoop& loop, EventLog& events)
+    : runner_(runner), orchestrator_(orchestrator), sampler_(sampler), loop_(loop), events_(events) {
+    // Members by group; the first member with "@scale.max" configures the group
+    std::map<std::string, std::vector<size_t>> members;
+    std::map<std::string, size_t> config;
+    for (size_t i = 0; i < runner_.getCommandCount(); ++i) {
+        command cmd = runner_.getCommand(i);
+        std::string group = cmd.option("group");
+        if (group.empty()) {
+            if (!cmd.option("scale.max").empty()) {
+                events_.record(static_cast<int>(i), "scale.config",
+                               "scale.max without group is ignored");
+            }
+            continue;
+        }
+        members[group].push_back(i);
+        if (!cmd.option("scale.max").empty() && config.count(group) == 0) {
+            config[group] = i;
+        }
+    }
+
+    for (const auto& entry : config) {
+        command cmd = runner_.getCommand(entry.second);
+        Group group;
+        group.Members = members[entry.first];
+        group.Status.Group = entry.first;
+
+        size_t count = group.Members.size();
+        double max = cmd.optionNumber("scale.max", 0);
+        double min = cmd.optionNumber("scale.min", 1);
+        if (max < 1) {
+            events_.record(static_cast<int>(entry.second), "scale.config",
+                           "Invalid scale.max, group " + entry.first + " is not scaled");
+            continue;
+        }
+        if (max > count) {
+            events_.record(static_cast<int>(entry.second), "scale.config",
+                           "scale.max exceeds the " + std::to_string(count) +
+                           " members of group " + entry.first + ", limiting to them");
+        }
+        group.Status.Max = std::min(static_cast<size_t>(max), count);
+        group.Status.Min = std::min(static_cast<size_t>(std::max(min, 0.0)), group.Status.Max);
+
+        if (!configure(group, cmd.option("scale.metric", "cpu"))) {
+            events_.record(static_cast<int>(entry.second), "scale.config",
+                           "Invalid scale.metric '" + cmd.option("scale.metric") + "', group " +
+                           entry.first + " is not scaled");
+            continue;
+        }
+        group.Status.Target = cmd.optionNumber("scale.target",
+                                               group.Kind == MetricKind::Cpu ? DEFAULT_CPU_TARGET : 1);
+        if (group.Status.Target <= 0) {
+            events_.record(static_cast<int>(entry.second), "scale.config",
+                           "scale.target must be positive, group " + entry.first + " is not scaled");
+            continue;
+        }
+        group.Interval = std::max(secondsOption(cmd, "scale.interval", group.Interval),
+                                  std::chrono::milliseconds(100));
+        group.UpWindow = secondsOption(cmd, "scale.up_window", group.UpWindow);
+        group.DownWindow = secondsOption(cmd, "scale.down_window", group.DownWindow);
+        group.Cooldown = secondsOption(cmd, "scale.cooldown", group.Cooldown);
+        groups_.push_back(std::move(group));
+    }
+}
+
+bool Autoscaler::configure(Group& group, const std::string& metric) {
+    group.Status.Metric = metric;
+    if (metric == "cpu") {
+        group.Kind = MetricKind::Cpu;
+        return true;
+    }
+    size_t colon = metric.find(':');
+    if (colon == std::string::npos || colon + 1 == metric.size()) {
+        return false;
+    }
+    std::string scheme = metric.substr(0, colon);
+    std::string rest = metric.substr(colon + 1);
+    if (scheme == "file" || scheme == "socket") {
+        group.Kind = scheme == "file" ? MetricKind::File : MetricKind::Socket;
+        group.Path = rest;
+        return true;
+    }
+    if (scheme != "http") {
+        return false;
+    }
+
+    // http:PORT[/PATH][#NAME]
+    group.Kind = MetricKind::Http;
+    size_t hash = rest.find('#');
+    if (hash != std::string::npos) {
+        group.Name = rest.substr(hash + 1);
+        rest.erase(hash);
+    }
+    size_t slash = rest.find('/');
+    group.Path = slash == std::string::npos ? "/metrics" : rest.substr(slash);
+    std::string port = rest.substr(0, slash);
+    if (port.empty() || port.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    int number = atoi(port.c_str());
+    if (number <= 0 || number > 65535) {
+        return false;
+    }
+    group.Port = static_cast<uint16_t>(number);
+    return true;
+}
+
+void Autoscaler::start() {
+    loop_.post([this]() {
+        running_ = true;
+        for (size_t i = 0; i < groups_.size(); ++i) {
+            groups_[i].Timer = loop_.addTimer(groups_[i].Interval, [this, i]() {
+                if (!groups_[i].Busy) {
+                    groups_[i].Busy = true;
+                    spawn(evaluate(i));
+                }
+            });
+        }
+    });
+}
+
+void Autoscaler::stop() {
+    loop_.post([this]() {
+        running_ = false;
+        for (auto& group : groups_) {
+            if (group.Timer >= 0) {
+                loop_.cancelTimer(group.Timer);
+                group.Timer = -1;
+            }
+        }
+    });
+}
+
+std::vector<ScaleStatus> Autoscaler::status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ScaleStatus> result;
+    for (const auto& group : groups_) {
+        result.push_back(group.Status);
+    }
+    return result;
+}
+
+Task<void> Autoscaler::evaluate(size_t index) {
+    Group& group = groups_[index];
+    std::string error;
+    std::optional<double> value = co_await readMetric(group, error);
+
+    size_t current = 0;
+    for (size_t member : group.Members) {
+        if (runner_.isRunning(member)) {
+            ++current;
+        }
+    }
+
+    size_t desired = current;
+    if (value) {
+        double wanted = std::ceil(*value / group.Status.Target);
+        size_t recommended = wanted <= 0 ? 0 : static_cast<size_t>(std::min(wanted, 1e6));
+        recommended = std::clamp(recommended, group.Status.Min, group.Status.Max);
+        desired = stabilize(group, recommended, current);
+    }
+
+    bool wasFailing;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wasFailing = !group.Status.Error.empty();
+        group.Status.Current = current;
+        group.Status.Desired = desired;
+        group.Status.Error = error;
+        if (value) {
+            group.Status.Value = *value;
+        }
+    }
+    if (!value && !wasFailing) {
+        events_.record(-1, "scale.metric", "Group " + group.Status.Group + ": " + error);
+    }
+
+    // Leave the group alone while replicas are being replaced or changed
+    bool settled = std::all_of(group.Pending.begin(), group.Pending.end(),
+                               [this](uint64_t id) { return orchestrator_.finished(id); });
+    if (settled) {
+        group.Pending.clear();
+    }
+    bool cooling = std::chrono::steady_clock::now() - group.LastAction < group.Cooldown;
+    if (running_ && value && desired != current && settled && !cooling &&
+        !orchestrator_.rolloutActive(group.Status.Group)) {
+        scale(group, current, desired);
+    }
+    group.Busy = false;
+}
+
+Task<std::optional<double>> Autoscaler::readMetric(Group& group, std::string& error) {
+    switch (group.Kind) {
+    case MetricKind::Cpu: {
+        auto samples = sampler_.latest();
+        double total = 0;
+        for (size_t member : group.Members) {
+            if (member < samples.size() && samples[member].Pid > 0) {
+                total += samples[member].CpuPercent;
+            }
+        }
+        co_return total;
+    }
+    case MetricKind::Http: {
+        HttpReply reply = co_await httpGet(loop_, group.Port, group.Path, METRIC_TIMEOUT);
+        if (reply.Status != 200) {
+            error = reply.Status == 0 ? "Metric endpoint not reachable"
+                                      : "Metric endpoint returned HTTP " + std::to_string(reply.Status);
+            co_return std::nullopt;
+        }
+        auto value = group.Name.empty() ? parseNumber(reply.Body) : prometheusValue(reply.Body, group.Name);
+        if (!value) {
+            error = group.Name.empty() ? "Metric endpoint did not return a number"
+                                       : "Metric " + group.Name + " not found";
+        }
+        co_return value;
+    }
+    case MetricKind::File: {
+        std::ifstream file(group.Path);
+        if (!file) {
+            error = "Cannot read " + group.Path;
+            co_return std::nullopt;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+        auto value = parseNumber(content.str());
+        if (!value) {
+            error = group.Path + " does not contain a number";
+        }
+        co_return value;
+    }
+    case MetricKind::Socket: {
+        auto content = co_await readUnixSocket(loop_, group.Path, METRIC_TIMEOUT);
+        if (!content) {
+            error = "Cannot read socket " + group.Path;
+            co_return std::nullopt;
+        }
+        auto value = parseNumber(*content);
+        if (!value) {
+            error = "Socket " + group.Path + " did not send a number";
+        }
+        co_return value;
+    }
+    }
+    co_return std::nullopt;
+}
+
+size_t Autoscaler::stabilize(Group& group, size_t recommended, size_t current) {
+    auto now = std::chrono::steady_clock::now();
+    group.History.push_back({now, recommended});
+    auto keep = std::max(group.UpWindow, group.DownWindow);
+    while (!group.History.empty() && now - group.History.front().At > keep) {
+        group.History.pop_front();
+    }
+
+    // Up to the lowest recommendation of the up window, down to the highest of the down window
+    size_t up = recommended;
+    size_t down = recommended;
+    for (const auto& entry : group.History) {
+        if (now - entry.At <= group.UpWindow) {
+            up = std::min(up, entry.Replicas);
+        }
+        if (now - entry.At <= group.DownWindow) {
+            down = std::max(down, entry.Replicas);
+        }
+    }
+    if (up > current) {
+        return up;
+    }
+    if (down < current) {
+        return down;
+    }
+    return current;
+}
+
+void Autoscaler::scale(Group& group, size_t current, size_t desired) {
+    bool up = desired > current;
+    size_t changes = up ? desired - current : current - desired;
+
+    // Start the lowest stopped members, stop the highest running ones
+    std::vector<size_t> order = group.Members;
+    if (!up) {
+        std::reverse(order.begin(), order.end());
+    }
+    for (size_t member : order) {
+        if (changes == 0) {
+            break;
+        }
+        if (runner_.isRunning(member) == up) {
+            continue;
+        }
+        group.Pending.push_back(orchestrator_.submit(up ? OperationKind::Start : OperationKind::Stop,
+                                                     static_cast<int>(member)));
+        --changes;
+    }
+    group.LastAction = std::chrono::steady_clock::now();
+
+    char value[32];
+    snprintf(value, sizeof(value), "%.1f", group.Status.Value);
+    char target[32];
+    snprintf(target, sizeof(target), "%.1f", group.Status.Target);
+    events_.record(-1, up ? "scale.up" : "scale.down",
+                   "Group " + group.Status.Group + ": " + std::to_string(current) + " -> " +
+                   std::to_string(desired) + " replicas (" + group.Status.Metric + " = " + value +
+                   ", target " + target + " per replica)");
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    group.Status.LastAction = up ? "up" : "down";
+    group.Status.LastActionMs = nowMs();
+}
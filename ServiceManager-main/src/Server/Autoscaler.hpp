@@ -0,0 +1,129 @@
+/**
+ * @file Autoscaler.hpp
+ * @brief Scales the running replicas of service groups from local signals
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Coroutine.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+class ResourceSampler;
+class EventLog;
+
+/**
+ * @brief Scaling state of one group exposed to the API
+ */
+struct ScaleStatus {
+    std::string Group;
+    std::string Metric;           ///< "@scale.metric" as configured
+    size_t      Min = 0;
+    size_t      Max = 0;
+    size_t      Current = 0;      ///< Running replicas at the last evaluation
+    size_t      Desired = 0;      ///< Replica count after stabilization
+    double      Value = 0;        ///< Last metric value
+    double      Target = 0;       ///< Metric value one replica should handle
+    std::string Error;            ///< Why the last metric read failed (empty = ok)
+    std::string LastAction;       ///< "up", "down" or empty
+    int64_t     LastActionMs = 0; ///< Wall-clock time of the last scaling action
+};
+
+/**
+ * @brief Keeps the number of running replicas of a group between min and max
+ *
+ * The members of a service group ("@group") are its replicas. A group
+ * whose members set "@scale.max" is evaluated every "@scale.interval"
+ * seconds on the event loop: the metric is read (summed CPU of the running
+ * replicas, a value scraped from a replica's HTTP endpoint, or a queue
+ * depth from a file or Unix socket) and divided by "@scale.target" to get
+ * the recommended replica count.
+ *
+ * Recommendations are stabilized like a horizontal pod autoscaler: the
+ * group scales up to the lowest recommendation of the up window and down
+ * to the highest recommendation of the down window, so a short spike or
+ * dip does not change the replica count. After an action the group is left
+ * alone for "@scale.cooldown" seconds, and it is never scaled while a
+ * rollout of the group or a previous scaling operation is in progress.
+ * Replicas are started and stopped through the orchestrator, so a warm
+ * pool serves scale-ups when the member has one.
+ */
+class Autoscaler {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Starts and stops replicas
+     * @param sampler Provides the replicas' CPU usage
+     * @param loop Loop the evaluations run on
+     * @param events Event log receiving scaling actions
+     */
+    Autoscaler(ProcessRunner& runner, Orchestrator& orchestrator, ResourceSampler& sampler,
+               EventLoop& loop, EventLog& events);
+
+    /**
+     * @brief Start evaluating all scaled groups (callable from any thread)
+     */
+    void start();
+
+    /**
+     * @brief Stop evaluating (callable from any thread)
+     */
+    void stop();
+
+    /**
+     * @brief Get the scaling state of all scaled groups
+     */
+    std::vector<ScaleStatus> status() const;
+
+private:
+    enum class MetricKind { Cpu, Http, File, Socket };
+
+    struct Recommendation {
+        std::chrono::steady_clock::time_point At;
+        size_t                                Replicas;
+    };
+
+    struct Group {
+        std::vector<size_t>       Members;     ///< Command indices, lowest started first
+        MetricKind                Kind = MetricKind::Cpu;
+        uint16_t                  Port = 0;    ///< http: port on 127.0.0.1
+        std::string               Path;        ///< http: request path, file:/socket: path
+        std::string               Name;        ///< http: metric name (empty = whole body)
+        std::chrono::milliseconds Interval{10000};
+        std::chrono::milliseconds UpWindow{0};
+        std::chrono::milliseconds DownWindow{60000};
+        std::chrono::milliseconds Cooldown{30000};
+        std::chrono::steady_clock::time_point LastAction;
+        std::deque<Recommendation> History;    ///< Within the longer window (loop thread only)
+        std::vector<uint64_t>     Pending;     ///< Operations of the last action
+        bool                      Busy = false;
+        int                       Timer = -1;
+        ScaleStatus               Status;
+    };
+
+    ProcessRunner&     runner_;
+    Orchestrator&      orchestrator_;
+    ResourceSampler&   sampler_;
+    EventLoop&         loop_;
+    EventLog&          events_;
+    mutable std::mutex mutex_;  ///< Guards the Status of groups_
+    std::vector<Group> groups_;
+    bool               running_ = false;  ///< Loop thread only
+
+    bool configure(Group& group, const std::string& metric);
+    Task<void> evaluate(size_t index);
+    Task<std::optional<double>> readMetric(Group& group, std::string& error);
+    size_t stabilize(Group& group, size_t recommended, size_t current);
+    void scale(Group& group, size_t current, size_t desired);
+};
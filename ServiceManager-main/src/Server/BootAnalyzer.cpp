@@ -0,0 +1,227 @@
+/**
+ * @file BootAnalyzer.cpp
+ * @brief Implementation of the boot timeline recorder and analysis
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "BootAnalyzer.hpp"
+#include "EventLoop.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // read, close
+#include <algorithm>        // std::stable_sort
+#include <cerrno>           // errno, EAGAIN, EINTR
+#include <cstring>          // strerror
+
+namespace {
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+BootAnalyzer::BootAnalyzer(ProcessRunner& runner, EventLoop& loop)
+    : runner_(runner), loop_(loop) {
+}
+
+void BootAnalyzer::begin(uint64_t operation, int service, const std::vector<size_t>& order,
+                         const std::vector<std::vector<size_t>>& after) {
+    Boot boot;
+    boot.Operation = operation;
+    boot.Service = service;
+    boot.StartedMs = nowMs();
+    boot.Start = std::chrono::steady_clock::now();
+    for (size_t index : order) {
+        BootTiming timing;
+        timing.Index = index;
+        timing.Desc = runner_.getCommand(index).Desc;
+        timing.After = after[index];
+        boot.Services.push_back(timing);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    boots_.push_back(std::move(boot));
+    while (boots_.size() > MAX_BOOTS) {
+        boots_.pop_front();
+    }
+}
+
+void BootAnalyzer::starting(uint64_t operation, size_t index, bool running) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Boot* boot = find(operation);
+    BootTiming* service = boot ? timing(*boot, index) : nullptr;
+    if (!service) {
+        return;
+    }
+    service->SpawnMs = elapsed(*boot, now);
+    if (running) {
+        // Nothing to wait for; the service contributes no activation time
+        service->State = "running";
+        service->ReadyMs = service->SpawnMs;
+        service->DoneMs = service->SpawnMs;
+    } else {
+        service->State = "starting";
+    }
+}
+
+void BootAnalyzer::finished(uint64_t operation, size_t index, bool ok, bool skipped) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Boot* boot = find(operation);
+    BootTiming* service = boot ? timing(*boot, index) : nullptr;
+    if (!service || service->State == "running") {
+        return;
+    }
+    service->DoneMs = elapsed(*boot, now);
+    if (ok) {
+        service->State = "ready";
+        service->ReadyMs = service->DoneMs;
+    } else {
+        service->State = skipped ? "skipped" : "failed";
+    }
+}
+
+void BootAnalyzer::end(uint64_t operation, bool ok) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Boot* boot = find(operation);
+    if (boot) {
+        boot->State = ok ? "done" : "failed";
+        boot->TotalMs = elapsed(*boot, now);
+    }
+}
+
+bool BootAnalyzer::confirmsExec(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Boot& boot : boots_) {
+        if (boot.State != "running") {
+            continue;
+        }
+        for (const BootTiming& service : boot.Services) {
+            if (service.Index == index && service.State == "starting" && service.Pid < 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void BootAnalyzer::execPipe(size_t index, pid_t pid, int fd) {
+    loop_.post([this, index, pid, fd]() {
+        bool watched = loop_.watch(fd, [this, index, pid, fd](uint32_t) {
+            int error = 0;
+            ssize_t n = read(fd, &error, sizeof(error));
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+                return;
+            }
+            // EOF: the close-on-exec write end went away with a successful exec()
+            confirmed(index, pid, n == static_cast<ssize_t>(sizeof(error)) ? error : 0,
+                      std::chrono::steady_clock::now());
+            loop_.unwatch(fd);
+            close(fd);
+        });
+        if (!watched) {
+            close(fd);
+        }
+    });
+}
+
+void BootAnalyzer::confirmed(size_t index, pid_t pid, int error,
+                             std::chrono::steady_clock::time_point at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto boot = boots_.rbegin(); boot != boots_.rend(); ++boot) {
+        BootTiming* service = timing(*boot, index);
+        if (!service || service->SpawnMs < 0 || service->Pid >= 0) {
+            continue;
+        }
+        service->Pid = pid;
+        if (error != 0) {
+            service->ExecError = strerror(error);
+        } else {
+            service->ExecMs = elapsed(*boot, at);
+        }
+        return;
+    }
+}
+
+bool BootAnalyzer::analysis(uint64_t operation, BootAnalysis& analysis) const {
+    Boot boot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (boots_.empty()) {
+            return false;
+        }
+        auto it = boots_.end() - 1;
+        if (operation != 0) {
+            it = std::find_if(boots_.begin(), boots_.end(),
+                              [operation](const Boot& b) { return b.Operation == operation; });
+            if (it == boots_.end()) {
+                return false;
+            }
+        }
+        boot = *it;
+    }
+
+    analysis.Operation = boot.Operation;
+    analysis.Service = boot.Service;
+    analysis.State = boot.State;
+    analysis.StartedMs = boot.StartedMs;
+    analysis.TotalMs = boot.TotalMs;
+
+    analysis.Blame = boot.Services;
+    std::stable_sort(analysis.Blame.begin(), analysis.Blame.end(),
+                     [](const BootTiming& a, const BootTiming& b) {
+                         return a.activationMs() > b.activationMs();
+                     });
+
+    // The chain ends at the booted service, or at whichever service finished last
+    const BootTiming* current = nullptr;
+    if (boot.Service >= 0) {
+        current = timing(boot, static_cast<size_t>(boot.Service));
+    } else {
+        for (const BootTiming& service : boot.Services) {
+            if (service.DoneMs >= 0 && (!current || service.DoneMs > current->DoneMs)) {
+                current = &service;
+            }
+        }
+    }
+    while (current) {
+        analysis.CriticalChain.push_back(*current);
+        // Follow the dependency the service waited for longest
+        const BootTiming* gate = nullptr;
+        for (size_t dependency : current->After) {
+            const BootTiming* candidate = timing(boot, dependency);
+            if (candidate && candidate->DoneMs >= 0 && (!gate || candidate->DoneMs > gate->DoneMs)) {
+                gate = candidate;
+            }
+        }
+        current = gate;
+    }
+    return true;
+}
+
+BootAnalyzer::Boot* BootAnalyzer::find(uint64_t operation) {
+    for (Boot& boot : boots_) {
+        if (boot.Operation == operation) {
+            return &boot;
+        }
+    }
+    return nullptr;
+}
+
+BootTiming* BootAnalyzer::timing(Boot& boot, size_t index) {
+    for (BootTiming& service : boot.Services) {
+        if (service.Index == index) {
+            return &service;
+        }
+    }
+    return nullptr;
+}
+
+double BootAnalyzer::elapsed(const Boot& boot, std::chrono::steady_clock::time_point at) {
+    return std::chrono::duration<double, std::milli>(at - boot.Start).count();
+}
@@ -0,0 +1,164 @@
+/**
+ * @file BootAnalyzer.hpp
+ * @brief Timelines of dependency boots with blame and critical-chain analysis
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+class ProcessRunner;
+class EventLoop;
+
+/**
+ * @brief Timeline of one service within a boot
+ *
+ * Times are milliseconds since the boot was submitted (-1 = not reached).
+ */
+struct BootTiming {
+    size_t      Index = 0;
+    std::string Desc;
+    std::string State = "pending";  ///< "pending", "starting", "ready", "failed", "skipped" or "running"
+    std::vector<size_t> After;      ///< Dependencies within the boot
+    pid_t       Pid = -1;           ///< Forked instance (-1 if none was forked)
+    double      SpawnMs = -1;       ///< Dependencies ready, start requested
+    double      ExecMs = -1;        ///< exec() of the command confirmed
+    double      ReadyMs = -1;       ///< Readiness check passed
+    double      DoneMs = -1;        ///< Ready, failed or skipped
+    std::string ExecError;          ///< Why exec() failed (empty if it succeeded)
+
+    /**
+     * @brief Time from the start request until the service was ready or failed
+     */
+    double activationMs() const { return SpawnMs >= 0 && DoneMs >= 0 ? DoneMs - SpawnMs : -1; }
+};
+
+/**
+ * @brief Analysis of one boot
+ */
+struct BootAnalysis {
+    uint64_t    Operation = 0;
+    int         Service = -1;       ///< Booted service (-1 = all services)
+    std::string State;              ///< "running", "done" or "failed"
+    int64_t     StartedMs = 0;      ///< Wall-clock submission time
+    double      TotalMs = -1;       ///< Duration of the boot (-1 while running)
+    std::vector<BootTiming> Blame;          ///< Services by activation time, slowest first
+    std::vector<BootTiming> CriticalChain;  ///< Last service to finish, then what it waited for
+};
+
+/**
+ * @brief Records when each service of a boot was spawned, exec'd and ready
+ *
+ * The orchestrator reports every boot (a dependency start of one service or
+ * of all services): when a service's dependencies were ready and its start
+ * was requested, and when it became ready or failed. For native services
+ * ProcessRunner additionally hands over the read end of a close-on-exec
+ * pipe whose write end the child holds until exec(). The pipe reaches EOF
+ * the moment exec() succeeds, or carries the errno of a failed exec, so the
+ * fork-to-exec cost is separated from the service's own initialisation.
+ *
+ * analysis() ranks services by activation time ("blame") and walks the
+ * critical chain back from the last service to finish, always following the
+ * dependency that finished last, i.e. the one the service actually waited
+ * for. The most recent MAX_BOOTS boots are kept.
+ */
+class BootAnalyzer {
+public:
+    static constexpr size_t MAX_BOOTS = 8;
+
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param loop Loop the exec pipes are watched on
+     */
+    BootAnalyzer(ProcessRunner& runner, EventLoop& loop);
+
+    BootAnalyzer(const BootAnalyzer&) = delete;
+    BootAnalyzer& operator=(const BootAnalyzer&) = delete;
+
+    /**
+     * @brief Start recording a boot
+     * @param operation Operation ID of the boot
+     * @param service Booted service (-1 = all services)
+     * @param order Services of the boot in dependency order
+     * @param after Dependencies of every command, by command index
+     */
+    void begin(uint64_t operation, int service, const std::vector<size_t>& order,
+               const std::vector<std::vector<size_t>>& after);
+
+    /**
+     * @brief A service's dependencies are ready and its start is requested
+     * @param operation Operation ID of the boot
+     * @param index Command index
+     * @param running The service was already running (ready immediately)
+     */
+    void starting(uint64_t operation, size_t index, bool running);
+
+    /**
+     * @brief A service became ready, failed, or was skipped because a dependency failed
+     * @param operation Operation ID of the boot
+     * @param index Command index
+     * @param ok Service is ready
+     * @param skipped Service was never started
+     */
+    void finished(uint64_t operation, size_t index, bool ok, bool skipped);
+
+    /**
+     * @brief Stop recording a boot
+     * @param operation Operation ID of the boot
+     * @param ok Every service is ready
+     */
+    void end(uint64_t operation, bool ok);
+
+    /**
+     * @brief Check whether a start of a service should be confirmed with an exec pipe
+     * @param index Command index
+     * @return true while a boot waits for the service to start
+     */
+    bool confirmsExec(size_t index) const;
+
+    /**
+     * @brief Watch the exec-confirm pipe of a forked instance (callable from any thread)
+     * @param index Command index
+     * @param pid Forked instance
+     * @param fd Non-blocking read end of the pipe (ownership is taken)
+     */
+    void execPipe(size_t index, pid_t pid, int fd);
+
+    /**
+     * @brief Analyse a boot
+     * @param operation Operation ID of the boot (0 = the most recent one)
+     * @param analysis Receives the analysis
+     * @return false if the boot is not (or no longer) recorded
+     */
+    bool analysis(uint64_t operation, BootAnalysis& analysis) const;
+
+private:
+    struct Boot {
+        uint64_t Operation = 0;
+        int      Service = -1;
+        std::string State = "running";
+        int64_t  StartedMs = 0;
+        std::chrono::steady_clock::time_point Start;
+        double   TotalMs = -1;
+        std::vector<BootTiming> Services;  ///< In dependency order
+    };
+
+    ProcessRunner&     runner_;
+    EventLoop&         loop_;
+    mutable std::mutex mutex_;  ///< Guards boots_
+    std::deque<Boot>   boots_;  ///< Oldest first
+
+    Boot* find(uint64_t operation);
+    static BootTiming* timing(Boot& boot, size_t index);
+    static double elapsed(const Boot& boot, std::chrono::steady_clock::time_point at);
+    void confirmed(size_t index, pid_t pid, int error, std::chrono::steady_clock::time_point at);
+};
@@ -0,0 +1,124 @@
+/**
+ * @file CgroupManager.cpp
+ * @brief Implementation of per-service cgroup v2 management
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "CgroupManager.hpp"
+
+#include <fcntl.h>      // open
+#include <unistd.h>     // write, close, access
+#include <sys/stat.h>   // mkdir
+#include <cerrno>       // errno
+#include <fstream>      // std::ifstream
+#include <iostream>     // std::cerr
+#include <sstream>      // std::stringstream
+
+namespace {
+
+bool writeFile(const std::string& path, const std::string& value) {
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t written = write(fd, value.data(), value.size());
+    close(fd);
+    return written == static_cast<ssize_t>(value.size());
+}
+
+} // namespace
+
+CgroupManager::CgroupManager(const std::string& root) {
+    if (root.empty()) {
+        return;
+    }
+    if (access((root + "/cgroup.procs").c_str(), W_OK) != 0) {
+        std::cerr << "CgroupManager: " << root << " is not a writable cgroup v2 directory, "
+                  << "cgroup features disabled" << std::endl;
+        return;
+    }
+    root_ = root;
+
+    // Controllers must be enabled one at a time: a missing one must not
+    // prevent the others from being delegated.
+    for (const char* controller : {"+cpu", "+io", "+memory"}) {
+        if (!writeFile(root_ + "/cgroup.subtree_control", controller)) {
+            std::cerr << "CgroupManager: could not enable " << (controller + 1)
+                      << " controller below " << root_ << std::endl;
+        }
+    }
+}
+
+bool CgroupManager::available() const {
+    return !root_.empty();
+}
+
+std::string CgroupManager::pathFor(size_t index) const {
+    if (root_.empty()) {
+        return "";
+    }
+    return root_ + "/svc-" + std::to_string(index);
+}
+
+bool CgroupManager::prepare(size_t index) const {
+    if (root_.empty()) {
+        return false;
+    }
+    std::string path = pathFor(index);
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        perror("CgroupManager::prepare: mkdir failed");
+        return false;
+    }
+    return true;
+}
+
+bool CgroupManager::attach(size_t index, pid_t pid) const {
+    if (root_.empty()) {
+        return false;
+    }
+    std::string path = pathFor(index) + "/cgroup.procs";
+    std::string value = std::to_string(pid);
+    return writeFile(path, value);
+}
+
+int CgroupManager::openProcs(size_t index) const {
+    if (root_.empty()) {
+        return -1;
+    }
+    std::string path = pathFor(index) + "/cgroup.procs";
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror("CgroupManager::openProcs: open failed");
+    }
+    return fd;
+}
+
+bool CgroupManager::writeControl(size_t index, const std::string& file, const std::string& value) const {
+    if (root_.empty()) {
+        return false;
+    }
+    if (!writeFile(pathFor(index) + "/" + file, value)) {
+        std::cerr << "CgroupManager: failed to write '" << value << "' to "
+                  << pathFor(index) << "/" << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CgroupManager::readControl(size_t index, const std::string& file, std::string& value) const {
+    if (root_.empty()) {
+        return false;
+    }
+    std::ifstream in(pathFor(index) + "/" + file);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    value = buffer.str();
+    while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) {
+        value.pop_back();
+    }
+    return true;
+}
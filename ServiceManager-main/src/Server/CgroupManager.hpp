@@ -0,0 +1,94 @@
+/**
+ * @file CgroupManager.hpp
+ * @brief Per-service cgroup v2 placement and control file access
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @brief Manages one cgroup v2 directory per service below a delegated root
+ *
+ * The root is a cgroup ServiceMN may write to (e.g. a systemd Delegate=yes
+ * slice). Each service gets "<root>/svc-<index>", and spawned processes move
+ * themselves there before exec so that all of their descendants inherit it.
+ * When no usable root is configured every operation fails gracefully and
+ * callers fall back to per-process mechanisms (nice, ionice).
+ */
+class CgroupManager {
+public:
+    /**
+     * @brief Constructor
+     * @param root Delegated cgroup v2 directory (empty disables cgroup support)
+     *
+     * Enables the cpu, io and memory controllers for the root's children on a
+     * best-effort basis.
+     */
+    explicit CgroupManager(const std::string& root);
+
+    /**
+     * @brief Check whether cgroup placement is usable
+     * @return true if the root exists and is writable
+     */
+    bool available() const;
+
+    /**
+     * @brief Get the cgroup directory of a service
+     * @param index Index of the command
+     * @return Absolute path (empty if cgroups are unavailable)
+     */
+    std::string pathFor(size_t index) const;
+
+    /**
+     * @brief Create the cgroup directory of a service if missing
+     * @param index Index of the command
+     * @return true if the directory exists afterwards
+     */
+    bool prepare(size_t index) const;
+
+    /**
+     * @brief Move a process into the cgroup of a service
+     * @param index Index of the command
+     * @param pid Process to move (0 moves the calling process)
+     * @return true on success
+     *
+     * Builds the path on the heap, so it must not be called in a forked
+     * child; a child joins through a descriptor from openProcs() instead.
+     */
+    bool attach(size_t index, pid_t pid) const;
+
+    /**
+     * @brief Open the cgroup.procs file of a service cgroup for writing
+     * @param index Index of the command
+     * @return Close-on-exec descriptor, or -1 on failure
+     *
+     * Writing "0" to it moves the writing process, which a forked child can
+     * do with a single write() before exec.
+     */
+    int openProcs(size_t index) const;
+
+    /**
+     * @brief Write a control file of a service cgroup (e.g. "cpu.max")
+     * @param index Index of the command
+     * @param file Control file name
+     * @param value Value to write
+     * @return true on success
+     */
+    bool writeControl(size_t index, const std::string& file, const std::string& value) const;
+
+    /**
+     * @brief Read a control file of a service cgroup
+     * @param index Index of the command
+     * @param file Control file name
+     * @param value Receives the file contents without trailing newline
+     * @return true on success
+     */
+    bool readControl(size_t index, const std::string& file, std::string& value) const;
+
+private:
+    std::string root_;        ///< Delegated cgroup root (empty if unavailable)
+};
@@ -0,0 +1,390 @@
+/**
+ * @file Checkpointer.cpp
+ * @brief Implementation of the CRIU checkpoint/restore fast-start mode
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "Checkpointer.hpp"
+#include "AsyncOps.hpp"
+#include "EventLog.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // fork, execvp, dup2, readlink, close
+#include <fcntl.h>          // open, O_RDWR
+#include <sys/prctl.h>      // prctl, PR_SET_CHILD_SUBREAPER
+#include <sys/wait.h>       // WIFEXITED, WEXITSTATUS
+#include <csignal>          // SIGKILL
+#include <cstdio>           // perror, snprintf
+#include <filesystem>       // std::filesystem
+#include <fstream>          // std::ifstream, std::ofstream
+
+namespace {
+
+constexpr std::chrono::milliseconds CRIU_TIMEOUT{120000};
+constexpr std::chrono::milliseconds KILL_WAIT{5000};
+constexpr std::chrono::milliseconds WATCH_INTERVAL{1000};
+constexpr int INHERIT_FD_BASE = 100;   ///< Where handed-over fds are placed for criu restore
+constexpr int MAX_INHERITED_FD = 3;    ///< stdin, stdout, stderr and the "@listen" socket
+constexpr const char* FDS_FILE = "servicemn.fds";
+constexpr const char* COLOR_FILE = "servicemn.color";  ///< SERVICEMN_COLOR of the dumped instance
+
+// Options shared by dump and restore: services run in ServiceMN's session
+// and may hold TCP connections, Unix sockets to outside peers and locks.
+const std::vector<std::string> COMMON_ARGS = {
+    "--shell-job", "--tcp-established", "--ext-unix-sk", "--file-locks"
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+/**
+ * @brief Fork and exec criu with stdio on /dev/null
+ * @param criu Path of the criu binary
+ * @param args Arguments after the binary name
+ * @param fds Descriptors to place at INHERIT_FD_BASE + key in the child
+ * @return PID of criu, or -1 if fork failed
+ */
+pid_t runCriu(const std::string& criu, const std::vector<std::string>& args,
+              const std::map<int, int>& fds = {}) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    int null = open("/dev/null", O_RDWR);
+    if (null >= 0) {
+        dup2(null, STDIN_FILENO);
+        dup2(null, STDOUT_FILENO);
+        dup2(null, STDERR_FILENO);
+    }
+    for (const auto& entry : fds) {
+        dup2(entry.second, INHERIT_FD_BASE + entry.first);  // Clears O_CLOEXEC on the copy
+    }
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(criu.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    execvp(argv[0], argv.data());
+    _exit(127);
+}
+
+std::string exitText(int status) {
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status) == 127 ? std::string("criu could not be executed")
+                                          : "criu exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    return "criu was killed by signal " + std::to_string(WIFSIGNALED(status) ? WTERMSIG(status) : 0);
+}
+
+} // namespace
+
+Checkpointer::Checkpointer(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop,
+                           EventLog& events, const std::string& criu)
+    : runner_(runner), orchestrator_(orchestrator), loop_(loop), events_(events), criu_(criu) {
+    services_.resize(runner_.getCommandCount());
+
+    bool any = false;
+    for (size_t i = 0; i < services_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        std::string dir = cmd.option("criu.dir");
+        if (dir.empty()) {
+            continue;
+        }
+        if (cmd.Mode != 'C') {
+            events_.record(static_cast<int>(i), "criu.config",
+                           "Checkpoint/restore is only supported for native services");
+            continue;
+        }
+        std::error_code error;
+        std::filesystem::create_directories(dir, error);
+        if (error) {
+            events_.record(static_cast<int>(i), "criu.config",
+                           "Cannot create " + dir + ": " + error.message());
+            continue;
+        }
+        Service& service = services_[i];
+        service.Dir = dir;
+        service.Stats.Dir = dir;
+        double warmup = cmd.optionNumber("criu.warmup", 0);
+        service.Warmup = std::chrono::milliseconds(static_cast<int64_t>(std::max(warmup, 0.0) * 1000));
+        any = true;
+    }
+
+    // criu restore --restore-detached leaves the restored tree to the nearest subreaper
+    if (any && prctl(PR_SET_CHILD_SUBREAPER, 1) != 0) {
+        perror("Checkpointer: PR_SET_CHILD_SUBREAPER failed");
+    }
+}
+
+void Checkpointer::start() {
+    loop_.post([this]() {
+        loop_.addTimer(WATCH_INTERVAL, [this]() { watch(); });
+        watch();
+    });
+}
+
+bool Checkpointer::hasImage(size_t index) const {
+    if (index >= services_.size() || services_[index].Dir.empty()) {
+        return false;
+    }
+    std::error_code error;
+    return std::filesystem::exists(services_[index].Dir + "/current/" + FDS_FILE, error);
+}
+
+Task<pid_t> Checkpointer::restore(size_t index, std::map<int, int> fds, std::string color) {
+    if (!hasImage(index)) {
+        co_return -1;
+    }
+    const Service& service = services_[index];
+    std::string current = service.Dir + "/current";
+
+    // The environment is part of the image, so SERVICEMN_COLOR cannot be changed on restore
+    std::string imageColor;
+    std::ifstream(current + "/" + COLOR_FILE) >> imageColor;
+    if (imageColor != color) {
+        std::error_code ignored;
+        std::filesystem::remove_all(current, ignored);
+        events_.record(static_cast<int>(index), "criu.restore",
+                       "Image was taken from a " + (imageColor.empty() ? std::string("unknown") : imageColor) +
+                       " instance, starting " + color + " normally and checkpointing it again");
+        co_return -1;
+    }
+    std::string pidFile = current + "/restore.pid";
+    unlink(pidFile.c_str());
+
+    std::vector<std::string> args = {"restore", "-D", current, "-o", "restore.log",
+                                     "--restore-detached", "--pidfile", pidFile};
+    args.insert(args.end(), COMMON_ARGS.begin(), COMMON_ARGS.end());
+
+    // Replace the checkpointed process's external pipes and sockets with ours
+    std::map<int, int> inherit;
+    std::ifstream recorded(current + "/" + FDS_FILE);
+    int fd;
+    std::string link;
+    while (recorded >> fd >> link) {
+        auto it = fds.find(fd);
+        if (it != fds.end()) {
+            inherit[fd] = it->second;
+            args.push_back("--inherit-fd");
+            args.push_back("fd[" + std::to_string(INHERIT_FD_BASE + fd) + "]:" + link);
+        }
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    pid_t child = runCriu(criu_, args, inherit);
+    int pidfd = child > 0 ? openPidfd(child) : -1;
+    bool exited = pidfd >= 0 && co_await childExit(loop_, pidfd, CRIU_TIMEOUT);
+    if (!exited && pidfd >= 0) {
+        signalPidfd(pidfd, SIGKILL);
+        co_await childExit(loop_, pidfd, KILL_WAIT);
+    }
+    if (pidfd >= 0) {
+        close(pidfd);
+    }
+
+    int status = 0;
+    std::string error;
+    pid_t pid = -1;
+    if (child < 0) {
+        error = "fork failed";
+    } else if (!exited) {
+        error = "criu timed out";
+    } else if (!runner_.exitStatus(child, status) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        error = exitText(status) + ", see " + service.Dir + "/failed/restore.log";
+    } else {
+        std::ifstream restored(pidFile);
+        if (!(restored >> pid) || pid <= 0 || ::kill(pid, 0) != 0) {
+            error = "criu did not report a running process";
+            pid = -1;
+        }
+    }
+
+    if (pid < 0) {
+        // A broken image would fail every start; take a new one after the normal exec
+        std::error_code ignored;
+        std::filesystem::remove_all(service.Dir + "/failed", ignored);
+        std::filesystem::rename(current, service.Dir + "/failed", ignored);
+        setError(index, "Restore failed: " + error);
+        events_.record(static_cast<int>(index), "criu.restore",
+                       "Restore failed (" + error + "), image discarded, starting normally");
+        co_return -1;
+    }
+
+    double ms = elapsedMs(started);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CheckpointStats& stats = services_[index].Stats;
+        ++stats.Restores;
+        stats.LastRestoreMs = ms;
+        stats.LastError.clear();
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.0f", ms);
+    events_.record(static_cast<int>(index), "criu.restore",
+                   "Restored PID " + std::to_string(pid) + " in " + text + " ms");
+    co_return pid;
+}
+
+void Checkpointer::restoreLater(size_t index) {
+    loop_.post([this, index]() { spawn(restoreInstance(index)); });
+}
+
+Task<void> Checkpointer::restoreInstance(size_t index) {
+    co_await runner_.restore(index);
+}
+
+bool Checkpointer::checkpoint(size_t index) {
+    if (index >= services_.size() || services_[index].Dir.empty()) {
+        return false;
+    }
+    pid_t pid = runner_.getPid(index);
+    if (pid <= 0) {
+        return false;
+    }
+    loop_.post([this, index, pid]() {
+        if (!services_[index].Stats.Dumping) {
+            spawn(dump(index, pid));
+        }
+    });
+    return true;
+}
+
+CheckpointStats Checkpointer::stats(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= services_.size()) {
+        return CheckpointStats();
+    }
+    CheckpointStats stats = services_[index].Stats;
+    stats.Image = hasImage(index);
+    return stats;
+}
+
+void Checkpointer::watch() {
+    for (size_t i = 0; i < services_.size(); ++i) {
+        Service& service = services_[i];
+        if (service.Dir.empty()) {
+            continue;
+        }
+        pid_t pid = runner_.getPid(i);
+        if (pid <= 0 || pid == service.Seen) {
+            continue;
+        }
+        service.Seen = pid;
+        if (!hasImage(i)) {
+            spawn(checkpointWhenWarm(i, pid));
+        }
+    }
+}
+
+Task<void> Checkpointer::checkpointWhenWarm(size_t index, pid_t pid) {
+    int pidfd = openPidfd(pid);
+    if (pidfd < 0) {
+        co_return;
+    }
+    bool ready = co_await orchestrator_.instanceReady(index, pid);
+    if (ready) {
+        co_await sleepFor(loop_, services_[index].Warmup);
+    }
+    bool alive = !pidfdExited(pidfd);
+    close(pidfd);
+    if (ready && alive && runner_.getPid(index) == pid && !services_[index].Stats.Dumping) {
+        co_await dump(index, pid);
+    }
+}
+
+Task<void> Checkpointer::dump(size_t index, pid_t pid) {
+    Service& service = services_[index];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        service.Stats.Dumping = true;
+    }
+
+    // The instance being dumped is the current one, so it has the current color
+    std::string color = runner_.color(index);
+
+    // Remember which pipes and sockets the process got from ServiceMN
+    std::string fds;
+    for (int fd = 0; fd <= MAX_INHERITED_FD; ++fd) {
+        char link[128];
+        std::string path = "/proc/" + std::to_string(pid) + "/fd/" + std::to_string(fd);
+        ssize_t length = readlink(path.c_str(), link, sizeof(link) - 1);
+        if (length <= 0) {
+            continue;
+        }
+        std::string target(link, static_cast<size_t>(length));
+        if (target.compare(0, 5, "pipe:") == 0 || target.compare(0, 7, "socket:") == 0) {
+            fds += std::to_string(fd) + " " + target + "\n";
+        }
+    }
+
+    std::string next = service.Dir + "/next";
+    std::error_code ignored;
+    std::filesystem::remove_all(next, ignored);
+    std::filesystem::create_directories(next, ignored);
+
+    std::vector<std::string> args = {"dump", "-t", std::to_string(pid), "-D", next, "-o", "dump.log",
+                                     "--leave-running"};
+    args.insert(args.end(), COMMON_ARGS.begin(), COMMON_ARGS.end());
+
+    auto started = std::chrono::steady_clock::now();
+    pid_t child = runCriu(criu_, args);
+    int pidfd = child > 0 ? openPidfd(child) : -1;
+    bool exited = pidfd >= 0 && co_await childExit(loop_, pidfd, CRIU_TIMEOUT);
+    if (!exited && pidfd >= 0) {
+        signalPidfd(pidfd, SIGKILL);
+        co_await childExit(loop_, pidfd, KILL_WAIT);
+    }
+    if (pidfd >= 0) {
+        close(pidfd);
+    }
+
+    int status = 0;
+    std::string error;
+    if (child < 0) {
+        error = "fork failed";
+    } else if (!exited) {
+        error = "criu timed out";
+    } else if (!runner_.exitStatus(child, status) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        error = exitText(status) + ", see " + next + "/dump.log";
+    } else {
+        std::ofstream(next + "/" + FDS_FILE) << fds;
+        std::ofstream(next + "/" + COLOR_FILE) << color << "\n";
+        std::string current = service.Dir + "/current";
+        std::filesystem::remove_all(current, ignored);
+        std::error_code renamed;
+        std::filesystem::rename(next, current, renamed);
+        if (renamed) {
+            error = "Cannot install image: " + renamed.message();
+        }
+    }
+
+    double ms = elapsedMs(started);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        service.Stats.Dumping = false;
+        if (error.empty()) {
+            ++service.Stats.Checkpoints;
+            service.Stats.LastDumpMs = ms;
+            service.Stats.LastError.clear();
+        }
+    }
+    if (!error.empty()) {
+        setError(index, "Checkpoint failed: " + error);
+        events_.record(static_cast<int>(index), "criu.dump", "Checkpoint failed: " + error);
+        co_return;
+    }
+    char text[32];
+    snprintf(text, sizeof(text), "%.0f", ms);
+    events_.record(static_cast<int>(index), "criu.dump",
+                   "Checkpointed PID " + std::to_string(pid) + " in " + text + " ms");
+}
+
+void Checkpointer::setError(size_t index, const std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++services_[index].Stats.Failures;
+    services_[index].Stats.LastError = error;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file Checkpointer.hpp
+ * @brief CRIU checkpoint/restore of warmed-up services for fast starts
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+class EventLog;
+
+/**
+ * @brief Per-service checkpoint state exposed to the API
+ */
+struct CheckpointStats {
+    std::string Dir;                ///< Image directory ("@criu.dir")
+    bool        Image = false;      ///< A usable image exists
+    bool        Dumping = false;    ///< A checkpoint is being taken
+    uint64_t    Checkpoints = 0;    ///< Successful dumps
+    uint64_t    Restores = 0;       ///< Starts served from the image
+    uint64_t    Failures = 0;       ///< Failed dumps and restores
+    double      LastDumpMs = 0;     ///< Duration of the latest dump
+    double      LastRestoreMs = 0;  ///< Duration of the latest restore
+    std::string LastError;
+};
+
+/**
+ * @brief Checkpoints warmed-up services with CRIU and restores them on start
+ *
+ * A native service with "@criu.dir=PATH" is checkpointed once it is ready
+ * and has run for "@criu.warmup" more seconds: "criu dump --leave-running"
+ * writes the image to PATH/next, which replaces PATH/current when the dump
+ * succeeds. Later starts run "criu restore" from PATH/current instead of
+ * exec'ing the command, so the service resumes fully initialised. The
+ * service's stdout/stderr pipes and "@listen" socket are handed to the
+ * restored process with --inherit-fd. A failed restore discards the image
+ * and the start falls back to a normal exec, after which a new checkpoint
+ * is taken.
+ *
+ * ServiceMN becomes a child subreaper so that restored processes, detached
+ * from criu, are reparented to it and reaped like any other instance.
+ */
+class Checkpointer {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Provides the services' readiness checks
+     * @param loop Loop the checkpoints run on
+     * @param events Event log receiving checkpoint events
+     * @param criu Path of the criu binary
+     */
+    Checkpointer(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop, EventLog& events,
+                 const std::string& criu);
+
+    /**
+     * @brief Start watching services for instances to checkpoint (callable from any thread)
+     */
+    void start();
+
+    /**
+     * @brief Check whether a start of a service can be served from an image
+     * @param index Command index
+     */
+    bool hasImage(size_t index) const;
+
+    /**
+     * @brief Restore a service from its image (event loop thread)
+     * @param index Command index
+     * @param fds Descriptors to hand over, by the fd number they had in the
+     *            checkpointed process (e.g. 1 and 2 for output pipes)
+     * @param color SERVICEMN_COLOR the instance must have; an image taken
+     *              from the other color is discarded instead of restored
+     * @return Process ID of the restored instance, or -1 if the restore failed
+     *
+     * Awaits criu's exit like a dump, so neither the loop nor the runner
+     * is blocked while it runs.
+     */
+    Task<pid_t> restore(size_t index, std::map<int, int> fds, std::string color);
+
+    /**
+     * @brief Run ProcessRunner::restore() for a start requested off the loop (callable from any thread)
+     * @param index Command index
+     */
+    void restoreLater(size_t index);
+
+    /**
+     * @brief Take a fresh checkpoint of a running service (callable from any thread)
+     * @param index Command index
+     * @return false if the service has no "@criu.dir" or is not running
+     */
+    bool checkpoint(size_t index);
+
+    /**
+     * @brief Get the checkpoint state of a service
+     * @param index Command index
+     */
+    CheckpointStats stats(size_t index) const;
+
+private:
+    struct Service {
+        std::string               Dir;  ///< Empty if the service is not checkpointed
+        std::chrono::milliseconds Warmup{0};
+        pid_t                     Seen = -1;  ///< Last instance considered (loop thread only)
+        CheckpointStats           Stats;
+    };
+
+    ProcessRunner&       runner_;
+    Orchestrator&        orchestrator_;
+    EventLoop&           loop_;
+    EventLog&            events_;
+    std::string          criu_;
+    mutable std::mutex   mutex_;  ///< Guards Stats of services_
+    std::vector<Service> services_;
+
+    void watch();
+    Task<void> checkpointWhenWarm(size_t index, pid_t pid);
+    Task<void> dump(size_t index, pid_t pid);
+    Task<void> restoreInstance(size_t index);
+    void setError(size_t index, const std::string& error);
+};
@@ -0,0 +1,259 @@
+/**
+ * @file ContainerStats.cpp
+ * @brief Implementation of cgroup-based Docker container sampling
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "ContainerStats.hpp"
+#include "AsyncOps.hpp"
+#include "EventLog.hpp"
+
+#include <fcntl.h>          // open, O_RDONLY
+#include <unistd.h>         // pread, close
+#include <cstdlib>          // strtol, strtoull
+#include <fstream>          // std::ifstream
+#include <sstream>          // std::istringstream
+
+namespace {
+
+constexpr size_t READ_BUFFER = 16384;
+
+std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::istringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, separator)) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+/// Sum the byte counters of io.stat ("8:0 rbytes=1 wbytes=2 ...")
+void parseIoStat(const std::string& text, ContainerUsage& usage) {
+    std::istringstream fields(text);
+    std::string field;
+    while (fields >> field) {
+        if (field.rfind("rbytes=", 0) == 0) {
+            usage.IoReadBytes += strtoull(field.c_str() + 7, nullptr, 10);
+        } else if (field.rfind("wbytes=", 0) == 0) {
+            usage.IoWriteBytes += strtoull(field.c_str() + 7, nullptr, 10);
+        }
+    }
+}
+
+/// Sum the per-device lines of blkio.throttle.io_service_bytes ("8:0 Read 123")
+void parseBlkio(const std::string& text, ContainerUsage& usage) {
+    std::istringstream lines(text);
+    std::string device, operation;
+    uint64_t bytes;
+    while (lines >> device >> operation >> bytes) {
+        if (operation == "Read") {
+            usage.IoReadBytes += bytes;
+        } else if (operation == "Write") {
+            usage.IoWriteBytes += bytes;
+        }
+    }
+}
+
+} // namespace
+
+ContainerStats::ContainerStats(size_t count, EventLoop& loop, EventLog& events)
+    : loop_(loop), events_(events), containers_(count), buffer_(READ_BUFFER) {
+    // "<id> <parent> <dev> <root> <mount point> <options> ... - <type> <source> <super options>"
+    std::ifstream mountinfo("/proc/self/mountinfo");
+    std::string line;
+    while (std::getline(mountinfo, line)) {
+        auto separator = line.find(" - ");
+        if (separator == std::string::npos) {
+            continue;
+        }
+        std::vector<std::string> fields = split(line.substr(0, separator), ' ');
+        std::vector<std::string> tail = split(line.substr(separator + 3), ' ');
+        if (fields.size() < 5 || tail.size() < 3) {
+            continue;
+        }
+        if (tail[0] == "cgroup2" && unifiedMount_.empty()) {
+            unifiedMount_ = fields[4];
+        } else if (tail[0] == "cgroup") {
+            for (const std::string& option : split(tail[2], ',')) {
+                controllerMounts_.emplace(option, fields[4]);
+            }
+        }
+    }
+}
+
+ContainerStats::~ContainerStats() {
+    for (Container& container : containers_) {
+        close(container);
+    }
+}
+
+bool ContainerStats::sample(size_t index, const command& cmd, ContainerUsage& usage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= containers_.size()) {
+        return false;
+    }
+    Container& container = containers_[index];
+    auto now = std::chrono::steady_clock::now();
+
+    // Every start is a new instance whose cgroup may have been recreated
+    if (container.Generation != cmd.Pid) {
+        close(container);
+        container = Container();
+        container.Generation = cmd.Pid;
+    }
+    if (container.CpuFd < 0) {
+        if (!container.Pending && now >= container.RetryAt) {
+            container.Pending = true;
+            loop_.post([this, index, name = cmd.Path, generation = cmd.Pid]() {
+                spawn(resolve(index, name, generation));
+            });
+        }
+        return false;
+    }
+
+    std::string text;
+    if (!read(container.CpuFd, text)) {
+        close(container);  // Resolved again on the next tick
+        return false;
+    }
+    if (container.Unified) {
+        std::istringstream fields(text);
+        std::string key;
+        uint64_t value;
+        while (fields >> key >> value) {
+            if (key == "usage_usec") {
+                usage.CpuTimeUs = value;
+                break;
+            }
+        }
+    } else {
+        usage.CpuTimeUs = strtoull(text.c_str(), nullptr, 10) / 1000;  // cpuacct.usage is in ns
+    }
+    if (container.MemoryFd >= 0 && read(container.MemoryFd, text)) {
+        usage.MemoryBytes = strtoull(text.c_str(), nullptr, 10);
+    }
+    if (container.IoFd >= 0 && read(container.IoFd, text)) {
+        if (container.Unified) {
+            parseIoStat(text, usage);
+        } else {
+            parseBlkio(text, usage);
+        }
+    }
+    return true;
+}
+
+std::string ContainerStats::cgroupPath(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index < containers_.size() && containers_[index].CpuFd >= 0 ? containers_[index].Path : "";
+}
+
+Task<void> ContainerStats::resolve(size_t index, std::string name, pid_t generation) {
+    HttpReply reply = co_await dockerRequest(loop_, "GET", "/containers/" + name + "/json", RESOLVE_TIMEOUT);
+    // The first "Pid" of an inspect document is State.Pid, the container's init in our namespace
+    pid_t pid = 0;
+    auto at = reply.Body.find("\"Pid\":");
+    if (reply.Status == 200 && at != std::string::npos) {
+        pid = static_cast<pid_t>(strtol(reply.Body.c_str() + at + 6, nullptr, 10));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Container& container = containers_[index];
+    if (container.Generation != generation) {
+        co_return;  // Restarted meanwhile; the new instance resolves itself
+    }
+    container.Pending = false;
+    if (pid > 0 && open(container, pid)) {
+        container.Reported = false;
+        co_return;
+    }
+    container.RetryAt = std::chrono::steady_clock::now() + RESOLVE_RETRY;
+    if (!container.Reported) {
+        container.Reported = true;
+        std::string reason = reply.Status == 0 ? "Docker API unreachable"
+                           : reply.Status != 200 ? "inspect returned HTTP " + std::to_string(reply.Status)
+                           : pid <= 0 ? "container is not running"
+                           : "no cgroup found for PID " + std::to_string(pid);
+        events_.record(static_cast<int>(index), "container.cgroup",
+                       "Cannot sample container " + name + ": " + reason);
+    }
+}
+
+bool ContainerStats::open(Container& container, pid_t pid) {
+    // "<hierarchy>:<controllers>:<path>", with "0::<path>" for the unified hierarchy
+    std::ifstream cgroups("/proc/" + std::to_string(pid) + "/cgroup");
+    std::map<std::string, std::string> paths;
+    std::string unifiedPath;
+    std::string line;
+    while (std::getline(cgroups, line)) {
+        auto first = line.find(':');
+        auto second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+        std::string controllers = line.substr(first + 1, second - first - 1);
+        std::string path = line.substr(second + 1);
+        if (controllers.empty()) {
+            unifiedPath = path;
+        }
+        for (const std::string& controller : split(controllers, ',')) {
+            paths[controller] = path;
+        }
+    }
+
+    auto openFile = [](const std::string& path) {
+        return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    };
+    // v1 accounting wins on hybrid hosts, where the unified hierarchy has no controllers
+    auto cpuacct = controllerMounts_.find("cpuacct");
+    if (cpuacct != controllerMounts_.end() && paths.count("cpuacct")) {
+        container.Unified = false;
+        container.Path = cpuacct->second + paths["cpuacct"];
+        container.CpuFd = openFile(container.Path + "/cpuacct.usage");
+        auto memory = controllerMounts_.find("memory");
+        if (memory != controllerMounts_.end() && paths.count("memory")) {
+            container.MemoryFd = openFile(memory->second + paths["memory"] + "/memory.usage_in_bytes");
+        }
+        auto blkio = controllerMounts_.find("blkio");
+        if (blkio != controllerMounts_.end() && paths.count("blkio")) {
+            container.IoFd = openFile(blkio->second + paths["blkio"] + "/blkio.throttle.io_service_bytes");
+        }
+    } else if (!unifiedMount_.empty() && !unifiedPath.empty()) {
+        container.Unified = true;
+        container.Path = unifiedMount_ + unifiedPath;
+        container.CpuFd = openFile(container.Path + "/cpu.stat");
+        container.MemoryFd = openFile(container.Path + "/memory.current");
+        container.IoFd = openFile(container.Path + "/io.stat");
+    }
+    if (container.CpuFd < 0) {
+        close(container);
+        return false;
+    }
+    return true;
+}
+
+void ContainerStats::close(Container& container) {
+    for (int* fd : {&container.CpuFd, &container.MemoryFd, &container.IoFd}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+bool ContainerStats::read(int fd, std::string& text) {
+    text.clear();
+    // Offset 0 makes the kernel regenerate the file, so no lseek() is needed
+    for (off_t offset = 0;;) {
+        ssize_t length = pread(fd, buffer_.data(), buffer_.size(), offset);
+        if (length < 0) {
+            return false;
+        }
+        text.append(buffer_.data(), static_cast<size_t>(length));
+        if (static_cast<size_t>(length) < buffer_.size()) {
+            return true;
+        }
+        offset += length;
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file ContainerStats.hpp
+ * @brief Docker container CPU, memory and I/O usage read straight from cgroup files
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+#include "command.hpp"
+
+class EventLog;
+
+/**
+ * @brief Cumulative resource usage of one container
+ */
+struct ContainerUsage {
+    uint64_t CpuTimeUs = 0;
+    uint64_t MemoryBytes = 0;   ///< memory.current (memory.usage_in_bytes on cgroup v1)
+    uint64_t IoReadBytes = 0;
+    uint64_t IoWriteBytes = 0;
+};
+
+/**
+ * @brief Samples the cgroups of Docker ('D' mode) services without the daemon
+ *
+ * `docker stats` and the Engine API stats stream cost a daemon round trip
+ * and a JSON document per container and tick. Instead, the first time the
+ * sampler sees a newly started container, its cgroup is resolved once on the
+ * event loop: a single inspect call yields the container's init PID, whose
+ * /proc/<pid>/cgroup names the directory. The CPU, memory and I/O files
+ * are then opened and every tick rereads them with pread() on the cached
+ * descriptors, so a container costs the same three syscalls as a native
+ * service's cgroup. Both the unified (v2) hierarchy and the cpuacct, memory
+ * and blkio v1 controllers are supported; mount points come from
+ * /proc/self/mountinfo.
+ *
+ * A read error (the container was recreated, or its cgroup removed) drops
+ * the descriptors and the cgroup is resolved again on the next tick.
+ */
+class ContainerStats {
+public:
+    static constexpr std::chrono::milliseconds RESOLVE_TIMEOUT{5000};
+    static constexpr std::chrono::milliseconds RESOLVE_RETRY{10000};
+
+    /**
+     * @brief Constructor
+     * @param count Number of managed commands
+     * @param loop Loop the inspect calls run on
+     * @param events Event log receiving resolution failures
+     */
+    ContainerStats(size_t count, EventLoop& loop, EventLog& events);
+
+    /**
+     * @brief Destructor - closes the cached descriptors
+     */
+    ~ContainerStats();
+
+    ContainerStats(const ContainerStats&) = delete;
+    ContainerStats& operator=(const ContainerStats&) = delete;
+
+    /**
+     * @brief Read the usage of a container (sampler thread)
+     * @param index Command index of a 'D' service
+     * @param cmd The service; its Pid (the `docker start` of the current instance) keys the cache
+     * @param usage Filled on success
+     * @return false while the cgroup is not resolved yet (resolution is started)
+     */
+    bool sample(size_t index, const command& cmd, ContainerUsage& usage);
+
+    /**
+     * @brief Get the resolved cgroup directory of a container ("" if unresolved)
+     * @param index Command index
+     */
+    std::string cgroupPath(size_t index) const;
+
+private:
+    struct Container {
+        pid_t       Generation = -1;  ///< Instance the descriptors belong to
+        bool        Pending = false;  ///< An inspect call is in flight
+        bool        Reported = false; ///< A resolution failure was recorded
+        std::chrono::steady_clock::time_point RetryAt;
+        bool        Unified = false;  ///< cgroup v2 file formats
+        int         CpuFd = -1;
+        int         MemoryFd = -1;
+        int         IoFd = -1;
+        std::string Path;
+    };
+
+    EventLoop&              loop_;
+    EventLog&               events_;
+    std::string             unifiedMount_;  ///< cgroup2 mount point ("" if none)
+    std::map<std::string, std::string> controllerMounts_;  ///< v1 controller -> mount point
+    mutable std::mutex      mutex_;         ///< Guards containers_ and buffer_
+    std::vector<Container>  containers_;
+    std::vector<char>       buffer_;
+
+    Task<void> resolve(size_t index, std::string name, pid_t generation);
+    bool open(Container& container, pid_t pid);
+    void close(Container& container);
+    bool read(int fd, std::string& text);
+};
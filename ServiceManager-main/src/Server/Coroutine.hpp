@@ -0,0 +1,309 @@
+/**
+ * @file Coroutine.hpp
+ * @brief C++20 coroutine task type and event loop awaitables
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "EventLoop.hpp"
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Promise parts shared by Task<T> and Task<void>
+ *
+ * Tasks start suspended and run when awaited; on completion control is
+ * transferred straight back to the awaiting coroutine (symmetric transfer),
+ * so long chains of awaits do not grow the stack.
+ */
+struct TaskPromiseBase {
+    std::coroutine_handle<> Continuation = std::noop_coroutine();
+    std::exception_ptr      Exception;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            return self.promise().Continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { Exception = std::current_exception(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * A Task owns its coroutine frame. It runs when co_awaited and resumes the
+ * awaiting coroutine when it finishes. Top-level tasks are started with
+ * spawn().
+ */
+template <typename T>
+class Task {
+public:
+    struct promise_type : detail::TaskPromiseBase {
+        std::optional<T> Value;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        void return_value(T value) { Value = std::move(value); }
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle_.promise().Continuation = caller;
+        return handle_;
+    }
+    T await_resume() {
+        if (handle_.promise().Exception) {
+            std::rethrow_exception(handle_.promise().Exception);
+        }
+        return std::move(*handle_.promise().Value);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Task without a result
+ */
+template <>
+class Task<void> {
+public:
+    struct promise_type : detail::TaskPromiseBase {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        void return_void() {}
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle_.promise().Continuation = caller;
+        return handle_;
+    }
+    void await_resume() {
+        if (handle_.promise().Exception) {
+            std::rethrow_exception(handle_.promise().Exception);
+        }
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+/**
+ * @brief Fire-and-forget coroutine whose frame frees itself at the end
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+inline DetachedTask runDetached(Task<void> task) {
+    try {
+        co_await task;
+    } catch (const std::exception& e) {
+        std::cerr << "Coroutine failed: " << e.what() << std::endl;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Start a top-level task on the calling thread
+ * @param task Task to run; it runs until its first suspension before spawn() returns
+ *
+ * Call on the event loop thread so that the task and everything it awaits
+ * stays on that thread.
+ */
+inline void spawn(Task<void> task) {
+    detail::runDetached(std::move(task));
+}
+
+/**
+ * @brief Awaitable that resumes after a delay
+ */
+class SleepAwaiter {
+public:
+    SleepAwaiter(EventLoop& loop, std::chrono::milliseconds delay) : loop_(loop), delay_(delay) {}
+
+    bool await_ready() const noexcept { return delay_.count() <= 0; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        loop_.runAfter(delay_, [handle]() { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+
+private:
+    EventLoop&                loop_;
+    std::chrono::milliseconds delay_;
+};
+
+/**
+ * @brief Suspend the current coroutine for a while
+ * @param loop Loop the coroutine runs on
+ * @param delay Time to sleep
+ */
+inline SleepAwaiter sleepFor(EventLoop& loop, std::chrono::milliseconds delay) {
+    return SleepAwaiter(loop, delay);
+}
+
+/**
+ * @brief Awaitable that resumes when a descriptor is ready or a timeout passes
+ *
+ * co_await yields true if the descriptor became ready and false on timeout
+ * (or if it could not be watched).
+ */
+class FdAwaiter {
+public:
+    FdAwaiter(EventLoop& loop, int fd, uint32_t interest, std::chrono::milliseconds timeout)
+        : loop_(loop), fd_(fd), interest_(interest), timeout_(timeout) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        bool watched = loop_.watch(fd_, [this, handle](uint32_t) {
+            if (timer_) {
+                loop_.cancelTimer(timer_);
+            }
+            loop_.unwatch(fd_);
+            ready_ = true;
+            handle.resume();
+        }, interest_);
+        if (!watched) {
+            return false;  // Resume immediately with ready_ == false
+        }
+        if (timeout_.count() >= 0) {
+            timer_ = loop_.runAfter(timeout_, [this, handle]() {
+                timer_ = 0;
+                loop_.unwatch(fd_);
+                handle.resume();
+            });
+        }
+        return true;
+    }
+    bool await_resume() const noexcept { return ready_; }
+
+private:
+    EventLoop&                loop_;
+    int                       fd_;
+    uint32_t                  interest_;
+    std::chrono::milliseconds timeout_;
+    int                       timer_ = 0;
+    bool                      ready_ = false;
+};
+
+/**
+ * @brief Wait for a descriptor to become ready
+ * @param loop Loop the coroutine runs on
+ * @param fd Descriptor to watch (must not be watched elsewhere)
+ * @param interest EVENT_READABLE and/or EVENT_WRITABLE
+ * @param timeout Maximum wait (negative = no limit)
+ */
+inline FdAwaiter waitFd(EventLoop& loop, int fd, uint32_t interest, std::chrono::milliseconds timeout) {
+    return FdAwaiter(loop, fd, interest, timeout);
+}
+
+/**
+ * @brief One-shot broadcast event for coroutines on one loop
+ *
+ * Coroutines awaiting wait() resume when set() is called; awaiting an event
+ * that is already set does not suspend. reset() re-arms it, e.g. for a
+ * coroutine that repeatedly waits for "something changed".
+ */
+class AsyncEvent {
+public:
+    class Awaiter {
+    public:
+        explicit Awaiter(AsyncEvent& event) : event_(event) {}
+        bool await_ready() const noexcept { return event_.set_; }
+        void await_suspend(std::coroutine_handle<> handle) { event_.waiters_.push_back(handle); }
+        void await_resume() const noexcept {}
+
+    private:
+        AsyncEvent& event_;
+    };
+
+    Awaiter wait() { return Awaiter(*this); }
+    bool isSet() const { return set_; }
+
+    /**
+     * @brief Clear the event so that it can be awaited again
+     */
+    void reset() { set_ = false; }
+
+    void set() {
+        set_ = true;
+        std::vector<std::coroutine_handle<>> waiters;
+        waiters.swap(waiters_);
+        for (auto handle : waiters) {
+            handle.resume();
+        }
+    }
+
+private:
+    bool set_ = false;
+    std::vector<std::coroutine_handle<>> waiters_;
+};
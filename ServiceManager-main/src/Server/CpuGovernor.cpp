@@ -0,0 +1,231 @@
+/**
+ * @file CpuGovernor.cpp
+ * @brief Implementation of CPU hog detection and throttling
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "CpuGovernor.hpp"
+#include "ProcessRunner.hpp"
+#include "CgroupManager.hpp"
+#include "EventLog.hpp"
+
+#include <sys/resource.h>   // setpriority, getpriority
+#include <cerrno>           // errno
+#include <filesystem>       // std::filesystem::directory_iterator
+#include <fstream>          // std::ifstream
+#include <sstream>          // std::ostringstream
+
+namespace {
+
+constexpr long CPU_MAX_PERIOD_US = 100000;
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+CpuGovernor::CpuGovernor(ProcessRunner& runner, const CgroupManager& cgroups, EventLog& events,
+                         CpuAction defaultAction)
+    : runner_(runner), cgroups_(cgroups), events_(events) {
+    trackers_.resize(runner_.getCommandCount());
+
+    for (size_t i = 0; i < trackers_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        CpuPolicy& policy = trackers_[i].Policy;
+
+        // Containers are sampled, but their limits belong to dockerd
+        if (cmd.Mode == 'D') {
+            policy.Action = CpuAction::Off;
+            if (!cmd.option("cpu.policy").empty()) {
+                events_.record(static_cast<int>(i), "cpu.config", "@cpu.policy is ignored for Docker services");
+            }
+            continue;
+        }
+        policy.Action = defaultAction;
+        std::string actionName = cmd.option("cpu.policy");
+        if (!actionName.empty() && !parseAction(actionName, policy.Action)) {
+            events_.record(static_cast<int>(i), "cpu.config",
+                           "Unknown cpu.policy '" + actionName + "', detection disabled");
+            policy.Action = CpuAction::Off;
+        }
+        policy.LimitPercent = cmd.optionNumber("cpu.limit", policy.LimitPercent);
+        policy.SustainSec = cmd.optionNumber("cpu.sustain", policy.SustainSec);
+        policy.QuotaPercent = cmd.optionNumber("cpu.quota", policy.QuotaPercent);
+        policy.NiceValue = static_cast<int>(cmd.optionNumber("cpu.nice", policy.NiceValue));
+        policy.ReleasePercent = cmd.optionNumber("cpu.release", policy.LimitPercent / 2);
+        policy.ReleaseAfterSec = cmd.optionNumber("cpu.release_after", policy.SustainSec);
+    }
+}
+
+bool CpuGovernor::parseAction(const std::string& name, CpuAction& action) {
+    if (name == "off") {
+        action = CpuAction::Off;
+    } else if (name == "cpumax") {
+        action = CpuAction::CpuMax;
+    } else if (name == "nice") {
+        action = CpuAction::Nice;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+CpuThrottleState CpuGovernor::state(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= trackers_.size()) {
+        return CpuThrottleState();
+    }
+    return trackers_[index].State;
+}
+
+void CpuGovernor::onSample(const std::vector<ServiceSample>& samples) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < samples.size() && i < trackers_.size(); ++i) {
+        Tracker& tracker = trackers_[i];
+        const ServiceSample& sample = samples[i];
+
+        if (tracker.Policy.Action == CpuAction::Off) {
+            continue;
+        }
+
+        // Service stopped or was replaced: lift limits left on its cgroup
+        if (sample.Pid != tracker.Pid) {
+            if (tracker.State.Throttled) {
+                release(i, tracker, "service restarted or stopped");
+            }
+            tracker.Pid = sample.Pid;
+            tracker.Over = tracker.Under = false;
+        }
+        if (sample.Pid <= 0) {
+            continue;
+        }
+        if (!tracker.State.Throttled) {
+            tracker.ServicePid = sample.ServicePid;
+        }
+
+        double usage = sample.CpuPercent;
+        if (!tracker.State.Throttled) {
+            if (usage < tracker.Policy.LimitPercent) {
+                tracker.Over = false;
+                continue;
+            }
+            if (!tracker.Over) {
+                tracker.Over = true;
+                tracker.OverSince = now;
+            }
+            std::chrono::duration<double> over = now - tracker.OverSince;
+            if (over.count() >= tracker.Policy.SustainSec) {
+                throttle(i, tracker, usage);
+            }
+        } else {
+            if (usage > tracker.Policy.ReleasePercent) {
+                tracker.Under = false;
+                continue;
+            }
+            if (!tracker.Under) {
+                tracker.Under = true;
+                tracker.UnderSince = now;
+            }
+            std::chrono::duration<double> under = now - tracker.UnderSince;
+            if (under.count() >= tracker.Policy.ReleaseAfterSec) {
+                release(i, tracker, "usage normalized");
+            }
+        }
+    }
+}
+
+void CpuGovernor::throttle(size_t index, Tracker& tracker, double usage) {
+    std::ostringstream message;
+    message.precision(1);
+    message << std::fixed << "Sustained CPU usage " << usage << "% over limit "
+            << tracker.Policy.LimitPercent << "% for " << tracker.Policy.SustainSec << "s; ";
+
+    bool applied = false;
+    if (tracker.Policy.Action == CpuAction::CpuMax && cgroups_.available()) {
+        long quotaUs = static_cast<long>(tracker.Policy.QuotaPercent / 100.0 * CPU_MAX_PERIOD_US);
+        if (quotaUs < 1000) {
+            quotaUs = 1000;  // Kernel minimum
+        }
+        if (cgroups_.writeControl(index, "cpu.max",
+                                  std::to_string(quotaUs) + " " + std::to_string(CPU_MAX_PERIOD_US))) {
+            tracker.State.Mechanism = "cpu.max";
+            message << "applied cpu.max quota of " << tracker.Policy.QuotaPercent << "%";
+            applied = true;
+        }
+    }
+    if (!applied && tracker.ServicePid > 0) {
+        tracker.OriginalNice = readNice(tracker.ServicePid);
+        if (renice(tracker.ServicePid, tracker.Policy.NiceValue)) {
+            tracker.State.Mechanism = "nice";
+            message << "reniced to " << tracker.Policy.NiceValue;
+            applied = true;
+        }
+    }
+
+    tracker.Over = false;
+    if (!applied) {
+        events_.record(static_cast<int>(index), "cpu.throttle_failed",
+                       message.str() + "could not apply any throttle");
+        tracker.OverSince = std::chrono::steady_clock::now();  // Retry after another sustain period
+        tracker.Over = true;
+        return;
+    }
+
+    tracker.State.Throttled = true;
+    tracker.State.SinceMs = nowMs();
+    tracker.Under = false;
+    events_.record(static_cast<int>(index), "cpu.throttle", message.str());
+}
+
+void CpuGovernor::release(size_t index, Tracker& tracker, const std::string& reason) {
+    if (tracker.State.Mechanism == "cpu.max") {
+        cgroups_.writeControl(index, "cpu.max", "max " + std::to_string(CPU_MAX_PERIOD_US));
+    } else if (tracker.State.Mechanism == "nice" && tracker.ServicePid > 0) {
+        renice(tracker.ServicePid, tracker.OriginalNice);
+    }
+
+    events_.record(static_cast<int>(index), "cpu.release",
+                   "Removed " + tracker.State.Mechanism + " throttle (" + reason + ")");
+    tracker.State = CpuThrottleState();
+    tracker.Under = false;
+}
+
+bool CpuGovernor::renice(pid_t root, int value) {
+    // Linux nice values are per thread, so every task of the service and of
+    // the processes it forked has to be updated
+    bool any = false;
+    std::vector<pid_t> pending{root};
+    while (!pending.empty()) {
+        std::string process = "/proc/" + std::to_string(pending.back()) + "/task";
+        pending.pop_back();
+        std::error_code ec;
+        std::filesystem::directory_iterator tasks(process, ec);
+        for (; !ec && tasks != std::filesystem::directory_iterator(); tasks.increment(ec)) {
+            try {
+                id_t tid = static_cast<id_t>(std::stoi(tasks->path().filename().string()));
+                if (setpriority(PRIO_PROCESS, tid, value) == 0) {
+                    any = true;
+                }
+            } catch (const std::exception&) {
+                continue;
+            }
+            std::ifstream children(tasks->path() / "children");
+            pid_t child;
+            while (children >> child) {
+                pending.push_back(child);
+            }
+        }
+    }
+    return any;
+}
+
+int CpuGovernor::readNice(pid_t pid) {
+    errno = 0;
+    int value = getpriority(PRIO_PROCESS, static_cast<id_t>(pid));
+    return errno == 0 ? value : 0;
+}
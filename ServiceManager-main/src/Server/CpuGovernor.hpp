@@ -0,0 +1,126 @@
+/**
+ * @file CpuGovernor.hpp
+ * @brief Automatic throttling of services with sustained CPU overuse
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "ResourceSampler.hpp"
+
+class ProcessRunner;
+class CgroupManager;
+class EventLog;
+
+/**
+ * @brief How a CPU hog is throttled
+ */
+enum class CpuAction {
+    Off,     ///< Detection disabled
+    CpuMax,  ///< cgroup v2 cpu.max quota (falls back to Nice without cgroups)
+    Nice     ///< Renice every thread of the service and its descendants
+};
+
+/**
+ * @brief Per-service CPU hog policy
+ *
+ * Read from the service's "@cpu.*" options:
+ * - cpu.policy        off | cpumax | nice
+ * - cpu.limit         usage (percent of one core) considered a hog
+ * - cpu.sustain       seconds above the limit before throttling
+ * - cpu.quota         cpu.max quota applied while throttled (percent of one core)
+ * - cpu.nice          nice value applied while throttled
+ * - cpu.release       usage below which the throttle may be lifted
+ * - cpu.release_after seconds below the release level before lifting
+ */
+struct CpuPolicy {
+    CpuAction Action = CpuAction::Off;
+    double    LimitPercent = 90.0;
+    double    SustainSec = 30.0;
+    double    QuotaPercent = 50.0;
+    int       NiceValue = 19;
+    double    ReleasePercent = 45.0;
+    double    ReleaseAfterSec = 30.0;
+};
+
+/**
+ * @brief Per-service throttle state exposed to the API
+ */
+struct CpuThrottleState {
+    bool        Throttled = false;   ///< Throttle currently applied
+    std::string Mechanism;           ///< "cpu.max" or "nice" while throttled
+    int64_t     SinceMs = 0;         ///< Wall-clock time the throttle was applied
+};
+
+/**
+ * @brief Sampler listener detecting CPU hogs and applying temporary limits
+ *
+ * A service whose usage stays above its limit for the sustain period gets a
+ * cpu.max quota (or a nice adjustment when cgroups are unavailable). Once
+ * usage has stayed below the release level for the release period, or the
+ * service stops, the original settings are restored. Every transition is
+ * recorded in the event log.
+ */
+class CpuGovernor {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param cgroups Cgroup manager used for cpu.max quotas
+     * @param events Event log receiving throttle/release events
+     * @param defaultAction Action for services without a "@cpu.policy" option
+     */
+    CpuGovernor(ProcessRunner& runner, const CgroupManager& cgroups, EventLog& events,
+                CpuAction defaultAction);
+
+    /**
+     * @brief Evaluate one sampler tick (register with ResourceSampler::addListener)
+     * @param samples Latest samples indexed like the commands
+     */
+    void onSample(const std::vector<ServiceSample>& samples);
+
+    /**
+     * @brief Get the throttle state of a service
+     * @param index Index of the command
+     */
+    CpuThrottleState state(size_t index) const;
+
+    /**
+     * @brief Parse a policy action name
+     * @param name "off", "cpumax" or "nice"
+     * @param action Receives the parsed action
+     * @return false if the name is unknown
+     */
+    static bool parseAction(const std::string& name, CpuAction& action);
+
+private:
+    struct Tracker {
+        CpuPolicy Policy;
+        pid_t     Pid = -1;
+        pid_t     ServicePid = -1;
+        bool      Over = false;
+        bool      Under = false;
+        std::chrono::steady_clock::time_point OverSince;
+        std::chrono::steady_clock::time_point UnderSince;
+        int       OriginalNice = 0;
+        CpuThrottleState State;
+    };
+
+    ProcessRunner&        runner_;
+    const CgroupManager&  cgroups_;
+    EventLog&             events_;
+    mutable std::mutex    mutex_;     ///< Guards trackers_ state for API readers
+    std::vector<Tracker>  trackers_;
+
+    void throttle(size_t index, Tracker& tracker, double usage);
+    void release(size_t index, Tracker& tracker, const std::string& reason);
+    static bool renice(pid_t root, int value);
+    static int readNice(pid_t pid);
+};
@@ -0,0 +1,94 @@
+/**
+ * @file EpollEventLoop.cpp
+ * @brief Implementation of the epoll event loop backend
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "EpollEventLoop.hpp"
+
+#include <unistd.h>         // close
+#include <sys/epoll.h>      // epoll_create1, epoll_ctl, epoll_wait
+#include <cerrno>           // errno
+#include <cstdio>           // perror
+
+namespace {
+
+constexpr int MAX_EVENTS = 256;
+
+} // namespace
+
+EpollEventLoop::~EpollEventLoop() {
+    stop();
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+}
+
+bool EpollEventLoop::setup() {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+        perror("EpollEventLoop: epoll_create1 failed");
+        return false;
+    }
+    return true;
+}
+
+bool EpollEventLoop::watch(int fd, IoCallback callback, uint32_t interest) {
+    uint64_t token = nextToken_++;
+    struct epoll_event event = {};
+    event.events = (interest & EVENT_READABLE ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                   (interest & EVENT_WRITABLE ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.u64 = token;
+    ++syscalls_;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        perror("EpollEventLoop::watch: epoll_ctl failed");
+        return false;
+    }
+    watches_[token] = std::make_shared<Watch>(Watch{fd, std::move(callback), interest});
+    tokens_[fd] = token;
+    return true;
+}
+
+void EpollEventLoop::unwatch(int fd) {
+    auto it = tokens_.find(fd);
+    if (it == tokens_.end()) {
+        return;
+    }
+    ++syscalls_;
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    watches_.erase(it->second);
+    tokens_.erase(it);
+}
+
+void EpollEventLoop::wait(int timeoutMs) {
+    struct epoll_event events[MAX_EVENTS];
+    ++syscalls_;
+    int ready = epoll_wait(epollFd_, events, MAX_EVENTS, timeoutMs);
+    if (ready < 0) {
+        if (errno != EINTR) {
+            perror("EpollEventLoop: epoll_wait failed");
+        }
+        return;
+    }
+    for (int i = 0; i < ready; ++i) {
+        // Earlier callbacks in this batch may have unwatched the descriptor
+        auto it = watches_.find(events[i].data.u64);
+        if (it == watches_.end()) {
+            continue;
+        }
+        std::shared_ptr<Watch> watch = it->second;
+        uint32_t flags = 0;
+        if (events[i].events & EPOLLIN) {
+            flags |= EVENT_READABLE;
+        }
+        if (events[i].events & EPOLLOUT) {
+            flags |= EVENT_WRITABLE;
+        }
+        if (events[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) {
+            flags |= EVENT_HANGUP;
+        }
+        ++events_;
+        watch->Callback(flags);
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * @file EpollEventLoop.hpp
+ * @brief epoll backend of the event loop
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "EventLoop.hpp"
+
+/**
+ * @brief Level-triggered epoll event loop
+ *
+ * Each watched descriptor costs one epoll_ctl() to add and one to remove;
+ * a wait returns at most MAX_EVENTS ready descriptors.
+ */
+class EpollEventLoop : public EventLoop {
+public:
+    EpollEventLoop() = default;
+    ~EpollEventLoop() override;
+
+    const char* name() const override { return "epoll"; }
+    bool watch(int fd, IoCallback callback, uint32_t interest = EVENT_READABLE) override;
+    void unwatch(int fd) override;
+
+protected:
+    bool setup() override;
+    void wait(int timeoutMs) override;
+
+private:
+    struct Watch {
+        int        Fd;
+        IoCallback Callback;
+        uint32_t   Interest;
+    };
+
+    int epollFd_ = -1;
+    uint64_t nextToken_ = 1;
+    std::unordered_map<uint64_t, std::shared_ptr<Watch>> watches_;  ///< Token -> watch
+    std::unordered_map<int, uint64_t> tokens_;                      ///< Descriptor -> token
+};
@@ -0,0 +1,51 @@
+/**
+ * @file EventLog.cpp
+ * @brief Implementation of the in-memory service event log
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "EventLog.hpp"
+
+#include <chrono>       // std::chrono::system_clock
+#include <iostream>     // std::cout
+
+EventLog::EventLog(size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity) {
+}
+
+uint64_t EventLog::record(int service, const std::string& kind, const std::string& message) {
+    ServiceEvent event;
+    event.TimestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    event.Service = service;
+    event.Kind = kind;
+    event.Message = message;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        event.Seq = nextSeq_++;
+        events_.push_back(event);
+        if (events_.size() > capacity_) {
+            events_.pop_front();
+        }
+    }
+
+    std::cout << "📣 [" << event.Kind << "]";
+    if (service >= 0) {
+        std::cout << " #" << service;
+    }
+    std::cout << " " << event.Message << std::endl;
+    return event.Seq;
+}
+
+std::vector<ServiceEvent> EventLog::since(uint64_t seq) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ServiceEvent> result;
+    for (const auto& event : events_) {
+        if (event.Seq > seq) {
+            result.push_back(event);
+        }
+    }
+    return result;
+}
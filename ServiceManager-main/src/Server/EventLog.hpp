@@ -0,0 +1,63 @@
+/**
+ * @file EventLog.hpp
+ * @brief In-memory ring buffer of service lifecycle and policy events
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Single recorded event
+ */
+struct ServiceEvent {
+    uint64_t    Seq = 0;          ///< Monotonic sequence number (starts at 1)
+    int64_t     TimestampMs = 0;  ///< Wall-clock time in milliseconds since epoch
+    int         Service = -1;     ///< Command index the event refers to (-1 for global)
+    std::string Kind;             ///< Short machine-readable kind (e.g. "cpu.throttle")
+    std::string Message;          ///< Human-readable description
+};
+
+/**
+ * @brief Thread-safe bounded event log
+ *
+ * Components record notable automatic actions here (throttling, adoption,
+ * restarts, ...) so that operators can see what ServiceMN did on its own.
+ * Every event is also echoed to stdout.
+ */
+class EventLog {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of events kept in memory
+     */
+    explicit EventLog(size_t capacity = 1024);
+
+    /**
+     * @brief Record an event
+     * @param service Command index (-1 for events not tied to a service)
+     * @param kind Machine-readable event kind
+     * @param message Human-readable description
+     * @return Sequence number assigned to the event
+     */
+    uint64_t record(int service, const std::string& kind, const std::string& message);
+
+    /**
+     * @brief Get all retained events with a sequence number greater than seq
+     * @param seq Last sequence number already seen by the caller
+     * @return Events in ascending sequence order
+     */
+    std::vector<ServiceEvent> since(uint64_t seq) const;
+
+private:
+    mutable std::mutex       mutex_;     ///< Guards events_ and nextSeq_
+    std::deque<ServiceEvent> events_;    ///< Retained events, oldest first
+    size_t                   capacity_;  ///< Maximum retained events
+    uint64_t                 nextSeq_ = 1; ///< Sequence number for the next event
+};
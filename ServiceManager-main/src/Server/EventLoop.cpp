@@ -0,0 +1,191 @@
+/**
+ * @file EventLoop.cpp
+ * @brief Implementation of the backend-independent event loop parts
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "EventLoop.hpp"
+#include "EpollEventLoop.hpp"
+#include "UringEventLoop.hpp"
+
+#include <unistd.h>         // read, write, close
+#include <sys/eventfd.h>    // eventfd
+#include <algorithm>        // std::min, std::max
+#include <cstdio>           // perror
+#include <iostream>         // std::cerr
+
+EventLoop::EventLoop() {
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd_ < 0) {
+        perror("EventLoop: eventfd failed");
+    }
+}
+
+EventLoop::~EventLoop() {
+    stop();
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+    }
+}
+
+std::unique_ptr<EventLoop> EventLoop::create(EventBackend backend) {
+    std::unique_ptr<EventLoop> loop;
+    if (backend != EventBackend::Epoll) {
+        loop.reset(new UringEventLoop());
+        if (!loop->setup()) {
+            loop.reset();
+            if (backend == EventBackend::Uring) {
+                std::cerr << "EventLoop: io_uring is not available" << std::endl;
+                return nullptr;
+            }
+        }
+    }
+    if (!loop) {
+        loop.reset(new EpollEventLoop());
+        if (!loop->setup()) {
+            return nullptr;
+        }
+    }
+
+    // Posted tasks wake the loop through the eventfd
+    EventLoop* self = loop.get();
+    if (self->wakeFd_ < 0 || !self->watch(self->wakeFd_, [self](uint32_t) {
+            uint64_t count;
+            while (read(self->wakeFd_, &count, sizeof(count)) > 0) {
+            }
+            self->runTasks();
+        })) {
+        return nullptr;
+    }
+    return loop;
+}
+
+bool EventLoop::parseBackend(const std::string& name, EventBackend& backend) {
+    if (name == "auto") {
+        backend = EventBackend::Auto;
+    } else if (name == "uring" || name == "io_uring") {
+        backend = EventBackend::Uring;
+    } else if (name == "epoll") {
+        backend = EventBackend::Epoll;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int EventLoop::addTimer(std::chrono::milliseconds interval, Task callback) {
+    int id = nextTimerId_++;
+    timers_[id] = Timer{interval, std::chrono::steady_clock::now() + interval, std::move(callback), true};
+    return id;
+}
+
+int EventLoop::runAfter(std::chrono::milliseconds delay, Task callback) {
+    int id = nextTimerId_++;
+    timers_[id] = Timer{delay, std::chrono::steady_clock::now() + delay, std::move(callback), false};
+    return id;
+}
+
+void EventLoop::cancelTimer(int id) {
+    timers_.erase(id);
+}
+
+void EventLoop::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks_.push_back(std::move(task));
+    }
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        perror("EventLoop::post: eventfd write failed");
+    }
+}
+
+void EventLoop::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() {
+        while (running_) {
+            runOnce(-1);
+        }
+        runTasks();  // Tasks posted together with stop()
+    });
+}
+
+void EventLoop::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    post([]() {});
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void EventLoop::runOnce(int timeoutMs) {
+    int untilTimer = runTimers();
+    if (untilTimer >= 0 && (timeoutMs < 0 || untilTimer < timeoutMs)) {
+        timeoutMs = untilTimer;
+    }
+    ++waits_;
+    wait(timeoutMs);
+    runTimers();
+}
+
+EventLoopStats EventLoop::stats() const {
+    EventLoopStats stats;
+    stats.Syscalls = syscalls_;
+    stats.Waits = waits_;
+    stats.Events = events_;
+    stats.Timers = timersFired_;
+    return stats;
+}
+
+void EventLoop::runTasks() {
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks.swap(tasks_);
+    }
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+int EventLoop::runTimers() {
+    if (timers_.empty()) {
+        return -1;
+    }
+    auto now = std::chrono::steady_clock::now();
+    auto next = std::chrono::steady_clock::time_point::max();
+    std::vector<int> due;
+    for (auto& entry : timers_) {
+        if (entry.second.Due <= now) {
+            due.push_back(entry.first);
+        } else {
+            next = std::min(next, entry.second.Due);
+        }
+    }
+    for (int id : due) {
+        // A callback may cancel its own or another timer
+        auto it = timers_.find(id);
+        if (it == timers_.end()) {
+            continue;
+        }
+        Task callback = it->second.Callback;
+        if (it->second.Repeat) {
+            it->second.Due = now + it->second.Interval;
+            next = std::min(next, it->second.Due);
+        } else {
+            timers_.erase(it);
+        }
+        callback();
+        ++timersFired_;
+    }
+    if (timers_.empty()) {
+        return -1;
+    }
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+    return static_cast<int>(std::max<long long>(wait, 0) + 1);
+}
@@ -0,0 +1,189 @@
+/**
+ * @file EventLoop.hpp
+ * @brief Readiness/timer event loop shared by the manager's I/O
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Kernel interface used by an event loop
+ */
+enum class EventBackend {
+    Auto,   ///< io_uring when the kernel allows it, epoll otherwise
+    Uring,  ///< io_uring (fails if unavailable)
+    Epoll   ///< epoll
+};
+
+constexpr uint32_t EVENT_READABLE = 1 << 0;  ///< Data (or EOF) can be read
+constexpr uint32_t EVENT_HANGUP   = 1 << 1;  ///< Peer closed or error pending
+constexpr uint32_t EVENT_WRITABLE = 1 << 2;  ///< Space to write (or a connect() finished)
+
+/**
+ * @brief Counters of an event loop
+ */
+struct EventLoopStats {
+    uint64_t Syscalls = 0;  ///< Kernel entries made by the loop itself (wait/submit/ctl)
+    uint64_t Waits = 0;     ///< Wait calls
+    uint64_t Events = 0;    ///< I/O callbacks dispatched
+    uint64_t Timers = 0;    ///< Timer callbacks fired
+};
+
+/**
+ * @brief Single-threaded event loop
+ *
+ * Watches file descriptors for readiness and runs timers on one
+ * thread. The io_uring backend arms one-shot poll requests and re-arms them
+ * in the submission queue after each callback, so any number of re-arms,
+ * removals and the wait timeout go to the kernel in one io_uring_enter().
+ * The epoll backend is used on kernels without io_uring (or where it is
+ * disabled by policy).
+ *
+ * watch(), unwatch() and the timer functions must be called on the loop
+ * thread or before start(); other threads use post().
+ */
+class EventLoop {
+public:
+    using IoCallback = std::function<void(uint32_t events)>;
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Create a loop for a backend
+     * @param backend Requested backend (Auto falls back to epoll)
+     * @return Loop, or nullptr if the backend cannot be initialised
+     */
+    static std::unique_ptr<EventLoop> create(EventBackend backend);
+
+    /**
+     * @brief Parse a backend name
+     * @param name "auto", "uring" or "epoll"
+     * @param backend Receives the parsed backend
+     * @return false if the name is unknown
+     */
+    static bool parseBackend(const std::string& name, EventBackend& backend);
+
+    virtual ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * @brief Backend name ("io_uring" or "epoll")
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Watch a descriptor
+     * @param fd Descriptor (stays owned by the caller; unwatch before closing)
+     * @param callback Invoked on the loop thread with EVENT_* flags
+     * @param interest EVENT_READABLE and/or EVENT_WRITABLE
+     * @return false if the descriptor could not be watched
+     */
+    virtual bool watch(int fd, IoCallback callback, uint32_t interest = EVENT_READABLE) = 0;
+
+    /**
+     * @brief Stop watching a descriptor
+     * @param fd Descriptor passed to watch()
+     */
+    virtual void unwatch(int fd) = 0;
+
+    /**
+     * @brief Add a repeating timer
+     * @param interval Period between invocations
+     * @param callback Invoked on the loop thread
+     * @return Timer ID for cancelTimer()
+     */
+    int addTimer(std::chrono::milliseconds interval, Task callback);
+
+    /**
+     * @brief Run a callback once after a delay
+     * @param delay Time until the callback runs
+     * @param callback Invoked on the loop thread
+     * @return Timer ID for cancelTimer()
+     */
+    int runAfter(std::chrono::milliseconds delay, Task callback);
+
+    /**
+     * @brief Remove a timer
+     * @param id ID returned by addTimer() or runAfter()
+     */
+    void cancelTimer(int id);
+
+    /**
+     * @brief Run a task on the loop thread (callable from any thread)
+     * @param task Task to run
+     */
+    void post(Task task);
+
+    /**
+     * @brief Start the loop thread
+     */
+    void start();
+
+    /**
+     * @brief Stop the loop thread after running already posted tasks
+     */
+    void stop();
+
+    /**
+     * @brief Wait for events once and dispatch them on the calling thread
+     * @param timeoutMs Upper bound on the wait (-1 = until an event or timer)
+     */
+    void runOnce(int timeoutMs);
+
+    /**
+     * @brief Get loop counters
+     */
+    EventLoopStats stats() const;
+
+protected:
+    EventLoop();
+
+    /**
+     * @brief Initialise the backend
+     * @return false if the backend is unavailable
+     */
+    virtual bool setup() = 0;
+
+    /**
+     * @brief Wait for readiness and invoke I/O callbacks
+     * @param timeoutMs Maximum wait (-1 = infinite)
+     */
+    virtual void wait(int timeoutMs) = 0;
+
+    std::atomic<uint64_t> syscalls_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> events_{0};
+
+private:
+    struct Timer {
+        std::chrono::milliseconds             Interval;
+        std::chrono::steady_clock::time_point Due;
+        Task                                  Callback;
+        bool                                  Repeat;
+    };
+
+    int                  wakeFd_ = -1;  ///< eventfd signalled by post()
+    std::map<int, Timer> timers_;       ///< Loop thread only
+    int                  nextTimerId_ = 1;
+    std::atomic<uint64_t> timersFired_{0};
+    std::vector<Task>    tasks_;        ///< Posted tasks
+    std::mutex           tasksMutex_;   ///< Guards tasks_
+    std::atomic<bool>    running_{false};
+    std::thread          thread_;
+
+    void runTasks();
+    int runTimers();
+};
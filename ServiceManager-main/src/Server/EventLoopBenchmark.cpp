@@ -0,0 +1,126 @@
+/**
+ * @file EventLoopBenchmark.cpp
+ * @brief Implementation of the event loop backend comparison
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "EventLoopBenchmark.hpp"
+#include "EventLoop.hpp"
+
+#include <fcntl.h>          // O_NONBLOCK, O_CLOEXEC
+#include <unistd.h>         // pipe2, read, write, close
+#include <sys/resource.h>   // getrlimit, setrlimit
+#include <chrono>           // std::chrono::steady_clock
+#include <cstdio>           // printf, perror
+#include <iostream>         // std::cout
+#include <vector>
+
+namespace {
+
+constexpr size_t PAYLOAD_BYTES = 64;
+
+struct BenchResult {
+    double         Ms = 0.0;
+    EventLoopStats Stats;
+};
+
+bool runScenario(EventBackend backend, size_t pipes, size_t rounds, bool churn, BenchResult& result) {
+    auto loop = EventLoop::create(backend);
+    if (!loop) {
+        return false;
+    }
+
+    std::vector<int> readEnds;
+    std::vector<int> writeEnds;
+    for (size_t i = 0; i < pipes; ++i) {
+        int fds[2];
+        if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+            perror("runEventLoopBenchmark: pipe2 failed");
+            break;
+        }
+        readEnds.push_back(fds[0]);
+        writeEnds.push_back(fds[1]);
+    }
+
+    size_t received = 0;
+    auto watchAll = [&]() {
+        for (int fd : readEnds) {
+            loop->watch(fd, [fd, &received](uint32_t) {
+                char buffer[PAYLOAD_BYTES * 4];
+                ssize_t n = read(fd, buffer, sizeof(buffer));
+                if (n > 0) {
+                    received += static_cast<size_t>(n);
+                }
+            });
+        }
+    };
+    watchAll();
+
+    char payload[PAYLOAD_BYTES] = {};
+    EventLoopStats before = loop->stats();
+    auto started = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        if (churn) {
+            for (int fd : readEnds) {
+                loop->unwatch(fd);
+            }
+            watchAll();
+        }
+        for (int fd : writeEnds) {
+            if (write(fd, payload, sizeof(payload)) < 0) {
+                perror("runEventLoopBenchmark: write failed");
+            }
+        }
+        size_t expected = (round + 1) * readEnds.size() * PAYLOAD_BYTES;
+        while (received < expected) {
+            loop->runOnce(1000);
+        }
+    }
+    result.Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    EventLoopStats after = loop->stats();
+    result.Stats.Syscalls = after.Syscalls - before.Syscalls;
+    result.Stats.Waits = after.Waits - before.Waits;
+    result.Stats.Events = after.Events - before.Events;
+
+    for (int fd : readEnds) {
+        loop->unwatch(fd);
+        close(fd);
+    }
+    for (int fd : writeEnds) {
+        close(fd);
+    }
+    return true;
+}
+
+} // namespace
+
+int runEventLoopBenchmark(size_t pipes, size_t rounds) {
+    // Two descriptors per pipe
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    std::cout << "📊 Event loop benchmark: " << pipes << " pipes, " << rounds << " rounds" << std::endl;
+    printf("   %-9s %-6s %10s %10s %8s %10s %14s\n",
+           "backend", "mode", "time ms", "syscalls", "waits", "events", "syscalls/event");
+    for (EventBackend backend : {EventBackend::Uring, EventBackend::Epoll}) {
+        const char* name = backend == EventBackend::Uring ? "io_uring" : "epoll";
+        for (bool churn : {false, true}) {
+            BenchResult result;
+            if (!runScenario(backend, pipes, rounds, churn, result)) {
+                printf("   %-9s unavailable\n", name);
+                break;
+            }
+            printf("   %-9s %-6s %10.1f %10llu %8llu %10llu %14.4f\n", name, churn ? "churn" : "drain",
+                   result.Ms,
+                   static_cast<unsigned long long>(result.Stats.Syscalls),
+                   static_cast<unsigned long long>(result.Stats.Waits),
+                   static_cast<unsigned long long>(result.Stats.Events),
+                   result.Stats.Events ? static_cast<double>(result.Stats.Syscalls) / result.Stats.Events : 0.0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+/**
+ * @file EventLoopBenchmark.hpp
+ * @brief Comparison of the event loop backends
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Benchmark every available event loop backend and print the results
+ * @param pipes Number of pipes watched at once (stand-ins for service outputs)
+ * @param rounds Number of times every pipe becomes readable
+ * @return Process exit code
+ *
+ * Two scenarios are measured per backend: "drain" makes every pipe readable
+ * and dispatches until all data has been consumed; "churn" additionally
+ * unwatches and re-watches every pipe each round, as happens when services
+ * restart. Reported system calls are those made by the loop itself
+ * (waits, submissions and registrations), not the reads of the callbacks.
+ */
+int runEventLoopBenchmark(size_t pipes, size_t rounds);
@@ -0,0 +1,260 @@
+/**
+ * @file ExecCache.cpp
+ * @brief Implementation of the config preflight and exec resolution cache
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "ExecCache.hpp"
+#include "EventLoop.hpp"
+#include "ProcessRunner.hpp"
+
+#include <fcntl.h>          // open, O_PATH, fcntl, F_DUPFD_CLOEXEC
+#include <unistd.h>         // faccessat, close, read
+#include <sys/inotify.h>    // inotify_init1, inotify_add_watch
+#include <sys/stat.h>       // fstatat, S_ISREG
+#include <algorithm>        // std::min, std::find
+#include <atomic>           // std::atomic
+#include <cerrno>           // errno
+#include <cstdio>           // perror
+#include <cstdlib>          // getenv
+#include <cstring>          // strerror
+#include <iostream>         // std::cerr
+#include <sstream>          // std::istringstream
+#include <thread>           // std::thread
+
+namespace {
+
+constexpr uint32_t DIR_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB |
+                                IN_DELETE_SELF | IN_MOVE_SELF;
+constexpr size_t INOTIFY_BUFFER = 4096;
+
+/**
+ * @brief Check that a path names an executable regular file
+ * @param dir Directory descriptor relative paths resolve against (AT_FDCWD for the cwd)
+ * @return 0, or the errno execve() would fail with
+ */
+int checkExecutable(int dir, const std::string& path) {
+    struct stat st;
+    if (fstatat(dir, path.c_str(), &st, 0) != 0) {
+        return errno;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        return EACCES;
+    }
+    return faccessat(dir, path.c_str(), X_OK, AT_EACCESS) == 0 ? 0 : errno;
+}
+
+std::string directoryOf(const std::string& path) {
+    auto slash = path.rfind('/');
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+} // namespace
+
+ExecCache::ExecCache(const std::vector<command>& commands)
+    : commands_(commands), entries_(commands.size()) {
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        perror("ExecCache: inotify_init1 failed, entries are never invalidated");
+    }
+}
+
+ExecCache::~ExecCache() {
+    for (Entry& entry : entries_) {
+        if (entry.FolderFd >= 0) {
+            close(entry.FolderFd);
+        }
+    }
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+}
+
+std::vector<PreflightProblem> ExecCache::preflight() {
+    // Resolution is mostly waiting on stat() and open(), so it runs in parallel
+    std::vector<Entry> resolved(commands_.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < resolved.size(); i = next++) {
+            resolve(commands_[i], resolved[i]);
+        }
+    };
+    size_t count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), resolved.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < count; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    std::vector<PreflightProblem> problems;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < resolved.size(); ++i) {
+        if (!resolved[i].Error.empty()) {
+            problems.push_back({i, resolved[i].Error});
+        }
+        install(i, std::move(resolved[i]));
+    }
+    return problems;
+}
+
+void ExecCache::watch(EventLoop& loop) {
+    if (inotifyFd_ < 0) {
+        return;
+    }
+    loop.post([this, &loop]() {
+        if (!loop.watch(inotifyFd_, [this](uint32_t) { onInotify(); })) {
+            std::cerr << "ExecCache: cannot watch the inotify descriptor" << std::endl;
+        }
+    });
+}
+
+bool ExecCache::lookup(size_t index, const command& cmd, ExecTarget& target, std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= entries_.size()) {
+        error = "Invalid index";
+        return false;
+    }
+    Entry& cached = entries_[index];
+    if (!cached.Valid || cached.CmdPath != cmd.Path || cached.Folder != cmd.Folder) {
+        Entry entry;
+        resolve(cmd, entry);
+        install(index, std::move(entry));
+    }
+    Entry& entry = entries_[index];
+    if (!entry.Valid) {
+        error = entry.Error;
+        return false;
+    }
+    target.Path = entry.Path;
+    // A duplicate, so an invalidation closing the cached one cannot pull it from under the child
+    target.FolderFd = entry.FolderFd >= 0 ? fcntl(entry.FolderFd, F_DUPFD_CLOEXEC, 0) : -1;
+    return true;
+}
+
+void ExecCache::resolve(const command& cmd, Entry& entry) {
+    entry.CmdPath = cmd.Path;
+    entry.Folder = cmd.Folder;
+
+    auto parts = ProcessRunner::splitCommand(cmd.Path);
+    std::string name = cmd.native() ? (parts.empty() ? "" : parts[0]) : "docker";
+    if (name.empty()) {
+        entry.Error = "Empty command";
+        return;
+    }
+
+    int dir = AT_FDCWD;
+    if (cmd.native() && !cmd.Folder.empty() && cmd.Folder != ".") {
+        entry.FolderFd = open(cmd.Folder.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+        if (entry.FolderFd < 0) {
+            entry.Error = "Working directory " + cmd.Folder + ": " + strerror(errno);
+            return;
+        }
+        dir = entry.FolderFd;
+        entry.WatchDirs.push_back(cmd.Folder);
+    }
+
+    // A name with a slash is used as is, relative to the working directory
+    if (name.find('/') != std::string::npos) {
+        int error = checkExecutable(dir, name);
+        if (error != 0) {
+            entry.Error = name + ": " + strerror(error);
+            return;
+        }
+        entry.Path = name;
+        bool inFolder = name[0] != '/' && dir != AT_FDCWD;
+        entry.WatchDirs.push_back(directoryOf(inFolder ? cmd.Folder + "/" + name : name));
+        entry.Valid = true;
+        return;
+    }
+
+    // Otherwise search PATH in order, as execvp() does
+    const char* path = getenv("PATH");
+    std::istringstream dirs(path && *path ? path : "/usr/local/bin:/usr/bin:/bin");
+    std::string candidate;
+    int firstError = ENOENT;
+    while (std::getline(dirs, candidate, ':')) {
+        // An empty entry means the working directory
+        if (!candidate.empty() && candidate[0] == '/') {
+            entry.WatchDirs.push_back(candidate);
+        }
+        std::string file = (candidate.empty() ? std::string(".") : candidate) + "/" + name;
+        int error = checkExecutable(dir, file);
+        if (error == 0) {
+            entry.Path = file;
+            entry.Valid = true;
+            return;
+        }
+        if (error != ENOENT && error != ENOTDIR && firstError == ENOENT) {
+            firstError = error;  // execvp() also reports a permission problem over "not found"
+        }
+    }
+    entry.Error = firstError == ENOENT ? name + ": not found in PATH"
+                                       : name + ": " + strerror(firstError);
+}
+
+void ExecCache::install(size_t index, Entry&& entry) {
+    // mutex_ is held by the caller
+    Entry& slot = entries_[index];
+    if (slot.FolderFd >= 0) {
+        close(slot.FolderFd);
+    }
+    if (!entry.Valid && entry.FolderFd >= 0) {
+        close(entry.FolderFd);
+        entry.FolderFd = -1;
+    }
+    if (entry.Valid && inotifyFd_ >= 0) {
+        for (const std::string& dir : entry.WatchDirs) {
+            int wd = inotify_add_watch(inotifyFd_, dir.c_str(), DIR_EVENTS | IN_ONLYDIR);
+            if (wd < 0) {
+                continue;  // Unwatchable: the entry is still used, but never invalidated by this dir
+            }
+            std::vector<size_t>& services = watchers_[wd];
+            if (std::find(services.begin(), services.end(), index) == services.end()) {
+                services.push_back(index);
+            }
+        }
+    }
+    slot = std::move(entry);
+}
+
+void ExecCache::invalidate(int wd) {
+    auto it = watchers_.find(wd);
+    if (it == watchers_.end()) {
+        return;
+    }
+    for (size_t index : it->second) {
+        Entry& entry = entries_[index];
+        if (entry.Valid) {
+            entry.Valid = false;
+            if (entry.FolderFd >= 0) {
+                close(entry.FolderFd);
+                entry.FolderFd = -1;
+            }
+        }
+    }
+    // Re-resolution registers the services again
+    it->second.clear();
+}
+
+void ExecCache::onInotify() {
+    alignas(inotify_event) char buffer[INOTIFY_BUFFER];
+    for (;;) {
+        ssize_t length = read(inotifyFd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return;  // EAGAIN: drained
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            invalidate(event->wd);
+            if (event->mask & IN_IGNORED) {
+                watchers_.erase(event->wd);
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file ExecCache.hpp
+ * @brief Config preflight and cached executable/working directory resolution
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "command.hpp"
+
+class EventLoop;
+
+/**
+ * @brief What a native service's child needs to exec without searching
+ */
+struct ExecTarget {
+    std::string Path;          ///< Executable for execve() (relative paths are relative to the folder)
+    int         FolderFd = -1; ///< O_PATH descriptor of the working directory for fchdir() (-1 = stay)
+};
+
+/**
+ * @brief A configuration problem found by the preflight
+ */
+struct PreflightProblem {
+    size_t      Service = 0;
+    std::string Message;
+};
+
+/**
+ * @brief Resolves executables and working directories once instead of in every child
+ *
+ * execvp() walks PATH in the forked child on every start, and a missing
+ * binary or folder only shows up there, one failed start at a time. The
+ * preflight resolves all services in parallel when the configuration is
+ * loaded: the executable to a path (searching PATH like execvp() would) and
+ * the Folder to an O_PATH descriptor, reporting every problem at once.
+ * ProcessRunner then fails bad starts before forking, and the child only
+ * calls fchdir() and execve().
+ *
+ * Entries stay valid until inotify reports a change in a directory they
+ * depend on: every PATH directory up to the match (a new binary there would
+ * shadow it), the binary's own directory, and the folder itself. An
+ * invalidated entry is resolved again by the next launch. Failures are
+ * never cached.
+ */
+class ExecCache {
+public:
+    /**
+     * @brief Constructor
+     * @param commands Commands to resolve (the reference must outlive the cache)
+     */
+    explicit ExecCache(const std::vector<command>& commands);
+
+    /**
+     * @brief Destructor - closes the folder descriptors and the inotify instance
+     */
+    ~ExecCache();
+
+    ExecCache(const ExecCache&) = delete;
+    ExecCache& operator=(const ExecCache&) = delete;
+
+    /**
+     * @brief Resolve every service in parallel and cache the results
+     * @return All problems found, ordered by service
+     */
+    std::vector<PreflightProblem> preflight();
+
+    /**
+     * @brief Invalidate entries on inotify events from now on
+     * @param loop Loop reading the inotify descriptor
+     */
+    void watch(EventLoop& loop);
+
+    /**
+     * @brief Get the exec target of a native service, resolving it again if invalidated
+     * @param index Command index
+     * @param cmd Current command
+     * @param target Filled on success; the caller owns and must close target.FolderFd
+     * @param error Why the service cannot be started, on failure
+     */
+    bool lookup(size_t index, const command& cmd, ExecTarget& target, std::string& error);
+
+private:
+    struct Entry {
+        bool                     Valid = false;
+        std::string              CmdPath;     ///< command::Path the entry was resolved for
+        std::string              Folder;      ///< command::Folder the entry was resolved for
+        std::string              Path;
+        int                      FolderFd = -1;
+        std::vector<std::string> WatchDirs;   ///< Directories whose changes invalidate the entry
+        std::string              Error;
+    };
+
+    const std::vector<command>& commands_;
+    int                         inotifyFd_ = -1;
+    std::mutex                  mutex_;       ///< Guards everything below
+    std::vector<Entry>          entries_;
+    std::unordered_map<int, std::vector<size_t>> watchers_;  ///< inotify wd -> services
+
+    static void resolve(const command& cmd, Entry& entry);
+    void install(size_t index, Entry&& entry);
+    void invalidate(int wd);
+    void onInotify();
+};
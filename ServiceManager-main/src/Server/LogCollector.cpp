@@ -0,0 +1,434 @@
+/**
+ * @file LogCollector.cpp
+ * @brief Implementation of service output capture
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "LogCollector.hpp"
+#include "EventLog.hpp"
+#include "EventLoop.hpp"
+#include "LogStore.hpp"
+#include "ProcessRunner.hpp"
+
+#include <fcntl.h>          // fcntl, F_SETPIPE_SZ, splice
+#include <unistd.h>         // read, close
+#include <sys/ioctl.h>      // ioctl, FIONREAD
+#include <algorithm>        // std::min, std::max
+#include <chrono>           // std::chrono::milliseconds
+#include <cerrno>           // errno
+#include <cstdio>           // perror
+#include <cstring>          // memchr
+#include <iostream>         // std::cerr
+
+namespace {
+
+constexpr int PIPE_CAPACITY = 1 << 20;     // Fewer wakeups for chatty services
+constexpr size_t BUFFERED_CHUNK = 65536;
+constexpr int MARKER_INTERVAL_MS = 1000;   // At most one suppression marker per second
+constexpr double MIN_BYTE_BURST = 4096.0;  // Room for at least one ordinary line
+
+/**
+ * @brief Format a count with thousands separators ("12,345")
+ */
+std::string withSeparators(uint64_t value) {
+    std::string digits = std::to_string(value);
+    std::string result;
+    result.reserve(digits.size() + digits.size() / 3);
+    for (size_t i = 0; i < digits.size(); ++i) {
+        if (i > 0 && (digits.size() - i) % 3 == 0) {
+            result += ',';
+        }
+        result += digits[i];
+    }
+    return result;
+}
+
+} // namespace
+
+void LogCollector::TokenBucket::refill(int64_t nowUs) {
+    if (LastUs != 0 && nowUs > LastUs) {
+        Tokens = std::min(Capacity, Tokens + static_cast<double>(nowUs - LastUs) * Rate / 1e6);
+    }
+    LastUs = nowUs;
+}
+
+LogCollector::LogCollector(ProcessRunner& runner, LogStore& store, EventLog& events,
+                           EventLoop& loop, LogMode defaultMode, const LogBudget& defaultBudget)
+    : runner_(runner), store_(store), events_(events), loop_(loop) {
+    size_t count = runner_.getCommandCount();
+    counters_.reset(new Counters[count]);
+    limiters_.reset(new Limiter[count]);
+    modes_.resize(count, LogMode::Off);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!store_.enabled()) {
+            continue;
+        }
+        command cmd = runner_.getCommand(i);
+        LogMode mode = defaultMode;
+        std::string modeName = cmd.option("log");
+        if (!modeName.empty() && !parseMode(modeName, mode)) {
+            std::cerr << "LogCollector: unknown log mode '" << modeName << "' for command "
+                      << i << ", capture disabled" << std::endl;
+            mode = LogMode::Off;
+        }
+
+        LogBudget budget = defaultBudget;
+        budget.BytesPerSec = cmd.optionNumber("log.bytes_per_sec", budget.BytesPerSec);
+        budget.LinesPerSec = cmd.optionNumber("log.lines_per_sec", budget.LinesPerSec);
+        budget.BurstSec = cmd.optionNumber("log.burst", budget.BurstSec);
+        Limiter& limiter = limiters_[i];
+        limiter.Bytes.Rate = budget.BytesPerSec;
+        limiter.Bytes.Capacity = std::max(budget.BytesPerSec * budget.BurstSec, MIN_BYTE_BURST);
+        limiter.Bytes.Tokens = limiter.Bytes.Capacity;
+        limiter.Lines.Rate = budget.LinesPerSec;
+        limiter.Lines.Capacity = std::max(budget.LinesPerSec * budget.BurstSec, 1.0);
+        limiter.Lines.Tokens = limiter.Lines.Capacity;
+        if (mode == LogMode::Splice && limiter.Lines.limited()) {
+            mode = LogMode::Buffered;  // Lines can only be counted in user space
+        }
+        modes_[i] = mode;
+    }
+
+    nullFd_ = open("/dev/null", O_WRONLY | O_CLOEXEC);
+}
+
+LogCollector::~LogCollector() {
+    for (auto& source : sources_) {
+        close(source.first);
+    }
+    if (nullFd_ >= 0) {
+        close(nullFd_);
+    }
+}
+
+bool LogCollector::parseMode(const std::string& name, LogMode& mode) {
+    if (name == "off") {
+        mode = LogMode::Off;
+    } else if (name == "splice") {
+        mode = LogMode::Splice;
+    } else if (name == "buffered") {
+        mode = LogMode::Buffered;
+    } else if (name == "indexed") {
+        mode = LogMode::Indexed;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LogCollector::start() {
+    loop_.post([this]() {
+        loop_.addTimer(std::chrono::milliseconds(MARKER_INTERVAL_MS), [this]() { flushMarkers(false); });
+    });
+}
+
+void LogCollector::stop() {
+    loop_.post([this]() { flushMarkers(true); });
+}
+
+bool LogCollector::captures(size_t index) const {
+    return index < modes_.size() && modes_[index] != LogMode::Off;
+}
+
+void LogCollector::attach(size_t index, int stdoutFd, int stderrFd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto pair : {std::make_pair(stdoutFd, LOG_STDOUT), std::make_pair(stderrFd, LOG_STDERR)}) {
+        int fd = pair.first;
+        fcntl(fd, F_SETPIPE_SZ, PIPE_CAPACITY);
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        Source source{index, pair.second};
+        sources_[fd] = source;
+        loop_.post([this, fd, source]() {
+            bool watched = loop_.watch(fd, [this, fd, source](uint32_t events) {
+                drain(fd, source, (events & EVENT_HANGUP) != 0);
+            });
+            if (!watched) {
+                detach(fd);
+            }
+        });
+    }
+}
+
+LogCaptureStats LogCollector::stats(size_t index) const {
+    LogCaptureStats stats;
+    if (index < modes_.size()) {
+        stats.Bytes = counters_[index].Bytes;
+        stats.Chunks = counters_[index].Chunks;
+        stats.SplicedBytes = counters_[index].SplicedBytes;
+        stats.DroppedBytes = counters_[index].DroppedBytes;
+        stats.DroppedLines = counters_[index].DroppedLines;
+        stats.Markers = counters_[index].Markers;
+        stats.Suppressing = counters_[index].Suppressing;
+    }
+    return stats;
+}
+
+void LogCollector::drain(int fd, const Source& source, bool hangup) {
+    Counters& counters = counters_[source.Service];
+    Limiter& limiter = limiters_[source.Service];
+    LogMode mode = modes_[source.Service];
+
+    // Loop so that a writer that hung up is drained completely before close
+    for (;;) {
+        int available = 0;
+        if (ioctl(fd, FIONREAD, &available) != 0 || available <= 0) {
+            break;
+        }
+        int64_t now = LogStore::nowUs();
+        limiter.Bytes.refill(now);
+        limiter.Lines.refill(now);
+
+        bool ok = false;
+        size_t stored = 0;
+        if (mode == LogMode::Splice) {
+            size_t allowed = static_cast<size_t>(available);
+            if (limiter.Bytes.limited()) {
+                allowed = std::min(allowed, static_cast<size_t>(limiter.Bytes.Tokens));
+            }
+            if (allowed == static_cast<size_t>(available)) {
+                resume(source.Service, now, false);
+            }
+            ok = true;
+            if (allowed > 0) {
+                stored = store_.appendSplice(source.Service, fd, source.Stream, allowed);
+                counters.SplicedBytes += stored;
+                limiter.Bytes.Tokens -= static_cast<double>(stored);
+                ok = stored > 0;
+            }
+            if (ok && allowed < static_cast<size_t>(available)) {
+                discard(fd, static_cast<size_t>(available) - allowed);
+                drop(source.Service, static_cast<size_t>(available) - allowed, 0);
+            }
+        } else {
+            char buffer[BUFFERED_CHUNK];
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                size_t begin = 0;
+                size_t end = 0;
+                uint64_t droppedLines = admit(limiter, buffer, static_cast<size_t>(n), begin, end);
+                size_t droppedBytes = static_cast<size_t>(n) - (end - begin);
+                if (droppedBytes == 0) {
+                    resume(source.Service, now, false);
+                }
+                if (mode == LogMode::Indexed) {
+                    ok = drainLines(fd, source, buffer + begin, end - begin, stored);
+                    if (ok && droppedBytes > 0) {
+                        flushPartial(fd, source);  // Its continuation was dropped
+                    }
+                } else {
+                    ok = end == begin ||
+                         store_.appendData(source.Service, source.Stream, buffer + begin, end - begin);
+                    stored = ok ? end - begin : 0;
+                }
+                if (droppedBytes > 0) {
+                    drop(source.Service, droppedBytes, droppedLines);
+                }
+            }
+        }
+        if (!ok) {
+            // Store failure (e.g. disk full): discard so the pipe cannot wedge the loop
+            char sink[BUFFERED_CHUNK];
+            while (read(fd, sink, sizeof(sink)) > 0) {
+            }
+            break;
+        }
+        if (stored > 0) {
+            counters.Bytes += stored;
+            ++counters.Chunks;
+        }
+
+        if (!hangup) {
+            break;  // Let other pipes take their turn; the loop reports us again
+        }
+    }
+
+    if (hangup) {
+        // The last line of a service may lack its newline
+        flushPartial(fd, source);
+        partial_.erase(fd);
+        if (limiter.PendingBytes > 0) {
+            writeMarker(source.Service);
+        }
+        detach(fd);
+    }
+}
+
+bool LogCollector::drainLines(int fd, const Source& source, const char* data, size_t length,
+                              size_t& stored) {
+    std::string& pending = partial_[fd];
+    pending.append(data, length);
+
+    // Store complete lines only; an overlong line is cut so memory stays bounded
+    size_t end = pending.rfind('\n');
+    size_t complete = end == std::string::npos ? 0 : end + 1;
+    if (complete == 0 && pending.size() >= BUFFERED_CHUNK) {
+        complete = pending.size();
+    }
+    stored = 0;
+    if (complete > 0) {
+        if (!store_.appendLines(source.Service, source.Stream, pending.data(), complete)) {
+            pending.clear();
+            return false;
+        }
+        pending.erase(0, complete);
+        stored = complete;
+    }
+    return true;
+}
+
+void LogCollector::flushPartial(int fd, const Source& source) {
+    auto it = partial_.find(fd);
+    if (it == partial_.end() || it->second.empty()) {
+        return;
+    }
+    if (store_.appendLines(source.Service, source.Stream, it->second.data(), it->second.size())) {
+        counters_[source.Service].Bytes += it->second.size();
+        ++counters_[source.Service].Chunks;
+    }
+    it->second.clear();
+}
+
+uint64_t LogCollector::admit(Limiter& limiter, const char* data, size_t length,
+                             size_t& begin, size_t& end) {
+    begin = 0;
+    end = length;
+    if (!limiter.Bytes.limited() && !limiter.Lines.limited()) {
+        return 0;
+    }
+    // Common case: the whole read fits the byte budget
+    if (!limiter.Lines.limited() && !limiter.InDroppedLine &&
+        limiter.Bytes.Tokens >= static_cast<double>(length)) {
+        limiter.Bytes.Tokens -= static_cast<double>(length);
+        return 0;
+    }
+
+    uint64_t droppedLines = 0;
+    if (limiter.InDroppedLine) {
+        // Drop the rest of a line whose beginning was already dropped
+        const char* newline = static_cast<const char*>(memchr(data, '\n', length));
+        if (!newline) {
+            end = 0;
+            return 0;
+        }
+        begin = static_cast<size_t>(newline - data) + 1;
+        droppedLines = 1;
+        limiter.InDroppedLine = false;
+    }
+
+    // Admit whole lines while both buckets have tokens
+    size_t pos = begin;
+    while (pos < length) {
+        const char* newline = static_cast<const char*>(memchr(data + pos, '\n', length - pos));
+        size_t next = newline ? static_cast<size_t>(newline - data) + 1 : length;
+        double bytes = static_cast<double>(next - pos);
+        double lines = newline ? 1.0 : 0.0;
+        if ((limiter.Bytes.limited() && limiter.Bytes.Tokens < bytes) ||
+            (limiter.Lines.limited() && limiter.Lines.Tokens < lines)) {
+            break;
+        }
+        limiter.Bytes.Tokens -= limiter.Bytes.limited() ? bytes : 0.0;
+        limiter.Lines.Tokens -= limiter.Lines.limited() ? lines : 0.0;
+        pos = next;
+    }
+    end = pos;
+
+    if (pos < length) {
+        for (const char* p = data + pos;
+             (p = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(data + length - p))));
+             ++p) {
+            ++droppedLines;
+        }
+        limiter.InDroppedLine = data[length - 1] != '\n';
+    }
+    return droppedLines;
+}
+
+void LogCollector::drop(size_t service, uint64_t bytes, uint64_t lines) {
+    Counters& counters = counters_[service];
+    Limiter& limiter = limiters_[service];
+    int64_t now = LogStore::nowUs();
+    counters.DroppedBytes += bytes;
+    counters.DroppedLines += lines;
+    if (limiter.PendingBytes == 0) {
+        limiter.WindowStartUs = now;
+    }
+    limiter.PendingBytes += bytes;
+    limiter.PendingLines += lines;
+    limiter.LastDropUs = now;
+
+    if (!counters.Suppressing.exchange(true)) {
+        ++suppressing_;
+        events_.record(static_cast<int>(service), "log.suppress",
+                       "output exceeds the log budget, dropping excess");
+    }
+}
+
+void LogCollector::resume(size_t service, int64_t nowUs, bool force) {
+    // A bucket that just refilled admits a little between drops; only a
+    // full interval without drops ends the episode
+    if (!counters_[service].Suppressing ||
+        (!force && nowUs - limiters_[service].LastDropUs < MARKER_INTERVAL_MS * 1000LL)) {
+        return;
+    }
+    if (limiters_[service].PendingBytes > 0) {
+        writeMarker(service);
+    }
+    counters_[service].Suppressing = false;
+    --suppressing_;
+    events_.record(static_cast<int>(service), "log.resume", "output back within the log budget");
+}
+
+void LogCollector::discard(int fd, size_t length) {
+    while (length > 0) {
+        ssize_t n = nullFd_ >= 0 ? splice(fd, nullptr, nullFd_, nullptr, length, SPLICE_F_NONBLOCK) : -1;
+        if (n <= 0) {
+            char buffer[BUFFERED_CHUNK];
+            n = read(fd, buffer, std::min(length, sizeof(buffer)));
+            if (n <= 0) {
+                return;
+            }
+        }
+        length -= static_cast<size_t>(n);
+    }
+}
+
+void LogCollector::writeMarker(size_t service) {
+    Limiter& limiter = limiters_[service];
+    std::string text = "... ";
+    if (limiter.PendingLines > 0) {
+        text += withSeparators(limiter.PendingLines) + " lines suppressed (" +
+                withSeparators(limiter.PendingBytes) + " bytes)\n";
+    } else {
+        text += withSeparators(limiter.PendingBytes) + " bytes suppressed\n";
+    }
+    if (store_.appendData(service, LOG_MARKER, text.data(), text.size())) {
+        ++counters_[service].Markers;
+    }
+    limiter.PendingBytes = 0;
+    limiter.PendingLines = 0;
+    limiter.WindowStartUs = LogStore::nowUs();
+}
+
+void LogCollector::flushMarkers(bool force) {
+    if (suppressing_ == 0) {
+        return;
+    }
+    int64_t now = LogStore::nowUs();
+    for (size_t i = 0; i < modes_.size(); ++i) {
+        const Limiter& limiter = limiters_[i];
+        if (limiter.PendingBytes > 0 && now - limiter.WindowStartUs >= MARKER_INTERVAL_MS * 1000LL) {
+            writeMarker(i);
+        }
+        resume(i, now, force);
+    }
+}
+
+void LogCollector::detach(int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    loop_.unwatch(fd);
+    sources_.erase(fd);
+    close(fd);
+}
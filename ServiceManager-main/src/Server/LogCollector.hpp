@@ -0,0 +1,200 @@
+/**
+ * @file LogCollector.hpp
+ * @brief Capture of service stdout/stderr pipes into the log store
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ProcessRunner;
+class LogStore;
+class EventLog;
+class EventLoop;
+
+/**
+ * @brief How a service's output reaches the log store
+ */
+enum class LogMode {
+    Off,       ///< Output is inherited from ServiceMN (not captured)
+    Splice,    ///< Zero-copy: pipe pages are spliced into the segment file
+    Buffered,  ///< Read into user space (needed when the payload is inspected)
+    Indexed    ///< Buffered, line-aligned frames plus a per-segment line index
+};
+
+/**
+ * @brief Per-service ingestion budget
+ *
+ * Read from the service's "@log.*" options (0 = unlimited):
+ * - log.bytes_per_sec  sustained output bytes per second
+ * - log.lines_per_sec  sustained output lines per second
+ * - log.burst          seconds of budget that may be spent at once
+ */
+struct LogBudget {
+    double BytesPerSec = 0.0;
+    double LinesPerSec = 0.0;
+    double BurstSec = 2.0;
+};
+
+/**
+ * @brief Capture counters of one service
+ */
+struct LogCaptureStats {
+    uint64_t Bytes = 0;         ///< Payload bytes stored
+    uint64_t Chunks = 0;        ///< Frames written
+    uint64_t SplicedBytes = 0;  ///< Bytes that never passed through user space
+    uint64_t DroppedBytes = 0;  ///< Bytes discarded by the rate limit
+    uint64_t DroppedLines = 0;  ///< Complete lines discarded by the rate limit
+    uint64_t Markers = 0;       ///< Suppression markers written
+    bool     Suppressing = false; ///< Output is currently being dropped
+};
+
+/**
+ * @brief Drains service output pipes on the manager's event loop
+ *
+ * ProcessRunner creates a pipe pair per captured service and hands the read
+ * ends over with attach(). The collector watches all pipes on the event loop and,
+ * for every readable pipe, frames whatever is buffered as a single chunk:
+ * FIONREAD gives the chunk size, the frame header carries the timestamp and
+ * splice() moves the payload into the segment. No per-line work is done on
+ * the splice path. Indexed services are read into user space instead so that
+ * frames can be cut at line boundaries and every line start indexed.
+ *
+ * Each service's output is admitted through token buckets for bytes and
+ * lines per second. Output beyond the budget is discarded straight from the
+ * pipe (spliced into /dev/null where possible) and summarised by a marker
+ * frame such as "... 12,345 lines suppressed", written at most once per
+ * second while suppression lasts and when it ends (a second without drops). A
+ * lines budget needs the payload, so it reads splice services buffered.
+ */
+class LogCollector {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands ("@log" options)
+     * @param store Destination store
+     * @param events Event log receiving suppression events
+     * @param loop Event loop the pipes are watched on
+     * @param defaultMode Mode for services without a "@log" option
+     * @param defaultBudget Budget for services without "@log.*" rate options
+     */
+    LogCollector(ProcessRunner& runner, LogStore& store, EventLog& events, EventLoop& loop,
+                 LogMode defaultMode, const LogBudget& defaultBudget);
+
+    /**
+     * @brief Destructor - closes remaining pipes (the loop must be stopped)
+     */
+    ~LogCollector();
+
+    LogCollector(const LogCollector&) = delete;
+    LogCollector& operator=(const LogCollector&) = delete;
+
+    /**
+     * @brief Start the suppression marker timer
+     */
+    void start();
+
+    /**
+     * @brief Write outstanding suppression markers before the loop stops
+     */
+    void stop();
+
+    /**
+     * @brief Check whether a service's output should be captured
+     * @param index Index of the command
+     */
+    bool captures(size_t index) const;
+
+    /**
+     * @brief Hand over the read ends of a freshly spawned service's pipes
+     * @param index Index of the command
+     * @param stdoutFd Read end of the stdout pipe (ownership transferred)
+     * @param stderrFd Read end of the stderr pipe (ownership transferred)
+     */
+    void attach(size_t index, int stdoutFd, int stderrFd);
+
+    /**
+     * @brief Get capture counters of a service
+     * @param index Index of the command
+     */
+    LogCaptureStats stats(size_t index) const;
+
+    /**
+     * @brief Parse a log mode name
+     * @param name "off", "splice", "buffered" or "indexed"
+     * @param mode Receives the parsed mode
+     * @return false if the name is unknown
+     */
+    static bool parseMode(const std::string& name, LogMode& mode);
+
+private:
+    struct Source {
+        size_t  Service = 0;
+        uint8_t Stream = 0;
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> Bytes{0};
+        std::atomic<uint64_t> Chunks{0};
+        std::atomic<uint64_t> SplicedBytes{0};
+        std::atomic<uint64_t> DroppedBytes{0};
+        std::atomic<uint64_t> DroppedLines{0};
+        std::atomic<uint64_t> Markers{0};
+        std::atomic<bool>     Suppressing{false};
+    };
+
+    struct TokenBucket {
+        double  Rate = 0.0;      ///< Tokens per second (0 = unlimited)
+        double  Capacity = 0.0;  ///< Burst size
+        double  Tokens = 0.0;
+        int64_t LastUs = 0;      ///< Time of the last refill
+
+        bool limited() const { return Rate > 0.0; }
+        void refill(int64_t nowUs);
+    };
+
+    /**
+     * @brief Rate limit state of one service (loop thread only)
+     */
+    struct Limiter {
+        TokenBucket Bytes;
+        TokenBucket Lines;
+        uint64_t    PendingBytes = 0;    ///< Dropped since the last marker
+        uint64_t    PendingLines = 0;
+        int64_t     WindowStartUs = 0;   ///< Start of the current marker interval
+        int64_t     LastDropUs = 0;      ///< Time output was last dropped
+        bool        InDroppedLine = false; ///< Last dropped byte was not a newline
+    };
+
+    ProcessRunner&       runner_;
+    LogStore&            store_;
+    EventLog&            events_;
+    std::vector<LogMode> modes_;        ///< Per-service capture mode
+    std::unique_ptr<Counters[]> counters_; ///< Per-service counters
+    std::unique_ptr<Limiter[]> limiters_;  ///< Per-service rate limits
+    size_t               suppressing_ = 0; ///< Services currently dropping output (loop thread only)
+    EventLoop&           loop_;
+    int                  nullFd_ = -1;  ///< /dev/null, sink for dropped output
+    std::map<int, Source> sources_;     ///< Pipe fd -> owner
+    std::map<int, std::string> partial_; ///< Unterminated trailing line per pipe (indexed mode, loop thread only)
+    mutable std::mutex   mutex_;        ///< Guards sources_
+
+    void drain(int fd, const Source& source, bool hangup);
+    bool drainLines(int fd, const Source& source, const char* data, size_t length, size_t& stored);
+    uint64_t admit(Limiter& limiter, const char* data, size_t length, size_t& begin, size_t& end);
+    void drop(size_t service, uint64_t bytes, uint64_t lines);
+    void resume(size_t service, int64_t nowUs, bool force);
+    void flushPartial(int fd, const Source& source);
+    void discard(int fd, size_t length);
+    void writeMarker(size_t service);
+    void flushMarkers(bool force);
+    void detach(int fd);
+};
@@ -0,0 +1,58 @@
+/**
+ * @file LogFormat.hpp
+ * @brief On-disk frame layout of captured service output
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Magic value starting every frame ("SMLG" little-endian)
+ */
+constexpr uint32_t LOG_FRAME_MAGIC = 0x474c4d53;
+
+/**
+ * @brief Source of a frame's payload
+ */
+enum LogStream : uint8_t {
+    LOG_STDOUT = 1,  ///< Service standard output
+    LOG_STDERR = 2,  ///< Service standard error
+    LOG_MARKER = 3   ///< Text inserted by ServiceMN (e.g. suppression notices)
+};
+
+/**
+ * @brief Header preceding each chunk of captured output
+ *
+ * Segments are a plain sequence of header + payload records. Payloads are
+ * stored byte-for-byte as read from the pipe, so binary output survives and
+ * chunks can be moved with splice() without ever being copied to user space.
+ * The timestamp is taken when the chunk was drained from the pipe.
+ */
+struct LogFrameHeader {
+    uint32_t Magic;        ///< LOG_FRAME_MAGIC
+    uint32_t Length;       ///< Payload length in bytes
+    int64_t  TimestampUs;  ///< Wall-clock capture time in microseconds since epoch
+    uint8_t  Stream;       ///< LogStream of the payload
+    uint8_t  Reserved[7];  ///< Zero
+};
+
+static_assert(sizeof(LogFrameHeader) == 24, "LogFrameHeader must stay 24 bytes");
+
+/**
+ * @brief Entry of a segment's line index ("seg-<n>.idx")
+ *
+ * Written only for services captured in indexed mode, whose frames always
+ * start at a line boundary. Entries are in file order, so timestamps are
+ * non-decreasing and can be binary searched.
+ */
+struct LogLineIndexEntry {
+    uint64_t FrameOffset;  ///< Segment offset of the frame header containing the line
+    uint32_t LineOffset;   ///< Offset of the line start within the frame payload
+    uint32_t Reserved;     ///< Zero
+    int64_t  TimestampUs;  ///< Capture time of the frame
+};
+
+static_assert(sizeof(LogLineIndexEntry) == 24, "LogLineIndexEntry must stay 24 bytes");
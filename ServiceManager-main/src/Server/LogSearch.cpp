@@ -0,0 +1,310 @@
+/**
+ * @file LogSearch.cpp
+ * @brief Implementation of the vectorized log substring search
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "LogSearch.hpp"
+#include "LogStore.hpp"
+
+#include <fcntl.h>          // open
+#include <unistd.h>         // close
+#include <sys/mman.h>       // mmap, munmap, madvise
+#include <sys/stat.h>       // fstat
+#include <algorithm>        // std::lower_bound, std::sort
+#include <array>            // std::array
+#include <chrono>           // std::chrono::steady_clock
+#include <cstring>          // memchr, memrchr, memcmp, memmem
+#include <filesystem>       // std::filesystem::path
+#include <utility>          // std::make_pair
+
+#ifdef __SSE2__
+#include <emmintrin.h>      // _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
+
+namespace {
+
+constexpr size_t MAX_LINE_TEXT = 4096;
+
+/**
+ * @brief Read-only mapping of a whole file
+ */
+struct MappedFile {
+    const char* Data = nullptr;
+    size_t      Size = 0;
+    int64_t     ModifiedUs = 0;
+
+    explicit MappedFile(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                Data = static_cast<const char*>(mapped);
+                Size = static_cast<size_t>(st.st_size);
+                madvise(mapped, Size, MADV_SEQUENTIAL);
+            }
+        }
+        ModifiedUs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000 + st.st_mtim.tv_nsec / 1000;
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (Data) {
+            munmap(const_cast<char*>(Data), Size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+/**
+ * @brief Line of one stream left unterminated at the end of a frame
+ *
+ * Frames hold whatever was drained from the pipe, so a line can continue in
+ * the stream's next frame. Only the line's start, its first MAX_LINE_TEXT
+ * bytes and the bytes a match across the next boundary could begin with
+ * are kept.
+ */
+struct PartialLine {
+    bool        Open = false;     ///< A line is pending
+    bool        Matched = false;  ///< The pending part already contains the pattern
+    LogMatch    Match;            ///< Where the line starts and its leading text
+    std::string Tail;             ///< Last bytes of the pending part (pattern length - 1)
+
+    void extend(const char* data, size_t length, size_t seam) {
+        if (Match.Text.size() < MAX_LINE_TEXT) {
+            Match.Text.append(data, std::min(length, MAX_LINE_TEXT - Match.Text.size()));
+        }
+        if (length >= seam) {
+            Tail.assign(data + length - seam, seam);
+        } else {
+            Tail.append(data, length);
+            if (Tail.size() > seam) {
+                Tail.erase(0, Tail.size() - seam);
+            }
+        }
+    }
+};
+
+} // namespace
+
+LogSearch::LogSearch(const LogStore& store)
+    : store_(store) {
+}
+
+const char* LogSearch::find(const char* haystack, size_t length,
+                            const char* needle, size_t needleLength) {
+    if (needleLength == 0 || needleLength > length) {
+        return needleLength == 0 ? haystack : nullptr;
+    }
+    if (needleLength == 1) {
+        return static_cast<const char*>(memchr(haystack, needle[0], length));
+    }
+
+    size_t i = 0;
+#ifdef __SSE2__
+    // Compare the first and last needle byte against 16 positions at once;
+    // only positions where both agree are verified with memcmp.
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+    for (; i + needleLength + 15 <= length; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i blockLast = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(haystack + i + needleLength - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+        while (mask) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (memcmp(haystack + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+                return haystack + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    const void* rest = memmem(haystack + i, length - i, needle, needleLength);
+    return static_cast<const char*>(rest);
+}
+
+LogSearchResult LogSearch::search(size_t index, const std::string& pattern, int64_t sinceUs,
+                                  size_t limit) const {
+    LogSearchResult result;
+    auto started = std::chrono::steady_clock::now();
+    if (pattern.empty() || limit == 0) {
+        return result;
+    }
+    auto finish = [&](bool truncated) {
+        result.Truncated = truncated;
+        result.DurationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - started).count();
+        return result;
+    };
+    // Adds a match; true once the limit is reached
+    auto emit = [&](LogMatch&& match) {
+        result.Matches.push_back(std::move(match));
+        return result.Matches.size() >= limit;
+    };
+    // Ends a pending line (at a suppression marker or the end of the output)
+    auto endLine = [&](PartialLine& partial) {
+        bool full = partial.Open && partial.Matched && emit(std::move(partial.Match));
+        partial = PartialLine();
+        return full;
+    };
+    std::array<PartialLine, 2> partials;  // stdout, stderr
+    size_t seam = pattern.size() - 1;     // Bytes a match can have on each side of a frame boundary
+
+    for (const auto& path : store_.segments(index)) {
+        MappedFile segment(path);
+        if (!segment.Data) {
+            continue;
+        }
+        // Nothing was written to this segment after "since"
+        if (sinceUs > 0 && segment.ModifiedUs < sinceUs) {
+            continue;
+        }
+
+        MappedFile lineIndex(LogStore::indexPathFor(path));
+        const auto* entries = reinterpret_cast<const LogLineIndexEntry*>(lineIndex.Data);
+        size_t entryCount = lineIndex.Data ? lineIndex.Size / sizeof(LogLineIndexEntry) : 0;
+        auto lineNumber = [&](uint64_t frameOffset, uint32_t lineOffset) -> int64_t {
+            const auto* line = std::lower_bound(entries, entries + entryCount,
+                std::make_pair(frameOffset, lineOffset),
+                [](const LogLineIndexEntry& entry, const std::pair<uint64_t, uint32_t>& key) {
+                    return entry.FrameOffset < key.first ||
+                           (entry.FrameOffset == key.first && entry.LineOffset < key.second);
+                });
+            if (line != entries + entryCount && line->FrameOffset == frameOffset &&
+                line->LineOffset == lineOffset) {
+                return line - entries;
+            }
+            return -1;
+        };
+
+        // Enter indexed segments at the first line captured at or after "since"
+        uint64_t offset = 0;
+        if (sinceUs > 0 && entryCount > 0) {
+            const auto* first = std::lower_bound(entries, entries + entryCount, sinceUs,
+                [](const LogLineIndexEntry& entry, int64_t value) { return entry.TimestampUs < value; });
+            if (first == entries + entryCount) {
+                continue;
+            }
+            offset = first->FrameOffset;
+        }
+
+        std::string segmentName = std::filesystem::path(path).filename().string();
+        while (offset + sizeof(LogFrameHeader) <= segment.Size) {
+            LogFrameHeader header;
+            memcpy(&header, segment.Data + offset, sizeof(header));
+            if (header.Magic != LOG_FRAME_MAGIC ||
+                offset + sizeof(header) + header.Length > segment.Size) {
+                break;  // Torn tail of a segment still being written
+            }
+            const char* payload = segment.Data + offset + sizeof(header);
+            uint64_t frameOffset = offset;
+            uint64_t payloadOffset = offset + sizeof(header);
+            offset += sizeof(header) + header.Length;
+
+            if (header.Stream == LOG_MARKER) {
+                // Output was dropped here, so pending lines do not continue
+                for (auto& partial : partials) {
+                    if (endLine(partial)) {
+                        return finish(true);
+                    }
+                }
+                continue;
+            }
+            if (header.TimestampUs < sinceUs) {
+                continue;
+            }
+            result.BytesScanned += header.Length;
+
+            const char* cursor = payload;
+            const char* end = payload + header.Length;
+            PartialLine& partial = partials[header.Stream == LOG_STDERR ? 1 : 0];
+
+            // Finish the line left unterminated by this stream's previous frame
+            if (partial.Open) {
+                const char* newline = static_cast<const char*>(memchr(payload, '\n', header.Length));
+                size_t piece = static_cast<size_t>((newline ? newline : end) - payload);
+                if (!partial.Matched) {
+                    std::string boundary = partial.Tail;
+                    boundary.append(payload, std::min(piece, seam));
+                    partial.Matched =
+                        find(boundary.data(), boundary.size(), pattern.data(), pattern.size()) ||
+                        find(payload, piece, pattern.data(), pattern.size());
+                }
+                partial.extend(payload, piece, seam);
+                if (!newline) {
+                    continue;
+                }
+                cursor = newline + 1;
+                if (partial.Matched && emit(std::move(partial.Match))) {
+                    return finish(true);
+                }
+                partial = PartialLine();
+            }
+
+            // Only complete lines are matched here; the rest waits for the next frame
+            const char* rest = static_cast<const char*>(
+                memrchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+            rest = rest ? rest + 1 : cursor;
+            while (cursor < rest) {
+                const char* hit = find(cursor, static_cast<size_t>(rest - cursor),
+                                       pattern.data(), pattern.size());
+                if (!hit) {
+                    break;
+                }
+                const char* lineStart = static_cast<const char*>(
+                    memrchr(payload, '\n', static_cast<size_t>(hit - payload)));
+                lineStart = lineStart ? lineStart + 1 : payload;
+                const char* lineEnd = static_cast<const char*>(
+                    memchr(hit, '\n', static_cast<size_t>(rest - hit)));
+
+                LogMatch match;
+                match.Segment = segmentName;
+                match.Offset = payloadOffset + static_cast<uint64_t>(lineStart - payload);
+                match.TimestampUs = header.TimestampUs;
+                match.Stream = header.Stream;
+                match.Text.assign(lineStart, std::min<size_t>(lineEnd - lineStart, MAX_LINE_TEXT));
+                if (entryCount > 0) {
+                    match.Line = lineNumber(frameOffset, static_cast<uint32_t>(lineStart - payload));
+                }
+                if (emit(std::move(match))) {
+                    return finish(true);
+                }
+                cursor = lineEnd + 1;  // One match per line
+            }
+
+            if (rest < end) {
+                partial.Open = true;
+                partial.Match.Segment = segmentName;
+                partial.Match.Offset = payloadOffset + static_cast<uint64_t>(rest - payload);
+                partial.Match.TimestampUs = header.TimestampUs;
+                partial.Match.Stream = header.Stream;
+                if (entryCount > 0) {
+                    partial.Match.Line = lineNumber(frameOffset, static_cast<uint32_t>(rest - payload));
+                }
+                size_t length = static_cast<size_t>(end - rest);
+                partial.Matched = find(rest, length, pattern.data(), pattern.size()) != nullptr;
+                partial.extend(rest, length, seam);
+            }
+        }
+    }
+
+    // Output ending without a newline still counts as a line
+    std::sort(partials.begin(), partials.end(), [](const PartialLine& a, const PartialLine& b) {
+        return a.Match.TimestampUs < b.Match.TimestampUs;
+    });
+    for (auto& partial : partials) {
+        if (endLine(partial)) {
+            return finish(true);
+        }
+    }
+    return finish(false);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file LogSearch.hpp
+ * @brief Substring search over captured service output
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class LogStore;
+
+/**
+ * @brief One matching line
+ */
+struct LogMatch {
+    std::string Segment;          ///< Segment file name
+    uint64_t    Offset = 0;       ///< Offset of the line start within the segment
+    int64_t     Line = -1;        ///< Line number within the segment (-1 without line index)
+    int64_t     TimestampUs = 0;  ///< Capture time of the containing chunk
+    uint8_t     Stream = 0;       ///< LogStream of the line
+    std::string Text;             ///< Line contents without the newline
+};
+
+/**
+ * @brief Result of a search request
+ */
+struct LogSearchResult {
+    std::vector<LogMatch> Matches;  ///< Matches in the order their lines end
+    bool     Truncated = false;     ///< Stopped early because the limit was reached
+    uint64_t BytesScanned = 0;      ///< Payload bytes examined
+    double   DurationMs = 0.0;      ///< Wall time of the search
+};
+
+/**
+ * @brief Searches a service's log segments for a fixed string
+ *
+ * Segments are memory-mapped and walked frame by frame; payloads are scanned
+ * with an SSE2 first/last-byte filter that only falls back to memcmp() on
+ * candidate positions. Segments last written before the "since" time are
+ * skipped entirely, and segments with a line index are entered directly at
+ * the first line captured at or after "since". The search stops as soon as
+ * the requested number of matches has been found.
+ *
+ * A line split over consecutive frames of the same stream is matched as
+ * one line, including matches that straddle the frame boundary; it is
+ * reported where it starts, once the frame that ends it has been read. A
+ * suppression marker ends any pending line, because the output in between
+ * was dropped.
+ */
+class LogSearch {
+public:
+    /**
+     * @brief Constructor
+     * @param store Store whose segments are searched
+     */
+    explicit LogSearch(const LogStore& store);
+
+    /**
+     * @brief Find lines containing a pattern
+     * @param index Index of the command
+     * @param pattern Fixed string to look for (non-empty)
+     * @param sinceUs Ignore output captured before this time (0 = everything)
+     * @param limit Maximum number of matches
+     * @return Matches and scan statistics
+     */
+    LogSearchResult search(size_t index, const std::string& pattern, int64_t sinceUs,
+                           size_t limit) const;
+
+    /**
+     * @brief Locate the first occurrence of a needle in a buffer
+     * @param haystack Buffer to search
+     * @param length Buffer length
+     * @param needle Pattern
+     * @param needleLength Pattern length
+     * @return Pointer to the first occurrence or nullptr
+     */
+    static const char* find(const char* haystack, size_t length,
+                            const char* needle, size_t needleLength);
+
+private:
+    const LogStore& store_;
+};
@@ -0,0 +1,431 @@
+/**
+ * @file LogStore.cpp
+ * @brief Implementation of the segmented service output store
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "LogStore.hpp"
+
+#include <fcntl.h>          // open, splice
+#include <unistd.h>         // pwrite, pread, close
+#include <sys/stat.h>       // mkdir, fstat
+#include <sys/uio.h>        // pwritev
+#include <cerrno>           // errno
+#include <chrono>           // std::chrono::system_clock
+#include <cstdio>           // snprintf, perror
+#include <cstring>          // memset, memchr
+#include <filesystem>       // std::filesystem::directory_iterator
+#include <iostream>         // std::cerr
+#include <algorithm>        // std::sort
+
+namespace {
+
+constexpr size_t RECOVER_CHUNK = 1 << 20;
+
+bool parseSegmentName(const std::string& name, uint64_t& segment) {
+    if (name.size() < 9 || name.compare(0, 4, "seg-") != 0 ||
+        name.compare(name.size() - 4, 4, ".log") != 0) {
+        return false;
+    }
+    try {
+        segment = std::stoull(name.substr(4, name.size() - 8));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Find the end of the last complete frame of a segment
+ * @param fd Segment opened for reading
+ * @param fileSize Current size of the segment
+ * @return Offset just past the last frame whose header and payload are intact
+ */
+uint64_t completeFramesEnd(int fd, uint64_t fileSize) {
+    std::vector<char> window;
+    uint64_t windowStart = 0;
+    uint64_t offset = 0;
+    LogFrameHeader header;
+    while (offset + sizeof(header) <= fileSize) {
+        if (offset < windowStart || offset + sizeof(header) > windowStart + window.size()) {
+            window.resize(RECOVER_CHUNK);
+            ssize_t got = pread(fd, window.data(), window.size(), static_cast<off_t>(offset));
+            window.resize(got > 0 ? static_cast<size_t>(got) : 0);
+            windowStart = offset;
+            if (window.size() < sizeof(header)) {
+                break;
+            }
+        }
+        memcpy(&header, window.data() + (offset - windowStart), sizeof(header));
+        if (header.Magic != LOG_FRAME_MAGIC ||
+            offset + sizeof(header) + header.Length > fileSize) {
+            break;
+        }
+        offset += sizeof(header) + header.Length;
+    }
+    return offset;
+}
+
+} // namespace
+
+LogStore::LogStore(const std::string& dir, uint64_t segmentBytes, size_t keepSegments)
+    : dir_(dir), segmentBytes_(segmentBytes), keepSegments_(keepSegments == 0 ? 1 : keepSegments) {
+    if (dir_.empty()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+        std::cerr << "LogStore: cannot create " << dir_ << ": " << ec.message()
+                  << ", output capture disabled" << std::endl;
+        dir_.clear();
+    }
+}
+
+LogStore::~LogStore() {
+    for (auto& entry : writers_) {
+        if (entry.second.Fd >= 0) {
+            close(entry.second.Fd);
+        }
+        if (entry.second.IndexFd >= 0) {
+            close(entry.second.IndexFd);
+        }
+    }
+}
+
+std::string LogStore::indexPathFor(const std::string& segmentPath) {
+    return segmentPath.substr(0, segmentPath.size() - 4) + ".idx";
+}
+
+int64_t LogStore::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string LogStore::directoryFor(size_t index) const {
+    return dir_ + "/svc-" + std::to_string(index);
+}
+
+std::string LogStore::segmentPath(size_t index, uint64_t segment) const {
+    char name[32];
+    snprintf(name, sizeof(name), "/seg-%08llu.log", static_cast<unsigned long long>(segment));
+    return directoryFor(index) + name;
+}
+
+std::vector<std::string> LogStore::segments(size_t index) const {
+    std::vector<std::pair<uint64_t, std::string>> found;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directoryFor(index), ec), end; !ec && it != end;
+         it.increment(ec)) {
+        uint64_t segment;
+        if (parseSegmentName(it->path().filename().string(), segment)) {
+            found.emplace_back(segment, it->path().string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::string> paths;
+    for (auto& item : found) {
+        paths.push_back(std::move(item.second));
+    }
+    return paths;
+}
+
+bool LogStore::openSegment(size_t index, Writer& writer, uint64_t segment) {
+    if (writer.Fd >= 0) {
+        close(writer.Fd);
+        writer.Fd = -1;
+    }
+    if (writer.IndexFd >= 0) {
+        close(writer.IndexFd);
+        writer.IndexFd = -1;
+    }
+    std::string path = segmentPath(index, segment);
+    // No O_APPEND: splice() refuses append-mode files, offsets are tracked here
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        perror(("LogStore: cannot open " + path).c_str());
+        return false;
+    }
+    writer.Offset = recoverSegment(path, fd);
+    writer.Fd = fd;
+    writer.Segment = segment;
+    return true;
+}
+
+uint64_t LogStore::recoverSegment(const std::string& path, int fd) const {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        return 0;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+
+    // A crash can leave a torn frame at the end; appending after it would
+    // make every later frame unreachable for readers
+    uint64_t end = completeFramesEnd(fd, fileSize);
+    if (end < fileSize) {
+        std::cerr << "⚠️  Log segment " << path << ": discarding " << (fileSize - end)
+                  << " bytes of incomplete data at offset " << end << std::endl;
+        if (ftruncate(fd, static_cast<off_t>(end)) != 0) {
+            perror("LogStore: ftruncate failed");
+        }
+    }
+
+    // Drop line index entries pointing at discarded frames, and any torn entry
+    std::string indexPath = indexPathFor(path);
+    int indexFd = open(indexPath.c_str(), O_RDWR | O_CLOEXEC);
+    if (indexFd < 0) {
+        return end;
+    }
+    struct stat indexSt;
+    if (fstat(indexFd, &indexSt) == 0) {
+        uint64_t count = static_cast<uint64_t>(indexSt.st_size) / sizeof(LogLineIndexEntry);
+        uint64_t keep = count;
+        LogLineIndexEntry entry;
+        // Entries are in file order, so the discarded ones form a suffix
+        while (keep > 0 &&
+               pread(indexFd, &entry, sizeof(entry),
+                     static_cast<off_t>((keep - 1) * sizeof(entry))) ==
+                   static_cast<ssize_t>(sizeof(entry)) &&
+               entry.FrameOffset >= end) {
+            --keep;
+        }
+        if (keep * sizeof(LogLineIndexEntry) != static_cast<uint64_t>(indexSt.st_size) &&
+            ftruncate(indexFd, static_cast<off_t>(keep * sizeof(LogLineIndexEntry))) != 0) {
+            perror("LogStore: ftruncate of line index failed");
+        }
+    }
+    close(indexFd);
+    return end;
+}
+
+void LogStore::pruneSegments(size_t index) const {
+    auto paths = segments(index);
+    for (size_t i = 0; i + keepSegments_ < paths.size(); ++i) {
+        unlink(paths[i].c_str());
+        unlink(indexPathFor(paths[i]).c_str());
+    }
+}
+
+LogStore::Writer* LogStore::writerFor(size_t index, size_t frameBytes) {
+    Writer& writer = writers_[index];
+
+    if (writer.Fd < 0) {
+        mkdir(directoryFor(index).c_str(), 0755);
+        // Continue the newest existing segment after a restart
+        uint64_t segment = 1;
+        auto paths = segments(index);
+        if (!paths.empty()) {
+            parseSegmentName(std::filesystem::path(paths.back()).filename().string(), segment);
+        }
+        if (!openSegment(index, writer, segment)) {
+            return nullptr;
+        }
+    }
+
+    if (writer.Offset > 0 && writer.Offset + frameBytes > segmentBytes_) {
+        if (!openSegment(index, writer, writer.Segment + 1)) {
+            return nullptr;
+        }
+        pruneSegments(index);
+    }
+    return &writer;
+}
+
+size_t LogStore::appendSplice(size_t index, int pipeFd, uint8_t stream, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_.empty() || length == 0) {
+        return 0;
+    }
+    Writer* writer = writerFor(index, sizeof(LogFrameHeader) + length);
+    if (!writer) {
+        return 0;
+    }
+
+    // The payload lands first and the header last: readers stop at a frame
+    // whose magic is missing, so nothing is visible until it is complete, and
+    // a failed splice leaves the segment as it was (it is never shrunk, as
+    // LogSearch may have it mapped)
+    int64_t timestampUs = nowUs();
+    uint64_t headerOffset = writer->Offset;
+    loff_t offset = static_cast<loff_t>(headerOffset + sizeof(LogFrameHeader));
+    size_t moved = 0;
+    while (moved < length && writer->CanSplice) {
+        ssize_t n = splice(pipeFd, nullptr, writer->Fd, &offset, length - moved, SPLICE_F_MOVE);
+        if (n > 0) {
+            moved += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && errno == EINVAL && moved == 0) {
+            writer->CanSplice = false;
+        } else {
+            break;
+        }
+    }
+
+    // Filesystems without splice support go through a bounce buffer
+    char buffer[65536];
+    while (moved < length && !writer->CanSplice) {
+        size_t want = std::min(sizeof(buffer), length - moved);
+        ssize_t n = read(pipeFd, buffer, want);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0 || pwrite(writer->Fd, buffer, static_cast<size_t>(n), offset) != n) {
+            break;
+        }
+        offset += n;
+        moved += static_cast<size_t>(n);
+    }
+
+    if (moved == 0) {
+        return 0;  // Never leave a 0-length frame behind; the next frame reuses the offset
+    }
+
+    // Describe only what actually landed on disk
+    LogFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = LOG_FRAME_MAGIC;
+    header.Length = static_cast<uint32_t>(moved);
+    header.TimestampUs = timestampUs;
+    header.Stream = stream;
+    if (pwrite(writer->Fd, &header, sizeof(header), static_cast<off_t>(headerOffset)) !=
+        static_cast<ssize_t>(sizeof(header))) {
+        perror("LogStore::appendSplice: header write failed");
+        return 0;  // The next frame overwrites the headerless payload
+    }
+    writer->Offset = headerOffset + sizeof(header) + moved;
+    return moved;
+}
+
+bool LogStore::writeFrame(Writer& writer, uint8_t stream, const char* data, size_t length,
+                          int64_t timestampUs, uint64_t& frameOffset) {
+    LogFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = LOG_FRAME_MAGIC;
+    header.Length = static_cast<uint32_t>(length);
+    header.TimestampUs = timestampUs;
+    header.Stream = stream;
+
+    struct iovec parts[2] = {{&header, sizeof(header)}, {const_cast<char*>(data), length}};
+    if (pwritev(writer.Fd, parts, 2, static_cast<off_t>(writer.Offset)) !=
+        static_cast<ssize_t>(sizeof(header) + length)) {
+        perror("LogStore: frame write failed");
+        return false;
+    }
+    frameOffset = writer.Offset;
+    writer.Offset += sizeof(header) + length;
+    return true;
+}
+
+bool LogStore::appendData(size_t index, uint8_t stream, const char* data, size_t length,
+                          int64_t timestampUs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_.empty() || length == 0) {
+        return false;
+    }
+    Writer* writer = writerFor(index, sizeof(LogFrameHeader) + length);
+    uint64_t frameOffset;
+    return writer && writeFrame(*writer, stream, data, length,
+                                timestampUs ? timestampUs : nowUs(), frameOffset);
+}
+
+bool LogStore::appendLines(size_t index, uint8_t stream, const char* data, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_.empty() || length == 0) {
+        return false;
+    }
+    Writer* writer = writerFor(index, sizeof(LogFrameHeader) + length);
+    int64_t timestampUs = nowUs();
+    uint64_t frameOffset;
+    if (!writer || !writeFrame(*writer, stream, data, length, timestampUs, frameOffset)) {
+        return false;
+    }
+
+    if (writer->IndexFd < 0) {
+        std::string path = indexPathFor(segmentPath(index, writer->Segment));
+        writer->IndexFd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (writer->IndexFd < 0) {
+            perror(("LogStore: cannot open " + path).c_str());
+            return true;  // Output is stored; only the index is missing
+        }
+    }
+
+    std::vector<LogLineIndexEntry> entries;
+    for (const char* line = data; line < data + length;) {
+        LogLineIndexEntry entry = {};
+        entry.FrameOffset = frameOffset;
+        entry.LineOffset = static_cast<uint32_t>(line - data);
+        entry.TimestampUs = timestampUs;
+        entries.push_back(entry);
+
+        const char* newline = static_cast<const char*>(memchr(line, '\n', data + length - line));
+        if (!newline) {
+            break;
+        }
+        line = newline + 1;
+    }
+    size_t bytes = entries.size() * sizeof(LogLineIndexEntry);
+    if (write(writer->IndexFd, entries.data(), bytes) != static_cast<ssize_t>(bytes)) {
+        perror("LogStore: line index write failed");
+    }
+    return true;
+}
+
+std::vector<LogChunk> LogStore::tail(size_t index, size_t maxBytes) const {
+    std::vector<LogChunk> chunks;
+    if (dir_.empty()) {
+        return chunks;
+    }
+
+    auto paths = segments(index);
+    size_t collected = 0;
+
+    // Walk segments newest first; within a segment frames can only be
+    // located from the start, so collect headers and then read the tail.
+    for (auto path = paths.rbegin(); path != paths.rend() && collected < maxBytes; ++path) {
+        int fd = open(path->c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            continue;
+        }
+
+        std::vector<std::pair<uint64_t, LogFrameHeader>> frames;
+        uint64_t offset = 0;
+        LogFrameHeader header;
+        while (offset + sizeof(header) <= static_cast<uint64_t>(st.st_size) &&
+               pread(fd, &header, sizeof(header), static_cast<off_t>(offset)) ==
+                   static_cast<ssize_t>(sizeof(header)) &&
+               header.Magic == LOG_FRAME_MAGIC &&
+               offset + sizeof(header) + header.Length <= static_cast<uint64_t>(st.st_size)) {
+            frames.emplace_back(offset, header);
+            offset += sizeof(header) + header.Length;
+        }
+
+        std::vector<LogChunk> segmentChunks;
+        for (auto frame = frames.rbegin(); frame != frames.rend() && collected < maxBytes; ++frame) {
+            size_t take = std::min<size_t>(frame->second.Length, maxBytes - collected);
+            LogChunk chunk;
+            chunk.TimestampUs = frame->second.TimestampUs;
+            chunk.Stream = frame->second.Stream;
+            chunk.Data.resize(take);
+            // Keep the end of a partially returned frame
+            uint64_t dataOffset = frame->first + sizeof(LogFrameHeader) + (frame->second.Length - take);
+            if (pread(fd, &chunk.Data[0], take, static_cast<off_t>(dataOffset)) !=
+                static_cast<ssize_t>(take)) {
+                break;
+            }
+            collected += take;
+            segmentChunks.push_back(std::move(chunk));
+        }
+        close(fd);
+
+        chunks.insert(chunks.begin(), segmentChunks.rbegin(), segmentChunks.rend());
+    }
+    return chunks;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file LogStore.hpp
+ * @brief Segmented on-disk store for captured service output
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "LogFormat.hpp"
+
+/**
+ * @brief Decoded chunk of captured output
+ */
+struct LogChunk {
+    int64_t     TimestampUs = 0;  ///< Capture time in microseconds since epoch
+    uint8_t     Stream = LOG_STDOUT; ///< LogStream of the data
+    std::string Data;             ///< Raw payload
+};
+
+/**
+ * @brief Per-service append-only log segments
+ *
+ * Each service writes to "<dir>/svc-<index>/seg-<n>.log". A segment is
+ * rotated once it would exceed the configured size, and only the newest
+ * segments are kept. Services captured in indexed mode additionally get a
+ * "seg-<n>.idx" line index next to each segment. Writes come from the log
+ * collector thread; readers open segments independently and stop at the
+ * first incomplete frame. When the newest segment is resumed after a
+ * restart, it is first truncated to its last complete frame (and its line
+ * index to the entries of the kept frames), so a write torn by a crash
+ * cannot hide the frames appended after it.
+ */
+class LogStore {
+public:
+    /**
+     * @brief Constructor
+     * @param dir Root log directory (empty disables the store)
+     * @param segmentBytes Maximum size of one segment
+     * @param keepSegments Number of segments retained per service
+     */
+    LogStore(const std::string& dir, uint64_t segmentBytes, size_t keepSegments);
+
+    /**
+     * @brief Destructor - closes open segments
+     */
+    ~LogStore();
+
+    LogStore(const LogStore&) = delete;
+    LogStore& operator=(const LogStore&) = delete;
+
+    /**
+     * @brief Check whether output capture is configured
+     */
+    bool enabled() const { return !dir_.empty(); }
+
+    /**
+     * @brief Append a frame whose payload is moved straight from a pipe
+     * @param index Index of the command
+     * @param pipeFd Pipe read end holding at least length bytes
+     * @param stream LogStream of the data
+     * @param length Number of bytes to move
+     * @return Number of payload bytes stored (0 on failure)
+     *
+     * Uses splice() so the payload never passes through user space. Falls
+     * back to read()/pwrite() if the filesystem does not support splicing.
+     */
+    size_t appendSplice(size_t index, int pipeFd, uint8_t stream, size_t length);
+
+    /**
+     * @brief Append a frame from a buffer
+     * @param index Index of the command
+     * @param stream LogStream of the data
+     * @param data Payload
+     * @param length Payload length
+     * @param timestampUs Capture time (0 = now)
+     * @return true on success
+     */
+    bool appendData(size_t index, uint8_t stream, const char* data, size_t length,
+                    int64_t timestampUs = 0);
+
+    /**
+     * @brief Append a frame of complete lines and index every line start
+     * @param index Index of the command
+     * @param stream LogStream of the data
+     * @param data Payload starting at a line boundary
+     * @param length Payload length
+     * @return true on success
+     */
+    bool appendLines(size_t index, uint8_t stream, const char* data, size_t length);
+
+    /**
+     * @brief Read the most recent output of a service
+     * @param index Index of the command
+     * @param maxBytes Upper bound on returned payload bytes
+     * @return Chunks in chronological order
+     */
+    std::vector<LogChunk> tail(size_t index, size_t maxBytes) const;
+
+    /**
+     * @brief Get the segment files of a service
+     * @param index Index of the command
+     * @return Paths ordered oldest first
+     */
+    std::vector<std::string> segments(size_t index) const;
+
+    /**
+     * @brief Get the line index file belonging to a segment
+     * @param segmentPath Path returned by segments()
+     */
+    static std::string indexPathFor(const std::string& segmentPath);
+
+    /**
+     * @brief Get the log directory of a service
+     * @param index Index of the command
+     */
+    std::string directoryFor(size_t index) const;
+
+    /**
+     * @brief Current wall-clock time in microseconds since epoch
+     */
+    static int64_t nowUs();
+
+private:
+    struct Writer {
+        int      Fd = -1;           ///< Open segment
+        int      IndexFd = -1;      ///< Open line index (opened on first indexed write)
+        uint64_t Segment = 0;       ///< Segment number
+        uint64_t Offset = 0;        ///< Next write position
+        bool     CanSplice = true;  ///< Cleared when the filesystem rejects splice()
+    };
+
+    std::string dir_;
+    uint64_t    segmentBytes_;
+    size_t      keepSegments_;
+    std::map<size_t, Writer> writers_;
+    mutable std::mutex mutex_;      ///< Guards writers_
+
+    Writer* writerFor(size_t index, size_t frameBytes);
+    bool openSegment(size_t index, Writer& writer, uint64_t segment);
+    uint64_t recoverSegment(const std::string& path, int fd) const;
+    void pruneSegments(size_t index) const;
+    std::string segmentPath(size_t index, uint64_t segment) const;
+    bool writeFrame(Writer& writer, uint8_t stream, const char* data, size_t length,
+                    int64_t timestampUs, uint64_t& frameOffset);
+};
@@ -0,0 +1,190 @@
+/**
+ * @file MemoryPolicy.cpp
+ * @brief Implementation of per-service memory policies
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "MemoryPolicy.hpp"
+
+#include <unistd.h>         // access, syscall
+#include <sys/prctl.h>      // prctl, PR_SET_THP_DISABLE
+#include <sys/syscall.h>    // SYS_set_mempolicy
+#include <cstdio>           // perror
+#include <cstdlib>          // strtol
+#include <fstream>          // std::ifstream
+#include <sstream>          // std::istringstream
+
+namespace {
+
+// From <linux/prctl.h> and <linux/mempolicy.h>; older headers lack the newer ones
+constexpr int SET_MEMORY_MERGE = 67;
+constexpr unsigned long THP_DISABLE_EXCEPT_ADVISED = 1UL << 1;
+constexpr int MPOL_PREFERRED_MODE = 1;
+
+constexpr int MAX_NUMA_NODE = 1023;
+constexpr const char* KSM_DIR = "/sys/kernel/mm/ksm/";
+
+/**
+ * @brief Read the "Key: value" lines of a /proc file
+ * @param path File to read
+ * @param visit Called with each key and its numeric value
+ * @return false if the file cannot be opened
+ */
+template <typename Visitor>
+bool readFields(const std::string& path, Visitor visit) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        int64_t value = 0;
+        if (fields >> key >> value) {
+            if (key.back() == ':') {
+                key.pop_back();
+            }
+            visit(key, value);
+        }
+    }
+    return true;
+}
+
+uint64_t readKsmCounter(const char* name) {
+    std::ifstream file(std::string(KSM_DIR) + name);
+    uint64_t value = 0;
+    file >> value;
+    return value;
+}
+
+} // namespace
+
+bool MemoryPolicy::fromCommand(const command& cmd, MemoryPolicy& policy, std::string& error) {
+    policy = MemoryPolicy();
+
+    std::string ksm = cmd.option("memory.ksm", "off");
+    if (ksm != "on" && ksm != "off") {
+        error = "@memory.ksm must be on or off";
+        return false;
+    }
+    policy.Ksm = ksm == "on";
+
+    std::string thp = cmd.option("memory.thp", "system");
+    if (thp == "never") {
+        policy.Thp = ThpMode::Never;
+    } else if (thp == "advised") {
+        policy.Thp = ThpMode::Advised;
+    } else if (thp != "system") {
+        error = "@memory.thp must be system, never or advised";
+        return false;
+    }
+
+    std::string node = cmd.option("memory.numa.preferred");
+    if (!node.empty()) {
+        char* end = nullptr;
+        long value = strtol(node.c_str(), &end, 10);
+        if (*end != '\0' || value < 0 || value > MAX_NUMA_NODE) {
+            error = "@memory.numa.preferred must be a NUMA node number";
+            return false;
+        }
+        if (access(("/sys/devices/system/node/node" + node).c_str(), F_OK) != 0) {
+            error = "@memory.numa.preferred: NUMA node " + node + " does not exist";
+            return false;
+        }
+        policy.PreferredNode = static_cast<int>(value);
+    }
+    return true;
+}
+
+void MemoryPolicy::apply() const {
+    if (Ksm && prctl(SET_MEMORY_MERGE, 1, 0, 0, 0) != 0) {
+        perror("MemoryPolicy: PR_SET_MEMORY_MERGE failed (Linux 6.4+ with CONFIG_KSM)");
+    }
+    if (Thp == ThpMode::Never && prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0) != 0) {
+        perror("MemoryPolicy: PR_SET_THP_DISABLE failed");
+    }
+    if (Thp == ThpMode::Advised &&
+        prctl(PR_SET_THP_DISABLE, 1, THP_DISABLE_EXCEPT_ADVISED, 0, 0) != 0) {
+        perror("MemoryPolicy: PR_SET_THP_DISABLE (except advised) failed (Linux 6.18+)");
+    }
+    if (PreferredNode >= 0) {
+        unsigned long nodes[(MAX_NUMA_NODE + 1) / (8 * sizeof(unsigned long))] = {};
+        nodes[PreferredNode / (8 * sizeof(unsigned long))] |= 1UL << (PreferredNode % (8 * sizeof(unsigned long)));
+        // maxnode counts one bit more than the mask holds, as libnuma passes it
+        if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, nodes, sizeof(nodes) * 8 + 1) != 0) {
+            perror("MemoryPolicy: set_mempolicy(MPOL_PREFERRED) failed");
+        }
+    }
+}
+
+const char* MemoryPolicy::thpName(ThpMode mode) {
+    switch (mode) {
+        case ThpMode::Never:   return "never";
+        case ThpMode::Advised: return "advised";
+        default:               return "system";
+    }
+}
+
+bool MemoryUsage::add(pid_t pid, bool main) {
+    std::string dir = "/proc/" + std::to_string(pid) + "/";
+    MemoryUsage process;
+    // smaps_rollup walks the page tables once for all mappings
+    bool alive = readFields(dir + "smaps_rollup", [&](const std::string& key, int64_t kb) {
+        if (key == "Rss") {
+            process.RssKb = static_cast<uint64_t>(kb);
+        } else if (key == "AnonHugePages") {
+            process.AnonHugeKb = static_cast<uint64_t>(kb);
+        } else if (key == "FilePmdMapped" || key == "ShmemPmdMapped") {
+            process.FileHugeKb += static_cast<uint64_t>(kb);
+        }
+    });
+    if (!alive) {
+        return false;
+    }
+    readFields(dir + "status", [&](const std::string& key, int64_t value) {
+        if (key == "HugetlbPages") {
+            process.HugetlbKb = static_cast<uint64_t>(value);
+        } else if (key == "THP_enabled") {
+            process.ThpDisabled = value == 0;
+        }
+    });
+    // ksm_stat mixes "ksm_merging_pages 12" with "ksm_merge_any: yes", so it is read as words
+    std::ifstream ksm(dir + "ksm_stat");
+    std::string key, value;
+    while (ksm >> key >> value) {
+        if (key == "ksm_merging_pages") {
+            process.KsmMergingPages = strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "ksm_process_profit") {
+            process.KsmProfitBytes = strtoll(value.c_str(), nullptr, 10);
+        } else if (key == "ksm_merge_any:") {
+            process.KsmMergeAny = value == "yes";
+        }
+    }
+
+    Processes++;
+    RssKb += process.RssKb;
+    AnonHugeKb += process.AnonHugeKb;
+    FileHugeKb += process.FileHugeKb;
+    HugetlbKb += process.HugetlbKb;
+    KsmMergingPages += process.KsmMergingPages;
+    KsmProfitBytes += process.KsmProfitBytes;
+    if (main) {
+        KsmMergeAny = process.KsmMergeAny;
+        ThpDisabled = process.ThpDisabled;
+    }
+    return true;
+}
+
+KsmHostState KsmHostState::read() {
+    KsmHostState state;
+    std::ifstream run(std::string(KSM_DIR) + "run");
+    if (!(run >> state.Run)) {
+        return state;
+    }
+    state.Available = true;
+    state.PagesShared = readKsmCounter("pages_shared");
+    state.PagesSharing = readKsmCounter("pages_sharing");
+    return state;
+}
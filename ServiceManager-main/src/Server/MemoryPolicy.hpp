@@ -0,0 +1,104 @@
+/**
+ * @file MemoryPolicy.hpp
+ * @brief Per-service KSM, transparent huge page and NUMA policies, and their effect
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+#include "command.hpp"
+
+/**
+ * @brief Transparent huge page mode of a service
+ */
+enum class ThpMode {
+    System,   ///< Follow /sys/kernel/mm/transparent_hugepage/enabled
+    Never,    ///< PR_SET_THP_DISABLE: no huge pages at all
+    Advised   ///< Huge pages only where the service calls madvise(MADV_HUGEPAGE) (Linux 6.18+)
+};
+
+/**
+ * @brief Memory policy applied to a native service at spawn
+ *
+ * Read from the service's options:
+ * - memory.ksm             "on" to let KSM merge all of its anonymous memory (PR_SET_MEMORY_MERGE)
+ * - memory.thp             "system" (default), "never" or "advised"
+ * - memory.numa.preferred  NUMA node to allocate from first (MPOL_PREFERRED)
+ *
+ * All three are properties of the address space that survive fork() and
+ * execve(), so the forked child sets them on itself right before exec and
+ * every process the service spawns inherits them.
+ */
+struct MemoryPolicy {
+    bool    Ksm = false;
+    ThpMode Thp = ThpMode::System;
+    int     PreferredNode = -1;  ///< -1 = default local allocation
+
+    /**
+     * @brief Read the policy from a command's options
+     * @param cmd Command to read
+     * @param policy Receives the policy
+     * @param error Receives the reason when an option is invalid
+     */
+    static bool fromCommand(const command& cmd, MemoryPolicy& policy, std::string& error);
+
+    /**
+     * @brief Check whether the policy changes nothing
+     */
+    bool empty() const { return !Ksm && Thp == ThpMode::System && PreferredNode < 0; }
+
+    /**
+     * @brief Apply the policy to the calling process (child side, before exec)
+     *
+     * Failures are printed and the start proceeds without that setting.
+     */
+    void apply() const;
+
+    /**
+     * @brief Name of a THP mode
+     */
+    static const char* thpName(ThpMode mode);
+};
+
+/**
+ * @brief Memory usage attributable to the policies, summed over processes
+ */
+struct MemoryUsage {
+    int      Processes = 0;
+    uint64_t RssKb = 0;
+    uint64_t AnonHugeKb = 0;       ///< Anonymous memory backed by THPs
+    uint64_t FileHugeKb = 0;       ///< File and shmem pages mapped with PMDs
+    uint64_t HugetlbKb = 0;        ///< Explicit hugetlbfs pages
+    uint64_t KsmMergingPages = 0;  ///< Pages deduplicated by KSM
+    int64_t  KsmProfitBytes = 0;   ///< Memory saved by KSM minus its metadata
+    bool     KsmMergeAny = false;  ///< PR_SET_MEMORY_MERGE is in effect (main process)
+    bool     ThpDisabled = false;  ///< THPs are disabled (main process)
+
+    /**
+     * @brief Add one process from /proc/<pid>/smaps_rollup, status and ksm_stat
+     * @param pid Process to read
+     * @param main The service's main process, whose flags are reported
+     * @return false if the process is gone
+     */
+    bool add(pid_t pid, bool main);
+};
+
+/**
+ * @brief Host-wide KSM state from /sys/kernel/mm/ksm
+ */
+struct KsmHostState {
+    bool     Available = false;
+    int      Run = 0;             ///< 0 = stopped, 1 = merging, 2 = unmerging
+    uint64_t PagesShared = 0;     ///< Distinct shared pages kept
+    uint64_t PagesSharing = 0;    ///< Further mappings of those pages (pages saved)
+
+    /**
+     * @brief Read the current state
+     */
+    static KsmHostState read();
+};
@@ -0,0 +1,411 @@
+/**
+ * @file NotifyMonitor.cpp
+ * @brief Implementation of the sd_notify() protocol receiver
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "NotifyMonitor.hpp"
+#include "AsyncOps.hpp"
+#include "EventLog.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // close, unlink
+#include <fcntl.h>          // F_DUPFD_CLOEXEC
+#include <signal.h>         // kill
+#include <sys/socket.h>     // socket, bind, recvmsg, SCM_CREDENTIALS
+#include <sys/un.h>         // sockaddr_un
+#include <cerrno>           // errno
+#include <cstddef>          // offsetof
+#include <cstdlib>          // atoi, atoll
+#include <cstdio>           // perror
+#include <cstring>          // memcpy, strncpy
+#include <fstream>          // std::ifstream
+#include <iostream>         // std::cerr
+#include <sstream>          // std::istringstream
+
+namespace {
+
+constexpr size_t MAX_MESSAGE = 4096;          ///< sd_notify() messages are short
+constexpr int MAX_ANCESTRY = 8;               ///< Parent links followed to find the instance
+constexpr size_t PRUNE_THRESHOLD = 64;        ///< Instances tracked before dead ones are dropped
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Read a process's parent from /proc/<pid>/stat
+ * @return Parent PID, or -1 if the process is gone
+ */
+pid_t parentOf(pid_t pid) {
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) {
+        return -1;
+    }
+    // The command name may contain spaces and parentheses; fields resume after the last ')'
+    size_t end = line.rfind(')');
+    if (end == std::string::npos) {
+        return -1;
+    }
+    std::istringstream fields(line.substr(end + 1));
+    std::string state;
+    pid_t parent = -1;
+    fields >> state >> parent;
+    return parent;
+}
+
+} // namespace
+
+NotifyMonitor::NotifyMonitor(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop,
+                             EventLog& events, const std::string& socketPath)
+    : runner_(runner), orchestrator_(orchestrator), loop_(loop), events_(events), path_(socketPath) {
+    services_.resize(runner_.getCommandCount());
+    for (size_t i = 0; i < services_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        Service& service = services_[i];
+        double watchdog = cmd.optionNumber("watchdog", 0.0);
+        bool notify = cmd.option("notify") == "1" || watchdog > 0;
+        if (notify && cmd.Mode != 'C') {
+            events_.record(static_cast<int>(i), "notify.config",
+                           std::string("@notify and @watchdog are ignored for ") +
+                           (cmd.Mode == 'S' ? "sandboxed" : "Docker") + " services");
+            continue;
+        }
+        if (notify && !cmd.option("criu.dir").empty()) {
+            events_.record(static_cast<int>(i), "notify.config",
+                           "Instances restored from a checkpoint do not send READY=1 again; "
+                           "readiness checks of restored instances will time out");
+        }
+        service.Enabled = notify;
+        service.Watchdog = std::chrono::microseconds(static_cast<int64_t>(watchdog * 1e6));
+        service.Stats.Enabled = notify;
+        service.Stats.WatchdogUs = service.Watchdog.count();
+    }
+}
+
+NotifyMonitor::~NotifyMonitor() {
+    if (fd_ >= 0) {
+        close(fd_);
+        if (path_[0] != '@') {
+            unlink(path_.c_str());
+        }
+    }
+}
+
+bool NotifyMonitor::open() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path_.empty() || path_.size() >= sizeof(address.sun_path)) {
+        std::cerr << "NotifyMonitor: invalid socket path '" << path_ << "'" << std::endl;
+        return false;
+    }
+    strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+    socklen_t length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path_.size());
+    if (path_[0] == '@') {
+        address.sun_path[0] = '\0';  // Abstract namespace, nothing to clean up
+    } else {
+        unlink(path_.c_str());
+        ++length;
+    }
+
+    fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        perror("NotifyMonitor: socket failed");
+        return false;
+    }
+    int on = 1;
+    if (setsockopt(fd_, SOL_SOCKET, SO_PASSCRED, &on, sizeof(on)) != 0 ||
+        bind(fd_, reinterpret_cast<sockaddr*>(&address), length) != 0) {
+        perror("NotifyMonitor: bind failed");
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+void NotifyMonitor::start() {
+    if (fd_ < 0) {
+        return;
+    }
+    loop_.post([this]() {
+        loop_.watch(fd_, [this](uint32_t) { receive(); });
+    });
+}
+
+bool NotifyMonitor::enabled(size_t index) const {
+    return fd_ >= 0 && index < services_.size() && services_[index].Enabled;
+}
+
+std::chrono::microseconds NotifyMonitor::watchdog(size_t index) const {
+    return index < services_.size() ? services_[index].Watchdog : std::chrono::microseconds(0);
+}
+
+void NotifyMonitor::receive() {
+    char buffer[MAX_MESSAGE];
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(ucred))];
+    for (;;) {
+        iovec iov = {buffer, sizeof(buffer)};
+        msghdr message = {};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ssize_t length = recvmsg(fd_, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC | MSG_TRUNC);
+        if (length < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("NotifyMonitor: recvmsg failed");
+            }
+            return;
+        }
+        if (static_cast<size_t>(length) > sizeof(buffer)) {
+            continue;  // Truncated; sd_notify() never sends this much
+        }
+
+        // The kernel fills in the sender's credentials (SO_PASSCRED)
+        pid_t sender = -1;
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_CREDENTIALS) {
+                ucred credentials;
+                memcpy(&credentials, CMSG_DATA(header), sizeof(credentials));
+                sender = credentials.pid;
+            } else if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+                // File descriptor store is not supported; do not leak passed fds
+                size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (size_t i = 0; i < count; ++i) {
+                    int fd;
+                    memcpy(&fd, CMSG_DATA(header) + i * sizeof(int), sizeof(fd));
+                    close(fd);
+                }
+            }
+        }
+        if (sender > 0) {
+            handle(sender, std::string(buffer, static_cast<size_t>(length)));
+        }
+    }
+}
+
+bool NotifyMonitor::resolve(pid_t sender, size_t& index, pid_t& instance) {
+    pid_t pid = sender;
+    for (int depth = 0; depth < MAX_ANCESTRY && pid > 1; ++depth) {
+        auto known = instances_.find(pid);
+        if (known != instances_.end()) {
+            index = known->second.Service;
+            instance = pid;
+            return true;
+        }
+        for (size_t i = 0; i < services_.size(); ++i) {
+            if (services_[i].Enabled && runner_.getPid(i) == pid) {
+                index = i;
+                instance = pid;
+                instances_[pid].Service = i;
+                return true;
+            }
+        }
+        pid = parentOf(pid);
+    }
+    return false;
+}
+
+void NotifyMonitor::sync(size_t index) {
+    // A new current instance starts with a fresh state
+    Service& service = services_[index];
+    pid_t pid = runner_.getPid(index);
+    if (pid == service.Stats.Pid) {
+        return;
+    }
+    auto known = instances_.find(pid);
+    std::lock_guard<std::mutex> lock(mutex_);
+    service.Armed = false;
+    service.Stats.Pid = pid;
+    service.Stats.Ready = known != instances_.end() && known->second.Ready;
+    service.Stats.State = pid <= 0 ? "" : service.Stats.Ready ? "ready" : "starting";
+    service.Stats.Status.clear();
+    service.Stats.Errno = 0;
+    service.Stats.LastPingMs = 0;
+    service.Stats.WatchdogUs = service.Watchdog.count();
+}
+
+void NotifyMonitor::handle(pid_t sender, const std::string& message) {
+    size_t index;
+    pid_t pid;
+    if (!resolve(sender, index, pid)) {
+        return;
+    }
+    sync(index);
+    Service& service = services_[index];
+    Instance& instance = instances_[pid];
+    bool current = pid == service.Stats.Pid;
+    bool armWatchdog = false;
+    std::string trigger;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++service.Stats.Messages;
+        std::istringstream lines(message);
+        std::string line;
+        while (std::getline(lines, line)) {
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) {
+                continue;
+            }
+            std::string key = line.substr(0, eq);
+            std::string value = line.substr(eq + 1);
+            if (key == "READY" && value == "1") {
+                instance.Ready = true;
+                if (current) {
+                    service.Stats.Ready = true;
+                    service.Stats.State = "ready";
+                    armWatchdog = true;
+                }
+            } else if (!current) {
+                continue;  // Status of standby and surge instances is not tracked
+            } else if (key == "STATUS") {
+                service.Stats.Status = value;
+            } else if (key == "ERRNO") {
+                service.Stats.Errno = atoi(value.c_str());
+            } else if (key == "RELOADING" && value == "1") {
+                service.Stats.State = "reloading";
+            } else if (key == "STOPPING" && value == "1") {
+                service.Stats.State = "stopping";
+                service.Armed = false;  // A stopping service may stop pinging
+            } else if (key == "WATCHDOG" && value == "1") {
+                ++service.Stats.Pings;
+                service.Stats.LastPingMs = nowMs();
+                armWatchdog = service.Stats.State != "stopping";
+            } else if (key == "WATCHDOG" && value == "trigger") {
+                trigger = "requested a watchdog restart";
+            } else if (key == "WATCHDOG_USEC") {
+                service.Stats.WatchdogUs = atoll(value.c_str());
+                armWatchdog = service.Armed;
+            }
+        }
+    }
+
+    if (instance.Ready) {
+        auto waiters = std::move(instance.Waiters);
+        instance.Waiters.clear();
+        for (auto& waiter : waiters) {
+            waiter->set();
+        }
+    }
+    if (!trigger.empty()) {
+        missed(index, trigger);
+    } else if (armWatchdog) {
+        arm(index);
+    }
+}
+
+void NotifyMonitor::arm(size_t index) {
+    Service& service = services_[index];
+    int64_t intervalUs = service.Stats.WatchdogUs;
+    if (intervalUs <= 0) {
+        return;
+    }
+    service.Armed = true;
+    service.Deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(intervalUs);
+
+    // One pending check per service; pings only move the deadline
+    if (!service.TimerPending) {
+        service.TimerPending = true;
+        loop_.runAfter(std::chrono::milliseconds((intervalUs + 999) / 1000),
+                       [this, index]() { checkWatchdog(index); });
+    }
+}
+
+void NotifyMonitor::checkWatchdog(size_t index) {
+    Service& service = services_[index];
+    service.TimerPending = false;
+    sync(index);
+    if (!service.Armed) {
+        return;
+    }
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        service.Deadline - std::chrono::steady_clock::now());
+    if (left.count() > 0) {
+        service.TimerPending = true;
+        loop_.runAfter(left, [this, index]() { checkWatchdog(index); });
+        return;
+    }
+    char interval[32];
+    snprintf(interval, sizeof(interval), "%.1fs", service.Stats.WatchdogUs / 1e6);
+    missed(index, std::string("missed its watchdog deadline (") + interval + ")");
+}
+
+void NotifyMonitor::missed(size_t index, const std::string& reason) {
+    Service& service = services_[index];
+    service.Armed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++service.Stats.Misses;
+    }
+    command cmd = runner_.getCommand(index);
+    uint64_t operation = orchestrator_.submit(OperationKind::Restart, static_cast<int>(index));
+    events_.record(static_cast<int>(index), "notify.watchdog",
+                   cmd.Desc + " (PID " + std::to_string(cmd.Pid) + ") " + reason +
+                   ", restarting (operation " + std::to_string(operation) + ")");
+}
+
+void NotifyMonitor::prune() {
+    for (auto it = instances_.begin(); it != instances_.end();) {
+        if (it->second.Waiters.empty() && kill(it->first, 0) != 0 && errno == ESRCH) {
+            it = instances_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+Task<bool> NotifyMonitor::waitReady(size_t index, int pidfd, std::chrono::milliseconds timeout) {
+    pid_t pid = pidfd >= 0 ? pidfdPid(pidfd) : runner_.getPid(index);
+    if (pid <= 0) {
+        co_return false;
+    }
+    if (instances_.size() >= PRUNE_THRESHOLD) {
+        prune();
+    }
+    Instance& instance = instances_[pid];
+    instance.Service = index;
+    if (instance.Ready) {
+        co_return true;
+    }
+
+    // Woken by READY=1, or by the instance exiting or the timeout; whichever
+    // comes first, the other two are dropped right away
+    auto event = std::make_shared<AsyncEvent>();
+    instance.Waiters.push_back(event);
+    int timer = loop_.runAfter(timeout, [event]() { event->set(); });
+    int watchFd = pidfd >= 0 ? fcntl(pidfd, F_DUPFD_CLOEXEC, 0) : -1;
+    if (watchFd >= 0 && !loop_.watch(watchFd, [event](uint32_t) { event->set(); }, EVENT_READABLE)) {
+        close(watchFd);
+        watchFd = -1;
+    }
+    co_await event->wait();
+    loop_.cancelTimer(timer);
+    if (watchFd >= 0) {
+        loop_.unwatch(watchFd);
+        close(watchFd);
+    }
+
+    auto known = instances_.find(pid);
+    if (known == instances_.end()) {
+        co_return false;
+    }
+    auto& waiters = known->second.Waiters;
+    for (auto it = waiters.begin(); it != waiters.end(); ++it) {
+        if (*it == event) {
+            waiters.erase(it);
+            break;
+        }
+    }
+    co_return known->second.Ready;
+}
+
+NotifyStats NotifyMonitor::stats(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index < services_.size() ? services_[index].Stats : NotifyStats();
+}
@@ -0,0 +1,164 @@
+/**
+ * @file NotifyMonitor.hpp
+ * @brief sd_notify() readiness, status and watchdog protocol for managed services
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+class EventLog;
+
+/**
+ * @brief Notification state of one service exposed to the API
+ */
+struct NotifyStats {
+    bool        Enabled = false;   ///< "@notify" or "@watchdog" is set
+    pid_t       Pid = -1;          ///< Instance the state belongs to
+    bool        Ready = false;     ///< READY=1 received from the instance
+    std::string State;             ///< "starting", "ready", "reloading" or "stopping"
+    std::string Status;            ///< Latest STATUS= text
+    int         Errno = 0;         ///< Latest ERRNO= value
+    int64_t     WatchdogUs = 0;    ///< Watchdog interval (0 = none)
+    int64_t     LastPingMs = 0;    ///< Wall-clock time of the latest WATCHDOG=1 (0 = never)
+    uint64_t    Messages = 0;      ///< Datagrams accepted
+    uint64_t    Pings = 0;         ///< WATCHDOG=1 received
+    uint64_t    Misses = 0;        ///< Watchdog deadlines missed (each caused a restart)
+};
+
+/**
+ * @brief Receives sd_notify() datagrams from managed services
+ *
+ * Native services with "@notify=1" are started with NOTIFY_SOCKET pointing
+ * at one datagram socket shared by all services. The socket has
+ * SO_PASSCRED set, so the kernel attaches the sender's PID to every
+ * message; the PID (or the nearest ancestor that is a managed instance) tells
+ * which service and which instance sent it, and datagrams from other
+ * processes are ignored. Messages are consumed on the event loop:
+ *
+ * - READY=1 marks the instance ready; waitReady() returns as soon as it
+ *   arrives, so readiness costs no probing.
+ * - STATUS=, ERRNO=, RELOADING=1 and STOPPING=1 are kept for the API.
+ * - WATCHDOG=1 pings feed the watchdog of services with
+ *   "@watchdog=SECONDS" (which implies "@notify"). They also get
+ *   WATCHDOG_USEC and WATCHDOG_PID. The watchdog is armed by READY=1 or the
+ *   first ping; a missed deadline, or WATCHDOG=trigger, restarts the service
+ *   through the orchestrator. WATCHDOG_USEC= changes the interval.
+ */
+class NotifyMonitor {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Restarts services that miss their watchdog
+     * @param loop Loop the socket is watched on
+     * @param events Event log receiving watchdog events
+     * @param socketPath Socket address ("@name" for the abstract namespace)
+     */
+    NotifyMonitor(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop, EventLog& events,
+                  const std::string& socketPath);
+
+    /**
+     * @brief Destructor - closes (and for filesystem paths removes) the socket
+     */
+    ~NotifyMonitor();
+
+    NotifyMonitor(const NotifyMonitor&) = delete;
+    NotifyMonitor& operator=(const NotifyMonitor&) = delete;
+
+    /**
+     * @brief Bind the socket
+     * @return false if it could not be bound
+     */
+    bool open();
+
+    /**
+     * @brief Start consuming notifications (callable from any thread)
+     */
+    void start();
+
+    /**
+     * @brief Check whether a service is started with NOTIFY_SOCKET
+     * @param index Command index
+     */
+    bool enabled(size_t index) const;
+
+    /**
+     * @brief Get the initial watchdog interval of a service (0 = none)
+     * @param index Command index
+     */
+    std::chrono::microseconds watchdog(size_t index) const;
+
+    /**
+     * @brief Get the value passed as NOTIFY_SOCKET
+     */
+    const std::string& socketPath() const { return path_; }
+
+    /**
+     * @brief Wait until an instance sends READY=1
+     * @param index Command index
+     * @param pidfd pidfd of the instance (-1 = the service's current instance)
+     * @param timeout Give up after this long
+     * @return false if the instance exited or the timeout expired first
+     *
+     * Must be awaited on the loop thread.
+     */
+    Task<bool> waitReady(size_t index, int pidfd, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Get the notification state of a service
+     * @param index Command index
+     */
+    NotifyStats stats(size_t index) const;
+
+private:
+    /**
+     * @brief State of one instance (loop thread only)
+     */
+    struct Instance {
+        size_t Service = 0;
+        bool   Ready = false;
+        std::vector<std::shared_ptr<AsyncEvent>> Waiters;  ///< Set on READY=1
+    };
+
+    struct Service {
+        bool                      Enabled = false;
+        std::chrono::microseconds Watchdog{0};  ///< From "@watchdog"
+        bool                      Armed = false;        ///< Watchdog deadline active (loop thread only)
+        bool                      TimerPending = false; ///< A deadline check is scheduled (loop thread only)
+        std::chrono::steady_clock::time_point Deadline; ///< Loop thread only
+        NotifyStats               Stats;
+    };
+
+    ProcessRunner&       runner_;
+    Orchestrator&        orchestrator_;
+    EventLoop&           loop_;
+    EventLog&            events_;
+    std::string          path_;
+    int                  fd_ = -1;
+    mutable std::mutex   mutex_;  ///< Guards Stats of services_
+    std::vector<Service> services_;
+    std::map<pid_t, Instance> instances_;  ///< Instances heard from or waited for (loop thread only)
+
+    void receive();
+    void handle(pid_t sender, const std::string& message);
+    bool resolve(pid_t sender, size_t& index, pid_t& instance);
+    void sync(size_t index);
+    void arm(size_t index);
+    void checkWatchdog(size_t index);
+    void missed(size_t index, const std::string& reason);
+    void prune();
+};
@@ -0,0 +1,909 @@
+/**
+ * @file Orchestrator.cpp
+ * @brief Implementation of the coroutine-based service orchestration
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "Orchestrator.hpp"
+#include "AsyncOps.hpp"
+#include "ProcessRunner.hpp"
+#include "EventLog.hpp"
+#include "NotifyMonitor.hpp"
+#include "BootAnalyzer.hpp"
+#include "Prefetcher.hpp"
+
+#include <unistd.h>         // close, fork, execvp, symlink, unlink
+#include <sys/wait.h>       // WIFEXITED, WEXITSTATUS
+#include <cerrno>           // errno
+#include <cstdio>           // rename
+#include <cstring>          // strerror
+#include <algorithm>        // std::find_if
+#include <csignal>          // SIGKILL
+#include <sstream>          // std::istringstream
+
+namespace {
+
+constexpr size_t MAX_OPERATIONS = 256;
+constexpr std::chrono::milliseconds KILL_WAIT{5000};
+constexpr std::chrono::milliseconds DOCKER_GRACE{5000};
+constexpr std::chrono::milliseconds DOCKER_POLL{500};
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Parse a rollout budget
+ * @param text Absolute count ("2") or percentage of the group ("25%")
+ * @param members Group size
+ * @param roundUp Round percentages up instead of down
+ * @param value Receives the count
+ * @return false if the text is not a number
+ */
+bool parseBudget(const std::string& text, size_t members, bool roundUp, size_t& value) {
+    if (text.empty() || text.find_first_not_of("0123456789%") != std::string::npos ||
+        text.find('%') < text.size() - 1 || text == "%") {
+        return false;
+    }
+    unsigned long number = std::stoul(text);
+    if (text.back() == '%') {
+        unsigned long scaled = number * members;
+        value = roundUp ? (scaled + 99) / 100 : scaled / 100;
+    } else {
+        value = number;
+    }
+    return true;
+}
+
+std::chrono::milliseconds secondsOption(const command& cmd, const std::string& key,
+                                        std::chrono::milliseconds fallback) {
+    double seconds = cmd.optionNumber(key, fallback.count() / 1000.0);
+    return std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000));
+}
+
+} // namespace
+
+/**
+ * @brief Shared state of one boot operation
+ */
+struct Orchestrator::BootState {
+    std::vector<AsyncEvent> Ready;   ///< Set once a service is up (or has failed)
+    std::vector<bool>       Failed;  ///< Service (or one of its dependencies) failed
+    size_t                  Remaining = 0;
+    AsyncEvent              Done;    ///< Set when every service has finished
+};
+
+/**
+ * @brief Shared state of one rollout
+ */
+struct Orchestrator::RolloutState {
+    size_t     Unavailable = 0;  ///< Members currently replaced in place
+    size_t     Surging = 0;      ///< Members currently running a surge instance
+    size_t     InFlight = 0;
+    size_t     Completed = 0;
+    size_t     Failures = 0;
+    bool       Paused = false;
+    bool       Aborted = false;
+    AsyncEvent Wake;             ///< Set when a member finishes or the rollout is controlled
+};
+
+/**
+ * @brief Readiness of one instance, published to every waiter
+ */
+struct Orchestrator::ReadyProbe {
+    size_t     Index = 0;
+    int        Pidfd = -1;       ///< Tells a reused PID from the probed instance
+    bool       Ready = false;
+    AsyncEvent Done;             ///< Set when waitReady() has returned
+
+    ~ReadyProbe() {
+        if (Pidfd >= 0) {
+            close(Pidfd);
+        }
+    }
+};
+
+Orchestrator::Orchestrator(ProcessRunner& runner, EventLoop& loop, EventLog& events)
+    : runner_(runner), loop_(loop), events_(events) {
+    size_t count = runner_.getCommandCount();
+    plans_.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        command cmd = runner_.getCommand(i);
+        ServicePlan& plan = plans_[i];
+
+        plan.StopTimeout = secondsOption(cmd, "stop.timeout", plan.StopTimeout);
+        plan.ReadyDelay = secondsOption(cmd, "ready.delay", plan.ReadyDelay);
+        plan.ReadyTimeout = secondsOption(cmd, "ready.timeout", plan.ReadyTimeout);
+        plan.ReadyTcp = static_cast<uint16_t>(cmd.optionNumber("ready.tcp", 0));
+        // ServiceMN owns a "@listen" socket, so probing it says nothing about the instance
+        if (!cmd.option("listen").empty()) {
+            bool notify = cmd.option("notify") == "1" || cmd.optionNumber("watchdog", 0) > 0;
+            if (plan.ReadyTcp != 0 && plan.ReadyTcp == cmd.optionNumber("listen", 0)) {
+                events_.record(static_cast<int>(i), "orchestrate.config",
+                               "@ready.tcp on the @listen port is answered by ServiceMN's own socket "
+                               "and is ignored; use @notify or @ready.delay");
+                plan.ReadyTcp = 0;
+            } else if (!notify && plan.ReadyTcp == 0 && cmd.option("ready.delay").empty()) {
+                events_.record(static_cast<int>(i), "orchestrate.config",
+                               "@listen service without @notify or @ready.delay: instances count as "
+                               "ready after the default 1 s delay");
+            }
+        }
+        plan.SwapLink = cmd.option("swap.link");
+        plan.SwapTarget = cmd.option("swap.target");
+        plan.SwapWarmup = cmd.option("swap.warmup");
+        plan.SwapWarmupTimeout = secondsOption(cmd, "swap.warmup_timeout", plan.SwapWarmupTimeout);
+        plan.SwapDrain = secondsOption(cmd, "swap.drain", plan.SwapDrain);
+        if (!plan.SwapLink.empty() && plan.SwapTarget.empty()) {
+            events_.record(static_cast<int>(i), "orchestrate.config",
+                           "swap.link without swap.target is ignored");
+            plan.SwapLink.clear();
+        }
+        plan.Group = cmd.option("group");
+        if (!plan.Group.empty()) {
+            groups_[plan.Group].push_back(i);
+        }
+
+        std::istringstream after(cmd.option("after"));
+        std::string name;
+        while (std::getline(after, name, ',')) {
+            name.erase(0, name.find_first_not_of(" \t"));
+            name.erase(name.find_last_not_of(" \t") + 1);
+            if (name.empty()) {
+                continue;
+            }
+            size_t dependency = count;
+            for (size_t j = 0; j < count; ++j) {
+                if (runner_.getCommand(j).Desc == name) {
+                    dependency = j;
+                    break;
+                }
+            }
+            if (dependency == count && name.find_first_not_of("0123456789") == std::string::npos) {
+                dependency = std::stoul(name);
+            }
+            if (dependency >= count || dependency == i) {
+                events_.record(static_cast<int>(i), "orchestrate.config",
+                               "Ignoring unknown dependency '" + name + "'");
+                continue;
+            }
+            plan.After.push_back(dependency);
+        }
+    }
+
+    std::vector<size_t> order;
+    std::string error;
+    if (!bootOrder(-1, order, error)) {
+        events_.record(-1, "orchestrate.config", error);
+    }
+}
+
+bool Orchestrator::parseKind(const std::string& name, OperationKind& kind) {
+    if (name == "start") {
+        kind = OperationKind::Start;
+    } else if (name == "stop") {
+        kind = OperationKind::Stop;
+    } else if (name == "restart") {
+        kind = OperationKind::Restart;
+    } else if (name == "boot") {
+        kind = OperationKind::Boot;
+    } else if (name == "swap") {
+        kind = OperationKind::Swap;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* Orchestrator::kindName(OperationKind kind) {
+    switch (kind) {
+        case OperationKind::Start:   return "start";
+        case OperationKind::Stop:    return "stop";
+        case OperationKind::Restart: return "restart";
+        case OperationKind::Boot:    return "boot";
+        case OperationKind::Swap:    return "swap";
+        case OperationKind::Rollout: return "rollout";
+    }
+    return "unknown";
+}
+
+uint64_t Orchestrator::submit(OperationKind kind, int service) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = record(kind, service, "", 0);
+    }
+    loop_.post([this, id, kind, service]() { spawn(run(id, kind, service)); });
+    return id;
+}
+
+uint64_t Orchestrator::submitRollout(const std::string& group, const std::string& maxUnavailable,
+                                     const std::string& maxSurge, std::string& error) {
+    auto it = groups_.find(group);
+    if (it == groups_.end()) {
+        error = "Unknown group '" + group + "'";
+        return 0;
+    }
+    size_t members = it->second.size();
+    size_t unavailable = 0;
+    size_t surge = 0;
+    if (!parseBudget(maxUnavailable, members, false, unavailable) ||
+        !parseBudget(maxSurge, members, true, surge)) {
+        error = "maxUnavailable and maxSurge must be a count or a percentage";
+        return 0;
+    }
+    if (unavailable == 0 && surge == 0) {
+        error = "maxUnavailable and maxSurge cannot both be 0";
+        return 0;
+    }
+
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeGroups_.insert(group).second) {
+            error = "A rollout of group '" + group + "' is already in progress";
+            return 0;
+        }
+        id = record(OperationKind::Rollout, -1, group, members);
+    }
+    loop_.post([this, id, group, unavailable, surge]() {
+        spawn(runRollout(id, group, unavailable, surge));
+    });
+    return id;
+}
+
+bool Orchestrator::controlRollout(uint64_t id, bool resume) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(operations_.begin(), operations_.end(),
+                               [id](const Operation& operation) { return operation.Id == id; });
+        if (it == operations_.end() || it->Kind != OperationKind::Rollout || it->FinishedMs != 0) {
+            return false;
+        }
+    }
+    loop_.post([this, id, resume]() {
+        auto it = rollouts_.find(id);
+        if (it == rollouts_.end()) {
+            return;
+        }
+        RolloutState& state = *it->second;
+        if (resume) {
+            state.Paused = false;
+        } else {
+            state.Aborted = true;
+        }
+        state.Wake.set();
+    });
+    return true;
+}
+
+bool Orchestrator::rolloutActive(const std::string& group) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return activeGroups_.count(group) > 0;
+}
+
+bool Orchestrator::finished(uint64_t id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(operations_.begin(), operations_.end(),
+                           [id](const Operation& operation) { return operation.Id == id; });
+    return it == operations_.end() || it->FinishedMs != 0;
+}
+
+uint64_t Orchestrator::record(OperationKind kind, int service, const std::string& group, size_t total) {
+    Operation operation;
+    operation.Id = nextId_++;
+    operation.Kind = kind;
+    operation.Service = service;
+    operation.Group = group;
+    operation.Total = total;
+    operation.Step = "queued";
+    operation.StartedMs = nowMs();
+    operations_.push_back(operation);
+    while (operations_.size() > MAX_OPERATIONS) {
+        operations_.pop_front();
+    }
+    return operation.Id;
+}
+
+std::vector<Operation> Orchestrator::operations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<Operation>(operations_.begin(), operations_.end());
+}
+
+Task<void> Orchestrator::run(uint64_t id, OperationKind kind, int service) {
+    bool ok = false;
+    if (kind == OperationKind::Boot) {
+        ok = co_await boot(id, service);
+    } else if (service < 0 || static_cast<size_t>(service) >= plans_.size()) {
+        ok = fail(id, "Invalid process ID");
+    } else {
+        size_t index = static_cast<size_t>(service);
+        ok = true;
+        if (kind == OperationKind::Swap) {
+            ok = co_await swap(id, index);
+        }
+        if (kind == OperationKind::Stop || kind == OperationKind::Restart) {
+            ok = co_await stopService(id, index);
+        }
+        if (ok && (kind == OperationKind::Start || kind == OperationKind::Restart)) {
+            ok = co_await startService(id, index);
+        }
+    }
+    finish(id, ok);
+}
+
+Task<bool> Orchestrator::stopService(uint64_t id, size_t index) {
+    command cmd = runner_.getCommand(index);
+    if (!runner_.isRunning(index)) {
+        co_return true;
+    }
+    const ServicePlan& plan = plans_[index];
+    setStep(id, "stopping " + cmd.Desc);
+
+    if (cmd.Mode == 'D') {
+        // The daemon applies the SIGTERM -> SIGKILL escalation itself
+        std::string seconds = std::to_string(plan.StopTimeout.count() / 1000);
+        HttpReply reply = co_await dockerRequest(loop_, "POST",
+            "/containers/" + cmd.Path + "/stop?t=" + seconds, plan.StopTimeout + DOCKER_GRACE);
+        if (reply.Status != 204 && reply.Status != 304) {
+            co_return fail(id, "docker stop of " + cmd.Desc + " failed (HTTP " +
+                               std::to_string(reply.Status) + ")");
+        }
+        runner_.markDead(index);
+        co_return true;
+    }
+
+    // Open the pidfd before signalling so the exit cannot be missed
+    int pidfd = openPidfd(cmd.Pid);
+    if (!runner_.kill(index)) {
+        if (pidfd >= 0) {
+            close(pidfd);
+        }
+        co_return fail(id, "Failed to signal " + cmd.Desc);
+    }
+    if (pidfd < 0) {
+        co_return true;  // Already gone, or no pidfd support to wait with
+    }
+    bool exited = co_await awaitExit(id, index, pidfd);
+    close(pidfd);
+    co_return exited;
+}
+
+Task<bool> Orchestrator::awaitExit(uint64_t id, size_t index, int pidfd) {
+    const ServicePlan& plan = plans_[index];
+    std::string name = runner_.getCommand(index).Desc;
+    setStep(id, "waiting for " + name + " to exit");
+    if (co_await childExit(loop_, pidfd, plan.StopTimeout)) {
+        co_return true;
+    }
+    events_.record(static_cast<int>(index), "orchestrate.kill",
+                   "No exit within " + std::to_string(plan.StopTimeout.count()) +
+                   " ms of SIGTERM, sending SIGKILL");
+    setStep(id, "killing " + name);
+    signalPidfd(pidfd, SIGKILL);
+    if (co_await childExit(loop_, pidfd, KILL_WAIT)) {
+        co_return true;
+    }
+    co_return fail(id, name + " did not exit after SIGKILL");
+}
+
+Task<bool> Orchestrator::startService(uint64_t id, size_t index) {
+    command cmd = runner_.getCommand(index);
+    if (runner_.isRunning(index)) {
+        co_return true;
+    }
+    setStep(id, "starting " + cmd.Desc);
+    pid_t pid = co_await runner_.startAsync(index);
+    if (pid < 0) {
+        co_return fail(id, "Failed to start " + cmd.Desc);
+    }
+
+    setStep(id, "waiting for " + cmd.Desc + " to become ready");
+    bool ready = co_await instanceReady(index, pid);
+    if (!ready) {
+        co_return fail(id, cmd.Desc + " did not become ready");
+    }
+    events_.record(static_cast<int>(index), "orchestrate.ready", cmd.Desc + " is ready");
+    if (prefetcher_) {
+        prefetcher_->record(index, pid);
+    }
+    if (!plans_[index].SwapLink.empty()) {
+        co_return switchLink(id, index, runner_.color(index));
+    }
+    co_return true;
+}
+
+Task<bool> Orchestrator::waitReady(size_t index, command cmd, int pidfd) {
+    const ServicePlan& plan = plans_[index];
+    auto deadline = std::chrono::steady_clock::now() + plan.ReadyTimeout;
+
+    if (cmd.Mode == 'D') {
+        while (std::chrono::steady_clock::now() < deadline) {
+            HttpReply reply = co_await dockerRequest(loop_, "GET", "/containers/" + cmd.Path + "/json",
+                                                       DOCKER_GRACE);
+            if (reply.Status == 200 && reply.Body.find("\"Running\":true") != std::string::npos) {
+                co_return true;
+            }
+            co_await sleepFor(loop_, DOCKER_POLL);
+        }
+        co_return false;
+    }
+
+    // sd_notify() services say when they are ready; nothing to probe
+    if (notify_ && notify_->enabled(index)) {
+        co_return co_await notify_->waitReady(index, pidfd, plan.ReadyTimeout);
+    }
+
+    if (plan.ReadyTcp != 0) {
+        bool ready = co_await tcpReady(loop_, plan.ReadyTcp, plan.ReadyTimeout);
+        co_return ready && (pidfd < 0 || !pidfdExited(pidfd));
+    }
+
+    // Without a probe the process only has to survive the ready delay
+    if (pidfd < 0) {
+        co_await sleepFor(loop_, plan.ReadyDelay);
+        co_return runner_.isRunning(index);
+    }
+    co_return !co_await childExit(loop_, pidfd, plan.ReadyDelay);
+}
+
+Task<bool> Orchestrator::instanceReady(size_t index, pid_t pid) {
+    // Finished probes of instances that exited are dropped; their PIDs may be reused
+    for (auto it = probes_.begin(); it != probes_.end();) {
+        const ReadyProbe& known = *it->second;
+        bool stale = known.Pidfd < 0 || pidfdExited(known.Pidfd);
+        it = known.Done.isSet() && stale ? probes_.erase(it) : std::next(it);
+    }
+
+    auto it = probes_.find(pid);
+    std::shared_ptr<ReadyProbe> shared;
+    if (it != probes_.end() && it->second->Index == index) {
+        shared = it->second;
+    } else {
+        shared = std::make_shared<ReadyProbe>();
+        shared->Index = index;
+        shared->Pidfd = runner_.getCommand(index).native() ? openPidfd(pid) : -1;
+        probes_[pid] = shared;
+        spawn(runProbe(index, shared));
+    }
+    co_await shared->Done.wait();
+    co_return shared->Ready;
+}
+
+Task<void> Orchestrator::runProbe(size_t index, std::shared_ptr<ReadyProbe> probe) {
+    probe->Ready = co_await waitReady(index, runner_.getCommand(index), probe->Pidfd);
+    probe->Done.set();
+}
+
+Task<bool> Orchestrator::boot(uint64_t id, int service) {
+    std::vector<size_t> order;
+    std::string error;
+    if (service >= static_cast<int>(plans_.size())) {
+        co_return fail(id, "Invalid process ID");
+    }
+    if (!bootOrder(service, order, error)) {
+        co_return fail(id, error);
+    }
+    if (prefetcher_) {
+        prefetcher_->prefetch(order);
+    }
+
+    if (analyzer_) {
+        std::vector<std::vector<size_t>> after;
+        for (const ServicePlan& plan : plans_) {
+            after.push_back(plan.After);
+        }
+        analyzer_->begin(id, service, order, after);
+    }
+
+    BootState state;
+    state.Ready = std::vector<AsyncEvent>(plans_.size());
+    state.Failed.assign(plans_.size(), false);
+    state.Remaining = order.size();
+    for (size_t index : order) {
+        spawn(bootService(id, index, state));
+    }
+    co_await state.Done.wait();
+
+    std::string failed;
+    for (size_t index : order) {
+        if (state.Failed[index]) {
+            failed += (failed.empty() ? "" : ", ") + runner_.getCommand(index).Desc;
+        }
+    }
+    if (analyzer_) {
+        analyzer_->end(id, failed.empty());
+    }
+    if (!failed.empty()) {
+        co_return fail(id, "Not started: " + failed);
+    }
+    co_return true;
+}
+
+Task<void> Orchestrator::bootService(uint64_t id, size_t index, BootState& state) {
+    bool ok = true;
+    for (size_t dependency : plans_[index].After) {
+        co_await state.Ready[dependency].wait();
+        ok = ok && !state.Failed[dependency];
+    }
+    bool skipped = !ok;
+    if (ok) {
+        if (analyzer_) {
+            analyzer_->starting(id, index, runner_.isRunning(index));
+        }
+        ok = co_await startService(id, index);
+    }
+    if (analyzer_) {
+        analyzer_->finished(id, index, ok, skipped);
+    }
+    state.Failed[index] = !ok;
+    state.Ready[index].set();
+    if (--state.Remaining == 0) {
+        state.Done.set();
+    }
+}
+
+Task<void> Orchestrator::runRollout(uint64_t id, std::string group, size_t maxUnavailable,
+                                    size_t maxSurge) {
+    bool ok = co_await rollout(id, group, maxUnavailable, maxSurge);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        activeGroups_.erase(group);
+    }
+    finish(id, ok);
+}
+
+Task<bool> Orchestrator::rollout(uint64_t id, std::string group, size_t maxUnavailable,
+                                 size_t maxSurge) {
+    const std::vector<size_t>& members = groups_[group];
+    RolloutState state;
+    rollouts_[id] = &state;
+    events_.record(-1, "rollout.start", "Rolling out group " + group + " (" +
+                   std::to_string(members.size()) + " members, maxUnavailable " +
+                   std::to_string(maxUnavailable) + ", maxSurge " + std::to_string(maxSurge) + ")");
+
+    size_t next = 0;
+    for (;;) {
+        state.Wake.reset();
+        while (!state.Paused && !state.Aborted && next < members.size()) {
+            size_t index = members[next];
+            bool surge = state.Surging < maxSurge && runner_.getCommand(index).native();
+            // Docker members cannot surge; without an unavailability budget
+            // they are replaced one at a time once nothing else is in flight
+            bool inPlace = state.Unavailable < maxUnavailable ||
+                           (maxUnavailable == 0 && state.InFlight == 0);
+            if (!surge && !inPlace) {
+                break;
+            }
+            ++(surge ? state.Surging : state.Unavailable);
+            ++state.InFlight;
+            ++next;
+            spawn(rolloutMember(id, index, surge, state));
+        }
+        if (state.InFlight == 0 && (state.Aborted || next == members.size())) {
+            break;
+        }
+        if (state.InFlight == 0 && state.Paused) {
+            setProgress(id, state.Completed, "paused");
+        }
+        co_await state.Wake.wait();
+        if (!state.Paused && !state.Aborted) {
+            setProgress(id, state.Completed, "running");
+        }
+    }
+    rollouts_.erase(id);
+
+    if (state.Aborted) {
+        co_return fail(id, "Aborted after " + std::to_string(state.Completed) + " of " +
+                           std::to_string(members.size()) + " members");
+    }
+    co_return state.Failures == 0;
+}
+
+Task<void> Orchestrator::rolloutMember(uint64_t id, size_t index, bool surge, RolloutState& state) {
+    bool ok;
+    if (surge) {
+        ok = co_await surgeReplace(id, index);
+    } else {
+        ok = co_await stopService(id, index);
+        if (ok) {
+            ok = co_await startService(id, index);
+        }
+    }
+    --(surge ? state.Surging : state.Unavailable);
+    --state.InFlight;
+
+    std::string name = runner_.getCommand(index).Desc;
+    if (ok) {
+        ++state.Completed;
+        setProgress(id, state.Completed, "");
+        events_.record(static_cast<int>(index), "rollout.progress",
+                       name + " replaced (" + std::to_string(state.Completed) + " done)");
+    } else {
+        ++state.Failures;
+        if (!state.Paused) {
+            state.Paused = true;
+            events_.record(static_cast<int>(index), "rollout.pause",
+                           "Replacing " + name + " failed, rollout " + std::to_string(id) + " paused");
+        }
+    }
+    state.Wake.set();
+}
+
+Task<bool> Orchestrator::surgeReplace(uint64_t id, size_t index) {
+    command cmd = runner_.getCommand(index);
+    bool running = runner_.isRunning(index);
+    int oldPidfd = running ? openPidfd(cmd.Pid) : -1;
+
+    setStep(id, "surging " + cmd.Desc);
+    pid_t pid = running ? runner_.startSurge(index) : co_await runner_.startAsync(index);
+    int pidfd = pid > 0 ? openPidfd(pid) : -1;
+    if (pidfd < 0) {
+        if (oldPidfd >= 0) {
+            close(oldPidfd);
+        }
+        co_return fail(id, "Failed to start a new instance of " + cmd.Desc);
+    }
+
+    setStep(id, "waiting for " + cmd.Desc + " to become ready");
+    if (!co_await instanceReady(index, pid)) {
+        // The current instance keeps serving; retire the new one
+        if (running) {
+            signalPidfd(pidfd, SIGTERM);
+            co_await awaitExit(id, index, pidfd);
+        }
+        close(pidfd);
+        if (oldPidfd >= 0) {
+            close(oldPidfd);
+        }
+        co_return fail(id, "New instance of " + cmd.Desc + " did not become ready");
+    }
+    close(pidfd);
+    events_.record(static_cast<int>(index), "orchestrate.ready", cmd.Desc + " is ready");
+    if (!running) {
+        co_return true;
+    }
+
+    runner_.promote(index, pid);
+    if (oldPidfd < 0) {
+        co_return true;  // The old instance is already gone
+    }
+    signalPidfd(oldPidfd, SIGTERM);
+    bool exited = co_await awaitExit(id, index, oldPidfd);
+    close(oldPidfd);
+    co_return exited;
+}
+
+Task<bool> Orchestrator::swap(uint64_t id, size_t index) {
+    command cmd = runner_.getCommand(index);
+    const ServicePlan& plan = plans_[index];
+    if (!cmd.native()) {
+        co_return fail(id, "Swap is only supported for native services");
+    }
+    if (!runner_.isRunning(index)) {
+        co_return fail(id, cmd.Desc + " is not running");
+    }
+
+    int oldPidfd = openPidfd(cmd.Pid);
+    std::string color = std::string(runner_.color(index)) == "blue" ? "green" : "blue";
+    setStep(id, "starting the " + color + " instance of " + cmd.Desc);
+    pid_t pid = runner_.startSurge(index, true);
+    int pidfd = pid > 0 ? openPidfd(pid) : -1;
+    if (pidfd < 0) {
+        runner_.releaseSwapListener(index);
+        if (oldPidfd >= 0) {
+            close(oldPidfd);
+        }
+        co_return fail(id, "Failed to start the " + color + " instance of " + cmd.Desc);
+    }
+
+    setStep(id, "waiting for the " + color + " instance to become ready");
+    bool ok = co_await instanceReady(index, pid);
+    if (!ok) {
+        fail(id, "The " + color + " instance of " + cmd.Desc + " did not become ready");
+    }
+    if (ok && !plan.SwapWarmup.empty()) {
+        setStep(id, "warming up the " + color + " instance");
+        ok = co_await warmUp(id, index, pid, color);
+    }
+    if (ok && !plan.SwapLink.empty()) {
+        ok = switchLink(id, index, color);
+    }
+    if (!ok) {
+        // The old instance keeps serving
+        runner_.releaseSwapListener(index);
+        signalPidfd(pidfd, SIGTERM);
+        co_await awaitExit(id, index, pidfd);
+        close(pidfd);
+        if (oldPidfd >= 0) {
+            close(oldPidfd);
+        }
+        co_return false;
+    }
+    close(pidfd);
+
+    runner_.promote(index, pid);
+    events_.record(static_cast<int>(index), "swap.switch",
+                   cmd.Desc + " switched to the " + color + " instance (PID " + std::to_string(pid) + ")");
+    if (oldPidfd < 0) {
+        runner_.releaseSwapListener(index);
+        co_return true;
+    }
+    setStep(id, "draining the old instance of " + cmd.Desc);
+    co_await sleepFor(loop_, plan.SwapDrain);
+    runner_.releaseSwapListener(index);
+    signalPidfd(oldPidfd, SIGTERM);
+    bool exited = co_await awaitExit(id, index, oldPidfd);
+    close(oldPidfd);
+    co_return exited;
+}
+
+Task<bool> Orchestrator::warmUp(uint64_t id, size_t index, pid_t instance, std::string color) {
+    command cmd = runner_.getCommand(index);
+    const ServicePlan& plan = plans_[index];
+    auto parts = ProcessRunner::splitCommand(plan.SwapWarmup);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        co_return fail(id, "Failed to fork the warm-up command");
+    }
+    if (pid == 0) {
+        if (!cmd.Folder.empty() && cmd.Folder != "." && chdir(cmd.Folder.c_str()) != 0) {
+            _exit(127);
+        }
+        setenv("SERVICEMN_COLOR", color.c_str(), 1);
+        setenv("SERVICEMN_PID", std::to_string(instance).c_str(), 1);
+        std::vector<char*> argv;
+        for (auto& part : parts) {
+            argv.push_back(const_cast<char*>(part.c_str()));
+        }
+        argv.push_back(nullptr);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int pidfd = openPidfd(pid);
+    bool exited = pidfd >= 0 && co_await childExit(loop_, pidfd, plan.SwapWarmupTimeout);
+    if (!exited && pidfd >= 0) {
+        signalPidfd(pidfd, SIGKILL);
+        co_await childExit(loop_, pidfd, KILL_WAIT);
+    }
+    if (pidfd >= 0) {
+        close(pidfd);
+    }
+    if (!exited) {
+        co_return fail(id, "Warm-up of " + cmd.Desc + " timed out");
+    }
+    int status = 0;
+    if (!runner_.exitStatus(pid, status) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        co_return fail(id, "Warm-up of " + cmd.Desc + " failed (status " +
+                           std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1) + ")");
+    }
+    co_return true;
+}
+
+bool Orchestrator::switchLink(uint64_t id, size_t index, const std::string& color) {
+    const ServicePlan& plan = plans_[index];
+    std::string target = plan.SwapTarget;
+    size_t placeholder = target.find("{color}");
+    if (placeholder != std::string::npos) {
+        target.replace(placeholder, 7, color);
+    }
+
+    // rename() over the old link is atomic: readers see either target, never neither
+    std::string temporary = plan.SwapLink + ".swap";
+    unlink(temporary.c_str());
+    if (symlink(target.c_str(), temporary.c_str()) != 0 ||
+        rename(temporary.c_str(), plan.SwapLink.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return fail(id, "Failed to point " + plan.SwapLink + " at " + target + ": " + strerror(errno));
+    }
+    return true;
+}
+
+bool Orchestrator::bootOrder(int service, std::vector<size_t>& order, std::string& error) const {
+    // Depth-first walk; a service seen again while still on the path closes a cycle
+    enum Mark { Unvisited, Visiting, Visited };
+    std::vector<Mark> marks(plans_.size(), Unvisited);
+    std::vector<std::pair<size_t, size_t>> stack;  // (service, next dependency)
+
+    auto visit = [&](size_t root) {
+        if (marks[root] != Unvisited) {
+            return true;
+        }
+        marks[root] = Visiting;
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            const auto& after = plans_[top.first].After;
+            if (top.second == after.size()) {
+                marks[top.first] = Visited;
+                order.push_back(top.first);
+                stack.pop_back();
+                continue;
+            }
+            size_t dependency = after[top.second++];
+            if (marks[dependency] == Visiting) {
+                error = "Dependency cycle through " + runner_.getCommand(dependency).Desc;
+                return false;
+            }
+            if (marks[dependency] == Unvisited) {
+                marks[dependency] = Visiting;
+                stack.push_back({dependency, 0});
+            }
+        }
+        return true;
+    };
+
+    if (service >= 0) {
+        return visit(static_cast<size_t>(service));
+    }
+    for (size_t i = 0; i < plans_.size(); ++i) {
+        if (!visit(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Orchestrator::setStep(uint64_t id, const std::string& step) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& operation : operations_) {
+        if (operation.Id == id) {
+            operation.Step = step;
+            return;
+        }
+    }
+}
+
+void Orchestrator::setProgress(uint64_t id, size_t completed, const std::string& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& operation : operations_) {
+        if (operation.Id == id) {
+            operation.Completed = completed;
+            if (!state.empty()) {
+                operation.State = state;
+            }
+            return;
+        }
+    }
+}
+
+bool Orchestrator::fail(uint64_t id, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& operation : operations_) {
+        if (operation.Id == id) {
+            operation.Message += (operation.Message.empty() ? "" : "; ") + message;
+            break;
+        }
+    }
+    return false;
+}
+
+void Orchestrator::finish(uint64_t id, bool ok) {
+    Operation finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& operation : operations_) {
+            if (operation.Id == id) {
+                operation.State = ok ? "done" : "failed";
+                operation.Step.clear();
+                operation.FinishedMs = nowMs();
+                finished = operation;
+                break;
+            }
+        }
+    }
+    if (finished.Id == 0) {
+        return;  // Already rotated out of the history
+    }
+    std::string message = std::string(kindName(finished.Kind)) + " operation " + std::to_string(id) +
+                          (ok ? " completed" : " failed");
+    if (!ok && !finished.Message.empty()) {
+        message += ": " + finished.Message;
+    }
+    events_.record(finished.Service, ok ? "orchestrate.done" : "orchestrate.failed", message);
+}
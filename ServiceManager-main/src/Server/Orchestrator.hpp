@@ -0,0 +1,264 @@
+/**
+ * @file Orchestrator.hpp
+ * @brief Multi-step service operations as coroutines on the event loop
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+#include "command.hpp"
+
+class ProcessRunner;
+class EventLog;
+class NotifyMonitor;
+class BootAnalyzer;
+class Prefetcher;
+
+/**
+ * @brief Kind of orchestrated operation
+ */
+enum class OperationKind {
+    Start,    ///< Start and wait until ready
+    Stop,     ///< SIGTERM (docker stop), wait, escalate to SIGKILL
+    Restart,  ///< Stop followed by Start
+    Boot,     ///< Start a service set in dependency order
+    Swap,     ///< Blue/green replacement of a running service
+    Rollout   ///< Replace the members of a service group within budgets
+};
+
+/**
+ * @brief Progress of one operation
+ */
+struct Operation {
+    uint64_t      Id = 0;
+    OperationKind Kind = OperationKind::Start;
+    int           Service = -1;      ///< Command index (-1 = all services or a group)
+    std::string   Group;             ///< Service group (rollout only)
+    std::string   State = "running"; ///< "running", "paused", "done" or "failed"
+    std::string   Step;              ///< Step currently being awaited
+    std::string   Message;           ///< Failure reason
+    size_t        Completed = 0;     ///< Members replaced so far (rollout only)
+    size_t        Total = 0;         ///< Members in the group (rollout only)
+    int64_t       StartedMs = 0;     ///< Wall-clock submission time
+    int64_t       FinishedMs = 0;    ///< Wall-clock completion time (0 while running)
+};
+
+/**
+ * @brief Per-service orchestration settings
+ *
+ * Read from the service's options:
+ * - group         service group used by rollouts
+ * - after         comma-separated services (names or indices) started first by boot
+ * - stop.timeout  seconds between SIGTERM and SIGKILL
+ * - ready.tcp     port on 127.0.0.1 that accepts connections once ready
+ * - ready.delay   seconds the process must survive to count as ready (no probe)
+ * - ready.timeout seconds to wait for readiness
+ * - notify        "1" to take readiness from READY=1 (see NotifyMonitor)
+ * - swap.link     symlink switched to the new instance by a swap
+ * - swap.target   link target; "{color}" is replaced with blue or green
+ * - swap.warmup   command run against the new instance before switching
+ * - swap.warmup_timeout seconds the warm-up command may take
+ * - swap.drain    seconds the old instance keeps running after the switch
+ */
+struct ServicePlan {
+    std::string               Group;
+    std::vector<size_t>       After;
+    std::chrono::milliseconds StopTimeout{10000};
+    uint16_t                  ReadyTcp = 0;
+    std::chrono::milliseconds ReadyDelay{1000};
+    std::chrono::milliseconds ReadyTimeout{30000};
+    std::string               SwapLink;
+    std::string               SwapTarget;
+    std::string               SwapWarmup;
+    std::chrono::milliseconds SwapWarmupTimeout{60000};
+    std::chrono::milliseconds SwapDrain{5000};
+};
+
+/**
+ * @brief Runs restarts, graceful stops and dependency boots
+ *
+ * Each operation is a coroutine on the shared event loop: waiting for an
+ * exit (pidfd), a probe, a timer or a Docker API reply suspends it instead
+ * of holding a thread, so any number of operations proceed concurrently on
+ * the loop thread. Boot starts every service as soon as the services it
+ * depends on are ready, so independent branches come up in parallel.
+ *
+ * A rollout replaces the members of a group while keeping at most
+ * maxUnavailable of them down and at most maxSurge extra instances running.
+ * A surged member gets a second instance that replaces the current one once
+ * ready; other members are stopped and started in place. The first failure
+ * pauses the rollout until it is resumed or aborted.
+ *
+ * A swap starts the other color of a service next to the running one,
+ * waits until it is ready, runs the warm-up command, then switches the
+ * "@swap.link" symlink to it and drains the old instance. Services with a
+ * "@listen" socket get a second listener on the same port for the new
+ * instance; connections are steered to it only at the switch, and the old
+ * listener is shut down once the drain ends.
+ */
+class Orchestrator {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param loop Loop the operations run on
+     * @param events Event log receiving operation results
+     */
+    Orchestrator(ProcessRunner& runner, EventLoop& loop, EventLog& events);
+
+    /**
+     * @brief Take readiness of "@notify" services from their READY=1 message
+     * @param notify Notification receiver (nullptr uses the probes)
+     */
+    void setNotifyMonitor(NotifyMonitor* notify) { notify_ = notify; }
+
+    /**
+     * @brief Record the timeline of every boot
+     * @param analyzer Boot recorder (nullptr = none)
+     */
+    void setBootAnalyzer(BootAnalyzer* analyzer) { analyzer_ = analyzer; }
+
+    /**
+     * @brief Record working sets on readiness and prefetch them when a boot begins
+     * @param prefetcher Page-cache prefetcher (nullptr = none)
+     */
+    void setPrefetcher(Prefetcher* prefetcher) { prefetcher_ = prefetcher; }
+
+    /**
+     * @brief Queue an operation (callable from any thread)
+     * @param kind Operation kind
+     * @param service Command index (-1 = all services, boot only)
+     * @return Operation ID
+     */
+    uint64_t submit(OperationKind kind, int service);
+
+    /**
+     * @brief Queue a rolling restart of a service group (callable from any thread)
+     * @param group Value of the members' "@group" option
+     * @param maxUnavailable Members that may be down at once ("2" or "25%", rounded down)
+     * @param maxSurge Extra instances allowed at once ("1" or "25%", rounded up)
+     * @param error Receives the reason when the rollout is rejected
+     * @return Operation ID, or 0 if the rollout was rejected
+     */
+    uint64_t submitRollout(const std::string& group, const std::string& maxUnavailable,
+                           const std::string& maxSurge, std::string& error);
+
+    /**
+     * @brief Resume or abort a paused rollout (callable from any thread)
+     * @param id Operation ID of the rollout
+     * @param resume true to continue with the next members, false to abort
+     * @return false if the operation is not a rollout in progress
+     */
+    bool controlRollout(uint64_t id, bool resume);
+
+    /**
+     * @brief Check whether a rollout of a group is in progress (callable from any thread)
+     * @param group Value of the members' "@group" option
+     */
+    bool rolloutActive(const std::string& group) const;
+
+    /**
+     * @brief Check whether an operation has finished (callable from any thread)
+     * @param id Operation ID
+     * @return true if the operation completed or is no longer tracked
+     */
+    bool finished(uint64_t id) const;
+
+    /**
+     * @brief Get recent operations, oldest first
+     */
+    std::vector<Operation> operations() const;
+
+    /**
+     * @brief Wait until a new instance of a service is ready
+     * @param index Command index
+     * @param cmd Command of the instance
+     * @param pidfd pidfd of the instance (-1 if unavailable)
+     * @return true once the service's readiness check passed
+     *
+     * Must be awaited on the loop thread.
+     */
+    Task<bool> waitReady(size_t index, command cmd, int pidfd);
+
+    /**
+     * @brief Wait until an instance is ready, sharing one probe among all waiters
+     * @param index Command index
+     * @param pid Instance to wait for
+     * @return true once the service's readiness check passed for the instance
+     *
+     * The first caller for a PID runs waitReady(); later callers await its
+     * result, which stays published while the instance lives. The
+     * orchestrator, the warm pool, the status page, the startup boost and the
+     * checkpointer therefore probe each start once. Must be awaited on the
+     * loop thread.
+     */
+    Task<bool> instanceReady(size_t index, pid_t pid);
+
+    /**
+     * @brief Parse an operation name
+     * @param name "start", "stop", "restart", "boot" or "swap"
+     * @param kind Receives the parsed kind
+     * @return false if the name is unknown
+     */
+    static bool parseKind(const std::string& name, OperationKind& kind);
+
+    /**
+     * @brief Name of an operation kind
+     */
+    static const char* kindName(OperationKind kind);
+
+private:
+    struct BootState;
+    struct RolloutState;
+    struct ReadyProbe;
+
+    ProcessRunner&           runner_;
+    EventLoop&               loop_;
+    EventLog&                events_;
+    NotifyMonitor*           notify_ = nullptr;
+    BootAnalyzer*            analyzer_ = nullptr;
+    Prefetcher*              prefetcher_ = nullptr;
+    std::vector<ServicePlan> plans_;
+    std::map<std::string, std::vector<size_t>> groups_;  ///< Members by group name
+    mutable std::mutex       mutex_;       ///< Guards operations_, nextId_ and activeGroups_
+    std::deque<Operation>    operations_;  ///< Recent operations, oldest first
+    uint64_t                 nextId_ = 1;
+    std::set<std::string>    activeGroups_;  ///< Groups with a rollout in progress
+    std::map<uint64_t, RolloutState*> rollouts_;  ///< Running rollouts (loop thread only)
+    std::map<pid_t, std::shared_ptr<ReadyProbe>> probes_;  ///< Readiness by instance (loop thread only)
+
+    Task<void> run(uint64_t id, OperationKind kind, int service);
+    Task<bool> startService(uint64_t id, size_t index);
+    Task<bool> stopService(uint64_t id, size_t index);
+    Task<bool> awaitExit(uint64_t id, size_t index, int pidfd);
+    Task<bool> boot(uint64_t id, int service);
+    Task<void> bootService(uint64_t id, size_t index, BootState& state);
+    Task<void> runRollout(uint64_t id, std::string group, size_t maxUnavailable, size_t maxSurge);
+    Task<bool> rollout(uint64_t id, std::string group, size_t maxUnavailable, size_t maxSurge);
+    Task<void> rolloutMember(uint64_t id, size_t index, bool surge, RolloutState& state);
+    Task<bool> surgeReplace(uint64_t id, size_t index);
+    Task<bool> swap(uint64_t id, size_t index);
+    Task<bool> warmUp(uint64_t id, size_t index, pid_t instance, std::string color);
+    Task<void> runProbe(size_t index, std::shared_ptr<ReadyProbe> probe);
+
+    bool switchLink(uint64_t id, size_t index, const std::string& color);
+    bool bootOrder(int service, std::vector<size_t>& order, std::string& error) const;
+    uint64_t record(OperationKind kind, int service, const std::string& group, size_t total);
+    void setStep(uint64_t id, const std::string& step);
+    void setProgress(uint64_t id, size_t completed, const std::string& state);
+    bool fail(uint64_t id, const std::string& message);
+    void finish(uint64_t id, bool ok);
+};
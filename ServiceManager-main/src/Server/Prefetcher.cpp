@@ -0,0 +1,257 @@
+/**
+ * @file Prefetcher.cpp
+ * @brief Implementation of the boot page-cache prefetcher
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "Prefetcher.hpp"
+#include "ProcessRunner.hpp"
+
+#include <fcntl.h>          // open, posix_fadvise, POSIX_FADV_WILLNEED
+#include <unistd.h>         // close
+#include <sys/stat.h>       // fstat, S_ISREG
+#include <algorithm>        // std::min
+#include <cerrno>           // errno, ENOENT
+#include <chrono>           // std::chrono::steady_clock
+#include <cstdio>           // std::rename
+#include <fstream>          // std::ifstream, std::ofstream
+#include <iostream>         // std::cerr
+#include <sstream>          // std::istringstream
+
+namespace {
+
+constexpr const char* DELETED_SUFFIX = " (deleted)";
+constexpr const char* SKIPPED_PREFIXES[] = {"/dev/", "/proc/", "/sys/", "/memfd:"};
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+Prefetcher::Prefetcher(ProcessRunner& runner, std::string path)
+    : runner_(runner), path_(std::move(path)) {
+}
+
+Prefetcher::~Prefetcher() {
+    stop();
+}
+
+bool Prefetcher::open() {
+    if (!load()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+    thread_ = std::thread(&Prefetcher::run, this);
+    return true;
+}
+
+void Prefetcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        boots_.clear();  // Nothing left to start; only the recorded sets are saved
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Prefetcher::record(size_t index, pid_t pid) {
+    command cmd = runner_.getCommand(index);
+    // A sandboxed service's PID is its supervisor, a fork of ServiceMN
+    if (cmd.Mode != 'C' || pid <= 0) {
+        return;
+    }
+
+    // "<start>-<end> <perms> <offset> <dev> <inode>   <path>": the path is the first '/'
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::set<std::string> seen;
+    std::vector<std::string> files;
+    std::string line;
+    while (files.size() < MAX_FILES && std::getline(maps, line)) {
+        auto slash = line.find('/');
+        if (slash == std::string::npos) {
+            continue;  // Anonymous, [heap], [stack], [vdso]
+        }
+        std::string file = line.substr(slash);
+        if (endsWith(file, DELETED_SUFFIX)) {
+            continue;
+        }
+        bool skipped = false;
+        for (const char* prefix : SKIPPED_PREFIXES) {
+            skipped = skipped || file.rfind(prefix, 0) == 0;
+        }
+        if (!skipped && seen.insert(file).second) {
+            files.push_back(file);
+        }
+    }
+    if (files.empty()) {
+        return;  // Exited meanwhile; keep the previous set
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string>& current = recorded_[cmd.Desc];
+    if (current != files) {
+        current = std::move(files);
+        dirty_ = true;
+        wakeup_.notify_one();
+    }
+}
+
+void Prefetcher::prefetch(const std::vector<size_t>& order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        boots_.push_back(order);
+        wakeup_.notify_one();
+    }
+}
+
+PrefetchSet Prefetcher::set(size_t index) const {
+    command cmd = runner_.getCommand(index);
+    PrefetchSet set;
+    set.Configured = configured(cmd.option("prefetch.files"));
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = recorded_.find(cmd.Desc);
+    if (it != recorded_.end()) {
+        set.Recorded = it->second;
+    }
+    return set;
+}
+
+PrefetchStats Prefetcher::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void Prefetcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wakeup_.wait(lock, [this] { return !running_ || !boots_.empty() || dirty_; });
+        if (!boots_.empty()) {
+            std::vector<size_t> order = std::move(boots_.front());
+            boots_.pop_front();
+            lock.unlock();
+            prefetchBoot(order);
+            lock.lock();
+        } else if (dirty_) {
+            auto recorded = recorded_;
+            dirty_ = false;
+            lock.unlock();
+            bool saved = save(recorded);
+            lock.lock();
+            if (!saved) {
+                std::cerr << "Prefetcher: cannot save " << path_ << std::endl;
+            }
+        } else {
+            return;  // Stopped and saved
+        }
+    }
+}
+
+void Prefetcher::prefetchBoot(const std::vector<size_t>& order) {
+    auto start = std::chrono::steady_clock::now();
+    PrefetchStats boot;
+    std::set<std::string> issued;  // Shared libraries are requested once
+
+    for (size_t index : order) {
+        if (index >= runner_.getCommandCount() || runner_.isRunning(index)) {
+            continue;
+        }
+        PrefetchSet files = set(index);
+        files.Configured.insert(files.Configured.end(), files.Recorded.begin(), files.Recorded.end());
+        if (files.Configured.empty()) {
+            continue;
+        }
+        boot.Services++;
+        for (const std::string& file : files.Configured) {
+            if (!issued.insert(file).second) {
+                continue;
+            }
+            int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                boot.Missing += errno == ENOENT ? 1 : 0;
+                continue;
+            }
+            // WILLNEED only queues the reads, so the whole order is issued up front
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                off_t length = std::min(st.st_size, MAX_FILE_BYTES);
+                if (posix_fadvise(fd, 0, length, POSIX_FADV_WILLNEED) == 0) {
+                    boot.Files++;
+                    boot.Bytes += static_cast<uint64_t>(length);
+                }
+            }
+            close(fd);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.Boots++;
+    stats_.Services += boot.Services;
+    stats_.Files += boot.Files;
+    stats_.Bytes += boot.Bytes;
+    stats_.Missing += boot.Missing;
+    stats_.LastBootMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * State file format: "[<service description>]" followed by one file per line.
+ */
+bool Prefetcher::load() {
+    std::ifstream file(path_);
+    if (!file.is_open()) {
+        return errno == ENOENT;  // First run
+    }
+    std::map<std::string, std::vector<std::string>> recorded;
+    std::vector<std::string>* current = nullptr;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() >= 2 && line.front() == '[' && line.back() == ']') {
+            current = &recorded[line.substr(1, line.size() - 2)];
+        } else if (current && !line.empty() && line[0] == '/') {
+            current->push_back(line);
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    recorded_ = std::move(recorded);
+    return true;
+}
+
+bool Prefetcher::save(const std::map<std::string, std::vector<std::string>>& recorded) {
+    // Written aside and renamed, so a crash never leaves a truncated file
+    std::string temporary = path_ + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        for (const auto& [desc, files] : recorded) {
+            file << '[' << desc << "]\n";
+            for (const std::string& path : files) {
+                file << path << '\n';
+            }
+        }
+        if (!file.flush()) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path_.c_str()) == 0;
+}
+
+std::vector<std::string> Prefetcher::configured(const std::string& option) {
+    std::vector<std::string> files;
+    std::istringstream paths(option);
+    std::string path;
+    while (std::getline(paths, path, ':')) {
+        if (!path.empty()) {
+            files.push_back(path);
+        }
+    }
+    return files;
+}
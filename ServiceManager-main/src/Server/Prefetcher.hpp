@@ -0,0 +1,137 @@
+/**
+ * @file Prefetcher.hpp
+ * @brief Page-cache prefetch of service binaries, libraries and data files before boot
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+class ProcessRunner;
+
+/**
+ * @brief Prefetch counters
+ */
+struct PrefetchStats {
+    uint64_t Boots = 0;       ///< Boots whose services were prefetched
+    uint64_t Services = 0;    ///< Services prefetched
+    uint64_t Files = 0;       ///< Files handed to posix_fadvise(WILLNEED)
+    uint64_t Bytes = 0;       ///< Bytes requested
+    uint64_t Missing = 0;     ///< Recorded files that no longer exist
+    double   LastBootMs = 0;  ///< Time to issue the requests of the last boot
+};
+
+/**
+ * @brief File working set of one service
+ */
+struct PrefetchSet {
+    std::vector<std::string> Recorded;    ///< Files mapped by the service when it was last ready
+    std::vector<std::string> Configured;  ///< "@prefetch.files" entries
+};
+
+/**
+ * @brief Warms the page cache with the files upcoming services will fault in
+ *
+ * After a reboot, starting a service is dominated by major faults loading
+ * its binary, shared libraries and data files one page cluster at a time.
+ * Whenever a service becomes ready, the file-backed mappings in
+ * /proc/<pid>/maps are recorded as its working set and saved to a state
+ * file. When a later boot begins, a worker thread walks the boot's
+ * dependency order and calls posix_fadvise(WILLNEED) on each service's
+ * files (plus its "@prefetch.files" list). The disk then reads whole files
+ * in large sequential requests while the first services are still starting,
+ * and later services find their pages cached. Files shared by several
+ * services (libc) are requested once per boot, and services that are
+ * already running are skipped.
+ *
+ * Sets are keyed by service description, so they survive config reordering.
+ */
+class Prefetcher {
+public:
+    static constexpr size_t MAX_FILES = 1024;                  ///< Recorded files per service
+    static constexpr off_t MAX_FILE_BYTES = off_t(256) << 20;  ///< Prefix requested of huge files
+
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param path State file holding the recorded sets
+     */
+    Prefetcher(ProcessRunner& runner, std::string path);
+
+    /**
+     * @brief Destructor - stops the worker thread
+     */
+    ~Prefetcher();
+
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    /**
+     * @brief Load the recorded sets and start the worker thread
+     * @return false if the state file exists but cannot be read
+     */
+    bool open();
+
+    /**
+     * @brief Save pending changes and stop the worker thread
+     */
+    void stop();
+
+    /**
+     * @brief Record the working set of a service that just became ready
+     * @param index Command index
+     * @param pid Main process of the instance
+     */
+    void record(size_t index, pid_t pid);
+
+    /**
+     * @brief Prefetch the services of a boot in the order they start
+     * @param order Command indexes in dependency order
+     */
+    void prefetch(const std::vector<size_t>& order);
+
+    /**
+     * @brief Get the working set of a service
+     * @param index Command index
+     */
+    PrefetchSet set(size_t index) const;
+
+    /**
+     * @brief Get the counters
+     */
+    PrefetchStats stats() const;
+
+    /**
+     * @brief Get the state file path
+     */
+    const std::string& path() const { return path_; }
+
+private:
+    ProcessRunner&          runner_;
+    std::string             path_;
+    mutable std::mutex      mutex_;     ///< Guards everything below
+    std::map<std::string, std::vector<std::string>> recorded_;  ///< Files by service description
+    std::deque<std::vector<size_t>> boots_;  ///< Boot orders waiting for the worker
+    bool                    dirty_ = false;  ///< recorded_ differs from the state file
+    PrefetchStats           stats_;
+    std::condition_variable wakeup_;
+    bool                    running_ = false;
+    std::thread             thread_;
+
+    void run();
+    void prefetchBoot(const std::vector<size_t>& order);
+    bool load();
+    bool save(const std::map<std::string, std::vector<std::string>>& recorded);
+    static std::vector<std::string> configured(const std::string& option);
+};
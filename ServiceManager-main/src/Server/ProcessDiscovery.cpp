@@ -0,0 +1,494 @@
+/**
+ * @file ProcessDiscovery.cpp
+ * @brief Implementation of the incremental /proc discovery scanner
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "ProcessDiscovery.hpp"
+#include "ProcessRunner.hpp"
+#include "EventLog.hpp"
+
+#include <dirent.h>         // DT_DIR
+#include <fcntl.h>          // openat, O_DIRECTORY
+#include <unistd.h>         // read, readlinkat, lseek, getpid, geteuid
+#include <sys/stat.h>       // fstatat
+#include <sys/syscall.h>    // SYS_getdents64
+#include <climits>          // PATH_MAX
+#include <cstdlib>          // realpath, getenv
+#include <chrono>           // std::chrono::steady_clock
+#include <cstdio>           // snprintf
+#include <cstring>          // strrchr, strchr
+#include <iostream>         // std::cerr
+#include <sstream>          // std::istringstream
+
+namespace {
+
+constexpr size_t DIRENT_BUFFER_SIZE = 1 << 20;
+constexpr size_t CMDLINE_READ_LIMIT = 4096;
+
+/// Layout of the records returned by getdents64
+struct LinuxDirent64 {
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+};
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/// Hash argv[first..] with the first hashed argument reduced to its basename
+uint64_t hashArgs(const std::vector<std::string>& args, size_t first) {
+    uint64_t hash = 14695981039346656037ULL;
+    if (first >= args.size()) {
+        return 0;
+    }
+    for (size_t i = first; i < args.size(); ++i) {
+        std::string part = args[i];
+        if (i == first) {
+            auto slash = part.rfind('/');
+            if (slash != std::string::npos) {
+                part = part.substr(slash + 1);
+            }
+        }
+        hash = fnv1a(hash, part.c_str(), part.size() + 1);  // Include the separator
+    }
+    return hash;
+}
+
+bool parsePid(const char* name, pid_t& pid) {
+    if (*name < '1' || *name > '9') {
+        return false;
+    }
+    pid_t value = 0;
+    for (; *name; ++name) {
+        if (*name < '0' || *name > '9') {
+            return false;
+        }
+        value = value * 10 + (*name - '0');
+    }
+    pid = value;
+    return true;
+}
+
+std::string canonical(const std::string& path) {
+    char resolved[PATH_MAX];
+    return realpath(path.c_str(), resolved) ? std::string(resolved) : path;
+}
+
+/// Resolve an executable like execvp() would, relative to a working directory
+std::string resolveExecutable(const std::string& name, const std::string& folder) {
+    if (name.find('/') != std::string::npos) {
+        if (name[0] == '/' || folder.empty() || folder == ".") {
+            return name;
+        }
+        return folder + "/" + name;
+    }
+    const char* pathEnv = getenv("PATH");
+    std::istringstream dirs(pathEnv ? pathEnv : "/usr/local/bin:/usr/bin:/bin");
+    std::string dir;
+    while (std::getline(dirs, dir, ':')) {
+        std::string candidate = (dir.empty() ? "." : dir) + "/" + name;
+        if (access(candidate.c_str(), X_OK) == 0) {
+            return candidate;
+        }
+    }
+    return "";
+}
+
+} // namespace
+
+ProcessDiscovery::ProcessDiscovery(ProcessRunner& runner, EventLog& events, DiscoveryMode defaultMode)
+    : runner_(runner), events_(events), buffer_(DIRENT_BUFFER_SIZE) {
+    procFd_ = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (procFd_ < 0) {
+        perror("ProcessDiscovery: cannot open /proc");
+    }
+
+    signatures_.resize(runner_.getCommandCount());
+    for (size_t i = 0; i < signatures_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        Signature& signature = signatures_[i];
+
+        signature.Mode = defaultMode;
+        std::string modeName = cmd.option("discovery");
+        if (!modeName.empty() && !parseMode(modeName, signature.Mode)) {
+            events_.record(static_cast<int>(i), "discovery.config",
+                           "Unknown discovery mode '" + modeName + "', discovery disabled");
+            signature.Mode = DiscoveryMode::Off;
+        }
+        // Docker containers run under dockerd, not as recognizable children
+        if (cmd.Mode != 'C') {
+            signature.Mode = DiscoveryMode::Off;
+            continue;
+        }
+
+        auto parts = ProcessRunner::splitCommand(cmd.Path);
+        signature.CmdHash = hashArgs(parts, 0);
+        if (signature.Mode != DiscoveryMode::Off && signature.CmdHash != 0) {
+            byHash_.emplace(signature.CmdHash, i);
+        }
+        // Without a folder the service inherits ServiceMN's working directory
+        signature.Cwd = canonical(cmd.Folder.empty() ? "." : cmd.Folder);
+        if (!parts.empty()) {
+            struct stat st;
+            std::string exe = resolveExecutable(parts[0], cmd.Folder);
+            if (!exe.empty() && stat(exe.c_str(), &st) == 0) {
+                signature.ExeDev = st.st_dev;
+                signature.ExeIno = st.st_ino;
+            }
+        }
+    }
+}
+
+ProcessDiscovery::~ProcessDiscovery() {
+    if (procFd_ >= 0) {
+        close(procFd_);
+    }
+}
+
+bool ProcessDiscovery::parseMode(const std::string& name, DiscoveryMode& mode) {
+    if (name == "off") {
+        mode = DiscoveryMode::Off;
+    } else if (name == "flag") {
+        mode = DiscoveryMode::Flag;
+    } else if (name == "adopt") {
+        mode = DiscoveryMode::Adopt;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ProcessDiscovery::scan() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (procFd_ < 0) {
+        return;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    uint64_t pass = ++stats_.Passes;
+    size_t pids = 0;
+    size_t indexed = 0;
+
+    lseek(procFd_, 0, SEEK_SET);
+    for (;;) {
+        long bytes = syscall(SYS_getdents64, procFd_, buffer_.data(), buffer_.size());
+        if (bytes <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < bytes;) {
+            auto* dirent = reinterpret_cast<LinuxDirent64*>(buffer_.data() + offset);
+            offset += dirent->d_reclen;
+
+            pid_t pid;
+            if (dirent->d_type != DT_DIR || !parsePid(dirent->d_name, pid)) {
+                continue;
+            }
+            ++pids;
+
+            // Fast path: a known PID with an unchanged start time is the same process
+            auto it = index_.find(pid);
+            if (it != index_.end()) {
+                pid_t ppid;
+                uint64_t startTime;
+                if (!readStat(pid, ppid, startTime)) {
+                    continue;  // Exited while listed; dropped below
+                }
+                Slot& known = it->second;
+                if (startTime == known.Entry.StartTime) {
+                    known.SeenPass = pass;
+                    known.Entry.PPid = ppid;  // Reparented when its parent exited
+                    if (known.Confirmed) {
+                        continue;
+                    }
+                    known.Confirmed = true;
+                    ProcEntry entry;
+                    if (indexPid(pid, entry)) {
+                        known.Entry = std::move(entry);
+                    }
+                    continue;
+                }
+                index_.erase(it);  // PID reused: index the new process from scratch
+            }
+            Slot slot;
+            if (indexPid(pid, slot.Entry)) {
+                slot.SeenPass = pass;
+                index_.emplace(pid, std::move(slot));
+                ++indexed;
+            }
+        }
+    }
+
+    // Drop processes that disappeared since the previous pass
+    for (auto& item : children_) {
+        item.second.clear();
+    }
+    for (auto it = index_.begin(); it != index_.end();) {
+        if (it->second.SeenPass != pass) {
+            it = index_.erase(it);
+        } else {
+            children_[it->second.Entry.PPid].push_back(it->first);
+            ++it;
+        }
+    }
+    for (auto it = children_.begin(); it != children_.end();) {
+        it = it->second.empty() ? children_.erase(it) : std::next(it);
+    }
+
+    stats_.Pids = pids;
+    stats_.Indexed = indexed;
+    stats_.DurationMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
+
+    match();
+}
+
+bool ProcessDiscovery::readStat(pid_t pid, pid_t& ppid, uint64_t& startTime) const {
+    char path[32];
+    snprintf(path, sizeof(path), "%d/stat", pid);
+    int fd = openat(procFd_, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buf[1024];
+    ssize_t length = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (length <= 0) {
+        return false;
+    }
+    buf[length] = '\0';
+
+    // Fields resume after the last ')' of the command name
+    char* p = strrchr(buf, ')');
+    if (!p) {
+        return false;
+    }
+    p += 2;
+    for (int field = 3; field < 22 && *p; ++field) {
+        if (field == 4) {
+            ppid = static_cast<pid_t>(strtol(p, nullptr, 10));
+        }
+        p = strchr(p, ' ');
+        if (!p) {
+            return false;
+        }
+        ++p;
+    }
+    startTime = strtoull(p, nullptr, 10);
+    return true;
+}
+
+bool ProcessDiscovery::indexPid(pid_t pid, ProcEntry& entry) const {
+    entry.Pid = pid;
+    if (!readStat(pid, entry.PPid, entry.StartTime)) {
+        return false;
+    }
+
+    char path[32];
+    snprintf(path, sizeof(path), "%d/cmdline", pid);
+    int fd = openat(procFd_, path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        char buf[CMDLINE_READ_LIMIT];
+        ssize_t length = read(fd, buf, sizeof(buf));
+        close(fd);
+
+        std::vector<std::string> args;
+        for (ssize_t start = 0, i = 0; i < length; ++i) {
+            if (buf[i] == '\0') {
+                args.emplace_back(buf + start, i - start);
+                start = i + 1;
+            }
+        }
+        for (size_t i = 0; i < args.size(); ++i) {
+            entry.Cmdline += (i ? " " : "") + args[i];
+        }
+        entry.CmdHash = hashArgs(args, 0);
+        entry.ScriptHash = hashArgs(args, 1);
+    }
+
+    struct stat st;
+    snprintf(path, sizeof(path), "%d", pid);
+    if (fstatat(procFd_, path, &st, 0) == 0) {
+        entry.Uid = st.st_uid;
+    }
+
+    char link[PATH_MAX];
+    snprintf(path, sizeof(path), "%d/cwd", pid);
+    ssize_t length = readlinkat(procFd_, path, link, sizeof(link) - 1);
+    if (length > 0) {
+        entry.Cwd.assign(link, length);
+    }
+
+    snprintf(path, sizeof(path), "%d/exe", pid);
+    if (fstatat(procFd_, path, &st, 0) == 0) {
+        entry.ExeDev = st.st_dev;
+        entry.ExeIno = st.st_ino;
+    }
+    return true;
+}
+
+void ProcessDiscovery::match() {
+    std::vector<DiscoveredInstance> found;
+    pid_t self = getpid();
+    uid_t user = geteuid();
+
+    std::vector<command> commands;
+    std::set<pid_t> managed;
+    for (size_t i = 0; i < signatures_.size(); ++i) {
+        commands.push_back(runner_.getCommand(i));
+        if (commands.back().Pid > 0) {
+            managed.insert(commands.back().Pid);
+        }
+    }
+
+    // One sweep over the index collects candidates for every service. The
+    // candidates point into index_, so stale entries are only erased once
+    // every service has been matched.
+    std::vector<std::vector<const ProcEntry*>> candidates(signatures_.size());
+    std::set<pid_t> stale;
+    for (const auto& item : index_) {
+        const ProcEntry& entry = item.second.Entry;
+        for (uint64_t hash : {entry.CmdHash, entry.ScriptHash}) {
+            auto range = byHash_.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                candidates[it->second].push_back(&entry);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < signatures_.size(); ++i) {
+        const Signature& signature = signatures_[i];
+        if (signature.Mode == DiscoveryMode::Off || candidates[i].empty()) {
+            continue;
+        }
+
+        const ProcEntry* best = nullptr;
+        for (const ProcEntry* candidate : candidates[i]) {
+            const ProcEntry& entry = *candidate;
+            if (entry.Uid != user || entry.Cwd != signature.Cwd || stale.count(entry.Pid)) {
+                continue;
+            }
+            // Skip our own children, managed instances and their workers
+            if (entry.Pid == self || entry.PPid == self || managed.count(entry.Pid) ||
+                managed.count(entry.PPid)) {
+                continue;
+            }
+            // Forked workers of an external instance share its command line
+            auto parent = index_.find(entry.PPid);
+            if (parent != index_.end() && (parent->second.Entry.CmdHash == signature.CmdHash ||
+                                           parent->second.Entry.ScriptHash == signature.CmdHash)) {
+                continue;
+            }
+
+            bool sameExe = signature.ExeIno && entry.ExeIno == signature.ExeIno &&
+                           entry.ExeDev == signature.ExeDev;
+            bool bestSameExe = best && signature.ExeIno && best->ExeIno == signature.ExeIno &&
+                               best->ExeDev == signature.ExeDev;
+            if (!best || (sameExe && !bestSameExe) ||
+                (sameExe == bestSameExe && entry.StartTime < best->StartTime)) {
+                best = &entry;
+            }
+        }
+        if (!best) {
+            continue;
+        }
+
+        // Guard against PID reuse since the entry was indexed
+        pid_t ppid;
+        uint64_t startTime;
+        if (!readStat(best->Pid, ppid, startTime) || startTime != best->StartTime) {
+            stale.insert(best->Pid);
+            continue;
+        }
+
+        DiscoveredInstance instance;
+        instance.Service = i;
+        instance.Entry = *best;
+
+        bool announce = reported_.insert({i, best->Pid}).second;
+        if (signature.Mode == DiscoveryMode::Adopt && commands[i].Status != RUNNING &&
+            runner_.adopt(i, best->Pid)) {
+            instance.Adopted = true;
+            managed.insert(best->Pid);
+            events_.record(static_cast<int>(i), "discovery.adopt",
+                           "Adopted externally started instance (PID " + std::to_string(best->Pid) +
+                           "): " + best->Cmdline);
+        } else if (announce) {
+            events_.record(static_cast<int>(i), "discovery.flag",
+                           "Found externally started instance (PID " + std::to_string(best->Pid) +
+                           "): " + best->Cmdline);
+        }
+        found.push_back(std::move(instance));
+    }
+    for (pid_t pid : stale) {
+        index_.erase(pid);
+    }
+
+    // Forget announcements for instances that are gone
+    for (auto it = reported_.begin(); it != reported_.end();) {
+        if (!index_.count(it->second)) {
+            it = reported_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    instances_ = std::move(found);
+}
+
+pid_t ProcessDiscovery::externalPid(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& instance : instances_) {
+        if (instance.Service == index && !instance.Adopted) {
+            return instance.Entry.Pid;
+        }
+    }
+    return -1;
+}
+
+std::vector<DiscoveredInstance> ProcessDiscovery::instances() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return instances_;
+}
+
+DiscoveryStats ProcessDiscovery::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool ProcessDiscovery::lookup(pid_t pid, ProcEntry& entry) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(pid);
+    if (it == index_.end()) {
+        return false;
+    }
+    entry = it->second.Entry;
+    return true;
+}
+
+std::vector<ProcEntry> ProcessDiscovery::descendants(pid_t root) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ProcEntry> tree;
+    std::vector<pid_t> stack = {root};
+    while (!stack.empty() && tree.size() < index_.size()) {
+        pid_t pid = stack.back();
+        stack.pop_back();
+        auto it = index_.find(pid);
+        if (it == index_.end()) {
+            continue;
+        }
+        tree.push_back(it->second.Entry);
+        auto children = children_.find(pid);
+        if (children != children_.end()) {
+            stack.insert(stack.end(), children->second.rbegin(), children->second.rend());
+        }
+    }
+    return tree;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file ProcessDiscovery.hpp
+ * @brief Incremental /proc index for detecting externally started service instances
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+class ProcessRunner;
+class EventLog;
+
+/**
+ * @brief What to do with a running instance nobody asked ServiceMN to start
+ */
+enum class DiscoveryMode {
+    Off,    ///< Ignore external instances
+    Flag,   ///< Report them and refuse to start a second copy
+    Adopt   ///< Take over management of the instance
+};
+
+/**
+ * @brief Indexed information about one /proc entry
+ */
+struct ProcEntry {
+    pid_t       Pid = -1;
+    pid_t       PPid = -1;
+    uint64_t    StartTime = 0;    ///< Start time in clock ticks since boot (field 22 of stat)
+    uint64_t    CmdHash = 0;      ///< Hash of argv with argv[0] reduced to its basename
+    uint64_t    ScriptHash = 0;   ///< Same hash over argv[1..] (interpreter-run scripts)
+    std::string Cmdline;          ///< argv joined with spaces (for display)
+    std::string Cwd;              ///< Working directory (empty if unreadable)
+    uid_t       Uid = 0;          ///< Effective user (owner of the /proc entry)
+    uint64_t    ExeDev = 0;       ///< Device of the executable
+    uint64_t    ExeIno = 0;       ///< Inode of the executable (0 if unreadable)
+};
+
+/**
+ * @brief Running instance matched against a configured service
+ */
+struct DiscoveredInstance {
+    size_t      Service = 0;      ///< Command index the instance matches
+    ProcEntry   Entry;            ///< Indexed process information
+    bool        Adopted = false;  ///< Instance was adopted by ServiceMN
+};
+
+/**
+ * @brief Statistics of the last discovery pass
+ */
+struct DiscoveryStats {
+    uint64_t Passes = 0;          ///< Completed passes
+    size_t   Pids = 0;            ///< PIDs present in /proc during the last pass
+    size_t   Indexed = 0;         ///< PIDs newly indexed during the last pass
+    double   DurationMs = 0.0;    ///< Wall time of the last pass
+};
+
+/**
+ * @brief Discovery scanner keeping an incremental index of /proc
+ *
+ * Each pass lists /proc with raw getdents64 calls into a reusable buffer.
+ * PIDs already in the index only have their stat re-read: an unchanged start
+ * time means the same process (its parent is refreshed), a different one a
+ * reused PID that is indexed again. Only new PIDs have their cmdline, cwd and
+ * exe read (once more on the following pass, to catch a fork indexed just
+ * before its exec). A steady-state pass therefore costs one small read plus
+ * one hash lookup per PID.
+ *
+ * Instances are matched on the command line hash and working directory of
+ * native ('C' mode) services; the executable inode breaks ties. Only
+ * processes of ServiceMN's own effective user count, and a service without
+ * a folder runs in ServiceMN's working directory, so another user's or
+ * another directory's copy of the same command never blocks a start.
+ *
+ * Each pass also rebuilds a parent-to-children index of all listed PIDs, so
+ * the process tree of any service is a walk of the index rather than
+ * another /proc scan (see descendants()).
+ */
+class ProcessDiscovery {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param events Event log receiving discovery events
+     * @param defaultMode Mode for services without a "@discovery" option
+     */
+    ProcessDiscovery(ProcessRunner& runner, EventLog& events, DiscoveryMode defaultMode);
+
+    /**
+     * @brief Destructor - closes the /proc directory
+     */
+    ~ProcessDiscovery();
+
+    ProcessDiscovery(const ProcessDiscovery&) = delete;
+    ProcessDiscovery& operator=(const ProcessDiscovery&) = delete;
+
+    /**
+     * @brief Run one incremental pass and flag or adopt matching instances
+     */
+    void scan();
+
+    /**
+     * @brief Get the external instance blocking a start of a service
+     *
+     * Answers from the last pass (the sampler runs one every tick) rather
+     * than scanning /proc on the caller's thread.
+     * @param index Index of the command
+     * @return PID of a flagged (not adopted) instance, -1 if none
+     */
+    pid_t externalPid(size_t index) const;
+
+    /**
+     * @brief Get all instances matched during the last pass
+     */
+    std::vector<DiscoveredInstance> instances() const;
+
+    /**
+     * @brief Get statistics of the last pass
+     */
+    DiscoveryStats stats() const;
+
+    /**
+     * @brief Look up an indexed process
+     * @param pid Process ID
+     * @param entry Receives the indexed information
+     * @return false if the PID is not in the index
+     */
+    bool lookup(pid_t pid, ProcEntry& entry) const;
+
+    /**
+     * @brief Get a process and its descendants as of the last pass
+     * @param root Process ID
+     * @return Indexed entries in depth-first order, root first (empty if root is not indexed)
+     */
+    std::vector<ProcEntry> descendants(pid_t root) const;
+
+    /**
+     * @brief Parse a discovery mode name
+     * @param name "off", "flag" or "adopt"
+     * @param mode Receives the parsed mode
+     * @return false if the name is unknown
+     */
+    static bool parseMode(const std::string& name, DiscoveryMode& mode);
+
+private:
+    struct Signature {
+        DiscoveryMode Mode = DiscoveryMode::Off;
+        uint64_t      CmdHash = 0;
+        std::string   Cwd;        ///< Canonical working directory the service runs in
+        uint64_t      ExeDev = 0;
+        uint64_t      ExeIno = 0;
+    };
+
+    ProcessRunner&  runner_;
+    EventLog&       events_;
+    int             procFd_ = -1;             ///< Open /proc directory
+    std::vector<char> buffer_;                ///< getdents64 buffer reused across passes
+    std::vector<Signature> signatures_;       ///< Per-service match signatures
+    std::unordered_multimap<uint64_t, size_t> byHash_; ///< Command hash -> service index
+    struct Slot {
+        ProcEntry Entry;
+        uint64_t  SeenPass = 0;     ///< Pass in which the PID was last listed
+        bool      Confirmed = false; ///< Re-read once on the pass after indexing
+    };
+
+    std::unordered_map<pid_t, Slot> index_;   ///< Indexed /proc entries
+    std::unordered_map<pid_t, std::vector<pid_t>> children_; ///< PPid -> PIDs of the last pass
+    std::vector<DiscoveredInstance> instances_;  ///< Matches of the last pass
+    std::set<std::pair<size_t, pid_t>> reported_; ///< Instances already announced
+    DiscoveryStats  stats_;
+    mutable std::mutex mutex_;                 ///< Serializes passes and guards results
+
+    bool indexPid(pid_t pid, ProcEntry& entry) const;
+    bool readStat(pid_t pid, pid_t& ppid, uint64_t& startTime) const;
+    void match();
+};
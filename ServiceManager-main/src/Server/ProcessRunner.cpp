@@ -6,16 +6,126 @@
  */
 
 #include "ProcessRunner.hpp"
+#include "CgroupManager.hpp"
+#include "LogCollector.hpp"
+#include "WarmPool.hpp"
+#include "Checkpointer.hpp"
+#include "NotifyMonitor.hpp"
+#include "BootAnalyzer.hpp"
+#include "StartupBoost.hpp"
+#include "Sandbox.hpp"
+#include "ExecCache.hpp"
+#include "MemoryPolicy.hpp"
 
-#include <unistd.h>     // fork, execvp, chdir
+#include <unistd.h>     // fork, execve, execvp, fchdir, pipe2, dup2
+#include <fcntl.h>      // O_CLOEXEC
 #include <signal.h>     // kill, SIGTERM, SIGKILL
 #include <sys/wait.h>   // waitpid
+#include <sys/syscall.h> // SYS_pidfd_open
+#include <poll.h>       // poll
+#include <netinet/in.h> // sockaddr_in6
+#include <sys/socket.h> // socket, bind, listen, shutdown
+#include <linux/filter.h> // sock_filter, sock_fprog, BPF_STMT
 #include <cstring>      // strdup
 #include <cerrno>       // errno
 #include <iostream>     // std::cerr
 #include <sstream>      // std::istringstream
+#include <fstream>      // std::ifstream
+#include <filesystem>   // std::filesystem::directory_iterator
 #include <algorithm>    // std::find_if
 
+namespace {
+
+constexpr int SD_LISTEN_FDS_START = 3;
+constexpr size_t MAX_UNCLAIMED_EXITS = 256;
+
+/**
+ * @brief Tell the parent why the child never reached exec() (child side)
+ * @param fd Write end of the exec-confirm pipe (-1 if none)
+ */
+void reportExecFailure(int fd) {
+    if (fd >= 0) {
+        int error = errno != 0 ? errno : EINVAL;
+        ssize_t written = write(fd, &error, sizeof(error));
+        (void)written;
+    }
+}
+
+/**
+ * @brief Get a process and all of its descendants
+ * @param root Process ID
+ * @return PIDs with the root first (children of every thread are included)
+ */
+std::vector<pid_t> processTree(pid_t root) {
+    std::vector<pid_t> tree = {root};
+    for (size_t i = 0; i < tree.size(); ++i) {
+        std::string tasks = "/proc/" + std::to_string(tree[i]) + "/task";
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(tasks, ec), end; !ec && it != end; it.increment(ec)) {
+            std::ifstream children(it->path() / "children");
+            pid_t child;
+            while (children >> child) {
+                tree.push_back(child);
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief Bind a socket-activation listener on all addresses
+ * @param port TCP port
+ * @return Listening socket, or -1 on failure
+ *
+ * SO_REUSEPORT lets a swap put a second listener next to it, see
+ * steerListeners().
+ */
+int bindListener(int port) {
+    int fd = socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("ProcessRunner: listener socket failed");
+        return -1;
+    }
+    int on = 1;
+    int off = 0;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    sockaddr_in6 address = {};
+    address.sin6_family = AF_INET6;
+    address.sin6_port = htons(static_cast<uint16_t>(port));
+    address.sin6_addr = in6addr_any;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        perror("ProcessRunner: listener bind failed");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Send every new connection of a listener's SO_REUSEPORT group to one member
+ * @param fd Any listener of the group
+ * @param member Position of the chosen listener (the order in which they started listening)
+ * @return false if the kernel rejected the program
+ *
+ * A one-instruction classic BPF program returns the position. When a
+ * listener leaves the group the last one takes its position, and a
+ * position past the end falls back to the kernel's hash.
+ */
+bool steerListeners(int fd, uint32_t member) {
+    struct sock_filter code[] = {BPF_STMT(BPF_RET | BPF_K, member)};
+    struct sock_fprog program = {1, code};
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != 0) {
+        perror("ProcessRunner: SO_ATTACH_REUSEPORT_CBPF failed");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 ProcessRunner::ProcessRunner(std::vector<command>& commands)
     : commands_(commands) {
     // Initialize all PIDs to -1 (not running)
@@ -34,6 +144,12 @@ ProcessRunner::~ProcessRunner() {
             kill(i, false); // Try graceful termination first
         }
     }
+    for (const auto& entry : listeners_) {
+        close(entry.second);
+    }
+    for (const auto& entry : swapListeners_) {
+        close(entry.second);
+    }
 }
 
 std::vector<std::string> ProcessRunner::splitCommand(const std::string& cmdline) {
@@ -50,7 +166,49 @@ std::vector<std::string> ProcessRunner::splitCommand(const std::string& cmdline)
     return tokens;
 }
 
-pid_t ProcessRunner::start(size_t index) {
+pid_t ProcessRunner::start(size_t index, bool* alreadyRunning) {
+    bool restore = false;
+    pid_t pid;
+    Checkpointer* checkpoints;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pid = startLocked(index, alreadyRunning, restore);
+        checkpoints = checkpoints_;
+    }
+    if (restore) {
+        checkpoints->restoreLater(index);
+    }
+    return pid;
+}
+
+Task<pid_t> ProcessRunner::startAsync(size_t index) {
+    bool restoring = false;
+    pid_t pid;
+    std::shared_ptr<AsyncEvent> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pid = startLocked(index, nullptr, restoring);
+        auto it = restoring_.find(index);
+        if (pid == 0 && !restoring && it != restoring_.end()) {
+            done = it->second;  // Another caller's restore is under way
+        }
+    }
+    if (restoring) {
+        co_return co_await restore(index);
+    }
+    if (done) {
+        co_await done->wait();
+        co_return getPid(index);
+    }
+    co_return pid;
+}
+
+pid_t ProcessRunner::startLocked(size_t index, bool* alreadyRunning, bool& restore) {
+    restore = false;
+    if (alreadyRunning) {
+        *alreadyRunning = false;
+    }
+    
     // Validate index
     if (index >= commands_.size()) {
         std::cerr << "ProcessRunner::start: Invalid index " << index << std::endl;
@@ -63,8 +221,270 @@ pid_t ProcessRunner::start(size_t index) {
     if (cmd.Status == RUNNING && cmd.Pid > 0) {
         std::cerr << "ProcessRunner::start: Process already running (PID: " 
                   << cmd.Pid << ")" << std::endl;
+        if (alreadyRunning) {
+            *alreadyRunning = true;
+        }
         return cmd.Pid;
     }
+    if (restoring_.count(index)) {
+        return 0;
+    }
+    
+    // A pre-started standby serves immediately
+    pid_t pid = pool_ ? pool_->take(index) : -1;
+    if (pid > 0) {
+        std::cout << "Standby instance of " << cmd.Desc << " handed out (PID: " << pid << ")" << std::endl;
+    } else if (checkpoints_ && checkpoints_->hasImage(index)) {
+        // criu can take a while; it runs on the loop without the runner locked
+        restoring_[index] = std::make_shared<AsyncEvent>();
+        restore = true;
+        std::cout << "Restoring " << cmd.Desc << " from its checkpoint" << std::endl;
+        return 0;
+    } else {
+        pid = launch(index, colors_[index], false);
+    }
+    if (pid > 0) {
+        releaseAdopted(index);
+        cmd.Pid = pid;
+        cmd.Status = RUNNING;
+        notifyChange();
+        std::cout << "Process started successfully (PID: " << pid << ")" << std::endl;
+    }
+    return pid;
+}
+
+pid_t ProcessRunner::startStandby(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (index >= commands_.size() || commands_[index].Mode != 'C') {
+        std::cerr << "ProcessRunner::startStandby: Invalid index " << index << std::endl;
+        return -1;
+    }
+    return launch(index, colors_[index], true);
+}
+
+pid_t ProcessRunner::startSurge(size_t index, bool ownListener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (index >= commands_.size() || !commands_[index].native()) {
+        std::cerr << "ProcessRunner::startSurge: Invalid index " << index << std::endl;
+        return -1;
+    }
+    
+    int listenFd = -1;
+    if (ownListener && !commands_[index].option("listen").empty()) {
+        if (swapListeners_.count(index)) {
+            std::cerr << "ProcessRunner::startSurge: " << commands_[index].Desc
+                      << " already has a swap in progress" << std::endl;
+            return -1;
+        }
+        listenFd = swapListener(index);
+        if (listenFd < 0) {
+            return -1;
+        }
+    }
+    
+    // The surge instance takes the other color so both can run side by side
+    pid_t pid = launch(index, !colors_[index], false, listenFd);
+    if (pid > 0) {
+        std::cout << "Surge instance started (PID: " << pid << ")" << std::endl;
+    } else if (listenFd >= 0) {
+        close(listenFd);
+        swapListeners_.erase(index);
+        steerListeners(listeners_[index], 0);
+    }
+    return pid;
+}
+
+void ProcessRunner::promote(size_t index, pid_t pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= commands_.size()) {
+        return;
+    }
+    // New connections go to the promoted instance's own listener from now on;
+    // the old one stays in the group, draining its queue, until released
+    auto swap = swapListeners_.find(index);
+    if (swap != swapListeners_.end()) {
+        steerListeners(swap->second, 1);
+        std::swap(listeners_[index], swap->second);
+    }
+    releaseAdopted(index);
+    commands_[index].Pid = pid;
+    commands_[index].Status = RUNNING;
+    notifyChange();
+    colors_[index] = !colors_[index];
+}
+
+const char* ProcessRunner::color(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = colors_.find(index);
+    return it != colors_.end() && it->second ? "green" : "blue";
+}
+
+bool ProcessRunner::exitStatus(pid_t pid, int& status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (waitpid(pid, &status, WNOHANG) == pid) {
+        return true;
+    }
+    // reap() may have collected it already
+    auto it = unclaimedExits_.find(pid);
+    if (it == unclaimedExits_.end()) {
+        return false;
+    }
+    status = it->second;
+    unclaimedExits_.erase(it);
+    return true;
+}
+
+int ProcessRunner::listener(size_t index) {
+    auto it = listeners_.find(index);
+    if (it != listeners_.end()) {
+        return it->second;
+    }
+    
+    int port = static_cast<int>(commands_[index].optionNumber("listen", 0));
+    if (port <= 0 || port > 65535) {
+        std::cerr << "ProcessRunner: Invalid listen port for " << commands_[index].Desc << std::endl;
+        return -1;
+    }
+    int fd = bindListener(port);
+    if (fd >= 0) {
+        listeners_[index] = fd;
+    }
+    return fd;
+}
+
+int ProcessRunner::swapListener(size_t index) {
+    int current = listener(index);
+    if (current < 0) {
+        return -1;
+    }
+    // Pin connections to the current listener before the new one joins the group
+    if (!steerListeners(current, 0)) {
+        return -1;
+    }
+    int fd = bindListener(static_cast<int>(commands_[index].optionNumber("listen", 0)));
+    if (fd >= 0) {
+        swapListeners_[index] = fd;
+    }
+    return fd;
+}
+
+void ProcessRunner::releaseSwapListener(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = swapListeners_.find(index);
+    if (it == swapListeners_.end()) {
+        return;
+    }
+    // SHUT_RD stops listening, which takes the socket out of the group at
+    // once even though an instance still holds it; the remaining listener
+    // moves to index 0
+    shutdown(it->second, SHUT_RD);
+    close(it->second);
+    swapListeners_.erase(it);
+    auto current = listeners_.find(index);
+    if (current != listeners_.end()) {
+        steerListeners(current->second, 0);
+    }
+}
+
+Task<pid_t> ProcessRunner::restore(size_t index) {
+    // Fresh output pipes and the shared listener replace the checkpointed ones
+    std::map<int, int> fds;
+    int outPipes[2][2] = {{-1, -1}, {-1, -1}};
+    bool capture;
+    Checkpointer* checkpoints;
+    std::string color;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkpoints = checkpoints_;
+        color = colors_[index] ? "green" : "blue";
+        capture = logs_ && logs_->captures(index);
+        if (capture && (pipe2(outPipes[0], O_CLOEXEC) != 0 || pipe2(outPipes[1], O_CLOEXEC) != 0)) {
+            perror("ProcessRunner::restore: pipe2 failed");
+            for (auto& pair : outPipes) {
+                for (int& fd : pair) {
+                    if (fd >= 0) {
+                        close(fd);
+                    }
+                    fd = -1;
+                }
+            }
+            capture = false;
+            checkpoints = nullptr;  // Launch normally below
+        }
+        if (capture) {
+            fds[STDOUT_FILENO] = outPipes[0][1];
+            fds[STDERR_FILENO] = outPipes[1][1];
+        }
+        if (!commands_[index].option("listen").empty()) {
+            int listenFd = listener(index);
+            if (listenFd >= 0) {
+                fds[SD_LISTEN_FDS_START] = listenFd;
+            }
+        }
+    }
+    
+    pid_t pid = checkpoints ? co_await checkpoints->restore(index, fds, color) : -1;
+    if (capture) {
+        close(outPipes[0][1]);
+        close(outPipes[1][1]);
+    }
+    
+    std::shared_ptr<AsyncEvent> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        command& cmd = commands_[index];
+        // reap() keeps the status of a restored process that died before it was installed
+        if (pid > 0 && unclaimedExits_.erase(pid)) {
+            std::cerr << "ProcessRunner::restore: restored process of " << cmd.Desc << " exited at once" << std::endl;
+            pid = -1;
+        }
+        if (capture) {
+            if (pid > 0) {
+                logs_->attach(index, outPipes[0][0], outPipes[1][0]);
+            } else {
+                close(outPipes[0][0]);
+                close(outPipes[1][0]);
+            }
+        }
+        if (pid > 0) {
+            std::cout << "Restored " << cmd.Desc << " from its checkpoint (PID: " << pid << ")" << std::endl;
+            // criu recreates the tree in ServiceMN's own cgroup; move it where launch() puts it
+            if (cgroups_ && cgroups_->prepare(index)) {
+                for (pid_t member : processTree(pid)) {
+                    if (!cgroups_->attach(index, member)) {
+                        perror("ProcessRunner::restore: cgroup attach failed");
+                    }
+                }
+            }
+            if (boost_) {
+                boost_->spawned(index, pid);
+            }
+        } else {
+            pid = launch(index, colors_[index], false);
+        }
+        if (pid > 0) {
+            releaseAdopted(index);
+            cmd.Pid = pid;
+            cmd.Status = RUNNING;
+            notifyChange();
+            std::cout << "Process started successfully (PID: " << pid << ")" << std::endl;
+        }
+        auto it = restoring_.find(index);
+        if (it != restoring_.end()) {
+            done = it->second;
+            restoring_.erase(it);
+        }
+    }
+    if (done) {
+        done->set();
+    }
+    co_return pid;
+}
+
+pid_t ProcessRunner::launch(size_t index, bool green, bool standby, int listenFd) {
+    command& cmd = commands_[index];
     
     // Validate command path
     if (cmd.Path.empty()) {
@@ -74,29 +494,156 @@ pid_t ProcessRunner::start(size_t index) {
     
     std::cout << "Starting process: " << cmd.Desc << " (" << cmd.Path << ")" << std::endl;
     
+    // KSM, THP and NUMA settings are inherited from the forked child by everything it execs
+    MemoryPolicy memory;
+    if (cmd.native()) {
+        std::string error;
+        if (!MemoryPolicy::fromCommand(cmd, memory, error)) {
+            std::cerr << "ProcessRunner::start: " << cmd.Desc << ": " << error << std::endl;
+            return -1;
+        }
+    }
+    
+    // A missing binary or folder fails here, not in a child that would exit at once
+    ExecTarget target;
+    if (exec_ && cmd.native()) {
+        std::string error;
+        if (!exec_->lookup(index, cmd, target, error)) {
+            std::cerr << "ProcessRunner::start: " << cmd.Desc << ": " << error << std::endl;
+            return -1;
+        }
+    }
+    
+    // Native processes join their service cgroup; Docker containers get
+    // their own cgroup from dockerd.
+    bool useCgroup = cgroups_ && cmd.native() && cgroups_->prepare(index);
+    
+    // Socket-activated services inherit a listener owned by ServiceMN
+    if (listenFd < 0 && cmd.native() && !cmd.option("listen").empty()) {
+        listenFd = listener(index);
+        if (listenFd < 0) {
+            if (target.FolderFd >= 0) {
+                close(target.FolderFd);
+            }
+            return -1;
+        }
+    }
+    
+    // Output pipes for the log collector: [0] stdout, [1] stderr
+    int outPipes[2][2] = {{-1, -1}, {-1, -1}};
+    bool capture = logs_ && logs_->captures(index);
+    if (capture && (pipe2(outPipes[0], O_CLOEXEC) != 0 || pipe2(outPipes[1], O_CLOEXEC) != 0)) {
+        perror("ProcessRunner::start: pipe2 failed, output not captured");
+        for (auto& fds : outPipes) {
+            for (int fd : fds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        }
+        capture = false;
+    }
+    
+    // sd_notify() protocol: readiness, status and watchdog pings
+    bool notify = notify_ && notify_->enabled(index);
+    std::string watchdogUsec = notify ? std::to_string(notify_->watchdog(index).count()) : "0";
+    
+    // Boots time the exec() itself: the close-on-exec write end vanishes when it succeeds
+    int execPipe[2] = {-1, -1};
+    if (analyzer_ && cmd.native() && !standby && analyzer_->confirmsExec(index) &&
+        pipe2(execPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        perror("ProcessRunner::start: pipe2 failed, exec not confirmed");
+        execPipe[0] = execPipe[1] = -1;
+    }
+    
+    // The child joins its cgroup with a single write(), nothing that allocates
+    int cgroupProcs = useCgroup ? cgroups_->openProcs(index) : -1;
+    
     // Fork new process
     pid_t pid = fork();
+    if (cgroupProcs >= 0 && pid != 0) {
+        close(cgroupProcs);
+    }
     if (pid < 0) {
         perror("ProcessRunner::start: fork failed");
+        if (capture) {
+            for (auto& fds : outPipes) {
+                close(fds[0]);
+                close(fds[1]);
+            }
+        }
+        if (execPipe[0] >= 0) {
+            close(execPipe[0]);
+            close(execPipe[1]);
+        }
+        if (target.FolderFd >= 0) {
+            close(target.FolderFd);
+        }
         return -1;
     }
     
     if (pid == 0) {
         // CHILD PROCESS
         
-        // Change working directory if specified
-        if (!cmd.Folder.empty() && cmd.Folder != ".") {
+        // Join the service cgroup before exec so all descendants inherit it
+        if (cgroupProcs >= 0 && write(cgroupProcs, "0", 1) != 1) {
+            perror("ProcessRunner::start: cgroup attach failed");
+        }
+        
+        // dup2 clears O_CLOEXEC on the new descriptors; the originals close on exec
+        if (capture) {
+            dup2(outPipes[0][1], STDOUT_FILENO);
+            dup2(outPipes[1][1], STDERR_FILENO);
+        }
+        
+        // sd_listen_fds() protocol: the listener is fd 3
+        if (listenFd >= 0) {
+            if (listenFd == SD_LISTEN_FDS_START) {
+                fcntl(listenFd, F_SETFD, 0);
+            } else {
+                dup2(listenFd, SD_LISTEN_FDS_START);
+            }
+            setenv("LISTEN_FDS", "1", 1);
+            // Sandboxed services get their own PID from Sandbox::exec
+            setenv("LISTEN_PID", std::to_string(getpid()).c_str(), 1);
+        }
+        if (notify) {
+            setenv("NOTIFY_SOCKET", notify_->socketPath().c_str(), 1);
+            if (watchdogUsec != "0") {
+                setenv("WATCHDOG_USEC", watchdogUsec.c_str(), 1);
+                setenv("WATCHDOG_PID", std::to_string(getpid()).c_str(), 1);
+            }
+        }
+        setenv("SERVICEMN_COLOR", green ? "green" : "blue", 1);
+        if (standby) {
+            setenv("SERVICEMN_STANDBY", "1", 1);
+        }
+        if (!memory.empty()) {
+            memory.apply();
+        }
+        
+        // Change working directory if specified (through the cached descriptor when resolved)
+        if (target.FolderFd >= 0) {
+            if (fchdir(target.FolderFd) != 0) {
+                reportExecFailure(execPipe[1]);
+                perror("ProcessRunner::start: fchdir failed");
+                _exit(1);
+            }
+        } else if (!cmd.Folder.empty() && cmd.Folder != ".") {
             if (chdir(cmd.Folder.c_str()) != 0) {
+                reportExecFailure(execPipe[1]);
                 perror("ProcessRunner::start: chdir failed");
                 _exit(1);
             }
         }
         
-        if (cmd.Mode == 'C') {
-            // Regular command execution
+        if (cmd.native()) {
+            // Regular command execution, optionally inside a namespace sandbox
             auto parts = splitCommand(cmd.Path);
             if (parts.empty()) {
                 std::cerr << "ProcessRunner::start: No command parts found" << std::endl;
+                errno = EINVAL;
+                reportExecFailure(execPipe[1]);
                 _exit(1);
             }
             
@@ -108,8 +655,17 @@ pid_t ProcessRunner::start(size_t index) {
             }
             argv.push_back(nullptr);
             
-            // Execute command
+            // The sandbox re-resolves by path: cached descriptors would escape its mounts
+            if (cmd.Mode == 'S') {
+                Sandbox::exec(cmd, argv.data(), execPipe[1]);
+            }
+            
+            // Execute command; execvp() still runs scripts without a shebang through sh
+            if (!target.Path.empty()) {
+                execve(target.Path.c_str(), argv.data(), environ);
+            }
             execvp(argv[0], argv.data());
+            reportExecFailure(execPipe[1]);
             perror("ProcessRunner::start: execvp failed (C mode)");
             _exit(1);
             
@@ -141,14 +697,28 @@ pid_t ProcessRunner::start(size_t index) {
         }
     } else {
         // PARENT PROCESS
-        cmd.Pid = pid;
-        cmd.Status = RUNNING;
-        std::cout << "Process started successfully (PID: " << pid << ")" << std::endl;
+        if (target.FolderFd >= 0) {
+            close(target.FolderFd);
+        }
+        if (capture) {
+            close(outPipes[0][1]);
+            close(outPipes[1][1]);
+            logs_->attach(index, outPipes[0][0], outPipes[1][0]);
+        }
+        if (execPipe[0] >= 0) {
+            close(execPipe[1]);
+            analyzer_->execPipe(index, pid, execPipe[0]);
+        }
+        if (boost_ && !standby) {
+            boost_->spawned(index, pid);
+        }
         return pid;
     }
 }
 
 bool ProcessRunner::kill(size_t index, bool force) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
     // Validate index
     if (index >= commands_.size()) {
         std::cerr << "ProcessRunner::kill: Invalid index " << index << std::endl;
@@ -166,12 +736,14 @@ bool ProcessRunner::kill(size_t index, bool force) {
     std::cout << "Terminating process: " << cmd.Desc << " (PID: " << cmd.Pid 
               << ", force: " << (force ? "yes" : "no") << ")" << std::endl;
     
-    if (cmd.Mode == 'C') {
-        // Regular process termination
+    if (cmd.native()) {
+        // Regular process termination (a sandbox forwards the signal to its service)
         int signal = force ? SIGKILL : SIGTERM;
         if (::kill(cmd.Pid, signal) == 0) {
             cmd.Status = DEAD;
             cmd.Pid = -1;
+            notifyChange();
+            releaseAdopted(index);
             std::cout << "Process terminated successfully" << std::endl;
             return true;
         } else {
@@ -208,6 +780,7 @@ bool ProcessRunner::kill(size_t index, bool force) {
             if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
                 cmd.Status = DEAD;
                 cmd.Pid = -1;
+                notifyChange();
                 std::cout << "Docker container terminated successfully" << std::endl;
                 return true;
             } else {
@@ -222,6 +795,7 @@ bool ProcessRunner::kill(size_t index, bool force) {
 }
 
 pid_t ProcessRunner::getPid(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (index >= commands_.size()) {
         return -1;
     }
@@ -229,6 +803,7 @@ pid_t ProcessRunner::getPid(size_t index) const {
 }
 
 bool ProcessRunner::isRunning(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (index >= commands_.size()) {
         return false;
     }
@@ -238,3 +813,164 @@ bool ProcessRunner::isRunning(size_t index) const {
 size_t ProcessRunner::getCommandCount() const {
     return commands_.size();
 }
+
+command ProcessRunner::getCommand(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= commands_.size()) {
+        return command();
+    }
+    return commands_[index];
+}
+
+void ProcessRunner::markDead(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= commands_.size()) {
+        return;
+    }
+    commands_[index].Status = DEAD;
+    commands_[index].Pid = -1;
+    notifyChange();
+    releaseAdopted(index);
+}
+
+void ProcessRunner::reap() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        bool claimed = false;
+        for (auto& cmd : commands_) {
+            if (cmd.Pid == pid && cmd.native() && !cmd.Adopted) {
+                std::cout << "Process exited: " << cmd.Desc << " (PID: " << pid << ")" << std::endl;
+                cmd.Status = DEAD;
+                cmd.Pid = -1;
+                notifyChange();
+                claimed = true;
+            }
+        }
+        // Helpers such as warm-up commands; keep the status for exitStatus()
+        if (!claimed) {
+            unclaimedExits_[pid] = status;
+            if (unclaimedExits_.size() > MAX_UNCLAIMED_EXITS) {
+                unclaimedExits_.erase(unclaimedExits_.begin());
+            }
+        }
+    }
+    
+    // Adopted processes cannot be waited for; a pidfd becomes readable on exit
+    for (size_t i = 0; i < commands_.size(); ++i) {
+        command& cmd = commands_[i];
+        if (!cmd.Adopted) {
+            continue;
+        }
+        bool exited = cmd.Status != RUNNING;
+        auto it = adoptedPidfds_.find(i);
+        if (!exited && it != adoptedPidfds_.end()) {
+            struct pollfd pfd = {it->second, POLLIN, 0};
+            exited = poll(&pfd, 1, 0) > 0;
+        } else if (!exited) {
+            exited = ::kill(cmd.Pid, 0) != 0 && errno == ESRCH;
+        }
+        if (exited) {
+            if (cmd.Status == RUNNING) {
+                std::cout << "Adopted process exited: " << cmd.Desc << " (PID: " << cmd.Pid << ")" << std::endl;
+            }
+            cmd.Status = DEAD;
+            cmd.Pid = -1;
+            notifyChange();
+            releaseAdopted(i);
+        }
+    }
+}
+
+void ProcessRunner::releaseAdopted(size_t index) {
+    commands_[index].Adopted = false;
+    auto it = adoptedPidfds_.find(index);
+    if (it != adoptedPidfds_.end()) {
+        close(it->second);
+        adoptedPidfds_.erase(it);
+    }
+}
+
+bool ProcessRunner::adopt(size_t index, pid_t pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (index >= commands_.size() || pid <= 0) {
+        std::cerr << "ProcessRunner::adopt: Invalid index " << index << std::endl;
+        return false;
+    }
+    
+    command& cmd = commands_[index];
+    if (cmd.Status == RUNNING && cmd.Pid > 0) {
+        std::cerr << "ProcessRunner::adopt: Process already running (PID: " 
+                  << cmd.Pid << ")" << std::endl;
+        return false;
+    }
+    
+    int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd < 0 && errno == ESRCH) {
+        return false;
+    }
+    if (pidfd >= 0) {
+        adoptedPidfds_[index] = pidfd;
+    }
+    
+    cmd.Pid = pid;
+    cmd.Status = RUNNING;
+    notifyChange();
+    cmd.Adopted = true;
+    std::cout << "Adopted running process: " << cmd.Desc << " (PID: " << pid << ")" << std::endl;
+    return true;
+}
+
+void ProcessRunner::setCgroupManager(const CgroupManager* cgroups) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cgroups_ = cgroups;
+}
+
+void ProcessRunner::setWarmPool(WarmPool* pool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_ = pool;
+}
+
+void ProcessRunner::setCheckpointer(Checkpointer* checkpoints) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkpoints_ = checkpoints;
+}
+
+void ProcessRunner::setNotifyMonitor(const NotifyMonitor* notify) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    notify_ = notify;
+}
+
+void ProcessRunner::setBootAnalyzer(BootAnalyzer* analyzer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    analyzer_ = analyzer;
+}
+
+void ProcessRunner::setStartupBoost(StartupBoost* boost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    boost_ = boost;
+}
+
+void ProcessRunner::setExecCache(ExecCache* cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exec_ = cache;
+}
+
+void ProcessRunner::setChangeListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    changeListener_ = std::move(listener);
+}
+
+void ProcessRunner::notifyChange() {
+    if (changeListener_) {
+        changeListener_();
+    }
+}
+
+void ProcessRunner::setLogCollector(LogCollector* collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    logs_ = collector;
+}
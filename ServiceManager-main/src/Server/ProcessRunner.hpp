@@ -9,7 +9,21 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <sys/types.h>
 #include "command.hpp"
+#include "Coroutine.hpp"
+
+class CgroupManager;
+class LogCollector;
+class WarmPool;
+class Checkpointer;
+class NotifyMonitor;
+class BootAnalyzer;
+class StartupBoost;
+class ExecCache;
 
 /**
  * @brief Process management class
@@ -37,13 +51,101 @@ public:
     /**
      * @brief Start a process at the specified index
      * @param index Index of the command in the commands vector
-     * @return Process ID on success, -1 on failure
+     * @param alreadyRunning If given, set to whether the process was already running
+     * @return Process ID on success (the existing one if already running),
+     *         0 if the command is being restored from its checkpoint, -1 on failure
      * 
      * Forks a new process and executes the command based on its mode:
      * - Mode 'C': Executes as a regular system command
+     * - Mode 'S': Executes the command in fresh namespaces (see Sandbox)
      * - Mode 'D': Executes as a Docker container using 'docker start'
+     * 
+     * If the command has a warm pool, a ready standby instance is handed
+     * out instead of forking a new process. Otherwise a command with a
+     * checkpoint image is restored from it on the event loop (see restore()).
+     */
+    pid_t start(size_t index, bool* alreadyRunning = nullptr);
+    
+    /**
+     * @brief Start a process and wait for a checkpoint restore to finish (event loop thread)
+     * @param index Index of the command in the commands vector
+     * @return Process ID on success, -1 on failure
+     */
+    Task<pid_t> startAsync(size_t index);
+    
+    /**
+     * @brief Finish a start served from a checkpoint image (event loop thread)
+     * @param index Index of the command in the commands vector
+     * @return Process ID of the started instance, -1 on failure
+     * 
+     * criu runs without the runner locked; the restored PID is installed
+     * afterwards, or the command is launched normally if the restore failed.
+     * Like a launched instance, the restored process tree is moved into the
+     * service cgroup and boosted.
+     */
+    Task<pid_t> restore(size_t index);
+    
+    /**
+     * @brief Start an idle standby instance of a command for its warm pool
+     * @param index Index of the command in the commands vector
+     * @return Process ID of the standby, -1 on failure
+     * 
+     * The standby runs like a regular instance (cgroup, capture, listener)
+     * with SERVICEMN_STANDBY=1 in its environment but is not recorded until
+     * the pool hands it out from start().
+     */
+    pid_t startStandby(size_t index);
+    
+    /**
+     * @brief Start an additional instance of a running command
+     * @param index Index of the command in the commands vector
+     * @param ownListener Give the instance its own "@listen" socket that gets
+     *                    no connections before promote() (blue/green swaps)
+     * @return Process ID of the new instance, -1 on failure
+     * 
+     * The new instance shares the command's cgroup, log capture and
+     * listener but is not recorded, and gets the other color; the command
+     * keeps reporting its current instance until promote() is called. Only
+     * native commands (modes 'C' and 'S') can surge.
+     */
+    pid_t startSurge(size_t index, bool ownListener = false);
+    
+    /**
+     * @brief Make a surge instance the command's current instance
+     * @param index Index of the command in the commands vector
+     * @param pid Process ID returned by startSurge()
+     * 
+     * The previous instance is not signalled; the caller stops it. If the
+     * surge instance has its own listener, new connections go to it from
+     * now on, and the previous listener only keeps the connections already
+     * queued on it until releaseSwapListener().
+     */
+    void promote(size_t index, pid_t pid);
+    
+    /**
+     * @brief Close the listener a swap no longer needs
+     * @param index Index of the command in the commands vector
+     * 
+     * After promote() this is the previous instance's listener, otherwise
+     * the listener of the surge instance that is being abandoned.
+     * Connections still queued on it are reset.
+     */
+    void releaseSwapListener(size_t index);
+    
+    /**
+     * @brief Color of a command's current instance
+     * @param index Index of the command in the commands vector
+     * @return "blue" or "green" (passed to instances as SERVICEMN_COLOR)
      */
-    pid_t start(size_t index);
+    const char* color(size_t index) const;
+    
+    /**
+     * @brief Collect the exit status of a helper child that is no command's instance
+     * @param pid Process ID of the exited child
+     * @param status Receives the wait status
+     * @return false if the child has not exited (or was never seen)
+     */
+    bool exitStatus(pid_t pid, int& status);
     
     /**
      * @brief Terminate a process at the specified index
@@ -75,9 +177,96 @@ public:
      * @return Number of commands in the vector
      */
     size_t getCommandCount() const;
-
-private:
-    std::vector<command>& commands_;  ///< Reference to managed commands
+    
+    /**
+     * @brief Get a consistent copy of a command
+     * @param index Index of the command in the commands vector
+     * @return Copy of the command (default-constructed if index is invalid)
+     */
+    command getCommand(size_t index) const;
+    
+    /**
+     * @brief Record that a command was stopped by other means
+     * @param index Index of the command in the commands vector
+     * 
+     * Used when a service is stopped without kill(), e.g. through the
+     * Docker API by the orchestrator.
+     */
+    void markDead(size_t index);
+    
+    /**
+     * @brief Collect exited children and mark their commands as dead
+     * 
+     * Non-blocking; intended to be called periodically (e.g. by the sampler).
+     * Docker-mode entries keep their status because the tracked PID is only
+     * the short-lived 'docker start' client.
+     */
+    void reap();
+    
+    /**
+     * @brief Take over management of a process started outside ServiceMN
+     * @param index Index of the command in the commands vector
+     * @param pid Process ID of the running instance
+     * @return true on success, false if the command is already running
+     * 
+     * Adopted processes are not children of ServiceMN; their exit is
+     * detected through a pidfd (or kill(pid, 0) on kernels without pidfds).
+     */
+    bool adopt(size_t index, pid_t pid);
+    
+    /**
+     * @brief Place spawned processes into per-service cgroups
+     * @param cgroups Cgroup manager (nullptr disables placement)
+     */
+    void setCgroupManager(const CgroupManager* cgroups);
+    
+    /**
+     * @brief Hand out pre-started standby instances on start()
+     * @param pool Warm pool (nullptr always forks)
+     */
+    void setWarmPool(WarmPool* pool);
+    
+    /**
+     * @brief Set the checkpointer used to restore commands from images
+     * @param checkpoints Checkpointer (nullptr always forks)
+     */
+    void setCheckpointer(Checkpointer* checkpoints);
+    
+    /**
+     * @brief Start "@notify" services with NOTIFY_SOCKET (and watchdog variables)
+     * @param notify Notification receiver (nullptr starts them without)
+     */
+    void setNotifyMonitor(const NotifyMonitor* notify);
+    
+    /**
+     * @brief Confirm exec() of services started by a boot through a close-on-exec pipe
+     * @param analyzer Boot recorder (nullptr = no confirmation)
+     */
+    void setBootAnalyzer(BootAnalyzer* analyzer);
+    
+    /**
+     * @brief Boost the priority of "@boost" services from fork until ready
+     * @param boost Startup boost (nullptr = no boost)
+     */
+    void setStartupBoost(StartupBoost* boost);
+    
+    /**
+     * @brief Exec native services through resolved paths and folder descriptors
+     * @param cache Exec cache (nullptr = chdir() and execvp() in the child)
+     */
+    void setExecCache(ExecCache* cache);
+    
+    /**
+     * @brief Set a callback invoked whenever a command starts or stops
+     * @param listener Called with the runner locked; must not call back into it
+     */
+    void setChangeListener(std::function<void()> listener);
+    
+    /**
+     * @brief Capture stdout/stderr of spawned processes
+     * @param collector Log collector (nullptr leaves output inherited)
+     */
+    void setLogCollector(LogCollector* collector);
     
     /**
      * @brief Split command line into individual arguments
@@ -85,4 +274,68 @@ private:
      * @return Vector of command arguments
      */
     static std::vector<std::string> splitCommand(const std::string& cmdline);
+
+private:
+    std::vector<command>& commands_;  ///< Reference to managed commands
+    mutable std::mutex mutex_;        ///< Serializes state changes between API and background threads
+    const CgroupManager* cgroups_ = nullptr; ///< Optional per-service cgroup placement
+    LogCollector* logs_ = nullptr;           ///< Optional output capture
+    WarmPool* pool_ = nullptr;               ///< Optional standby instances
+    Checkpointer* checkpoints_ = nullptr;    ///< Optional CRIU fast starts
+    const NotifyMonitor* notify_ = nullptr;  ///< Optional sd_notify() socket
+    BootAnalyzer* analyzer_ = nullptr;       ///< Optional boot timelines
+    StartupBoost* boost_ = nullptr;          ///< Optional startup priority boost
+    ExecCache* exec_ = nullptr;              ///< Optional exec resolution cache
+    std::function<void()> changeListener_;   ///< Optional state change notification
+    std::map<size_t, int> adoptedPidfds_;    ///< pidfds of adopted processes by command index
+    std::map<size_t, int> listeners_;        ///< "@listen" sockets by command index
+    std::map<size_t, int> swapListeners_;    ///< Second listener of a swap in progress
+    std::map<size_t, bool> colors_;          ///< true if the current instance is green
+    std::map<pid_t, int> unclaimedExits_;    ///< Wait statuses of reaped helper children
+    std::map<size_t, std::shared_ptr<AsyncEvent>> restoring_; ///< Restores in progress, set when done
+    
+    /**
+     * @brief Forget adoption bookkeeping of a command (caller holds mutex_)
+     * @param index Index of the command in the commands vector
+     */
+    void releaseAdopted(size_t index);
+    
+    /**
+     * @brief Invoke the change listener, if any (caller holds mutex_)
+     */
+    void notifyChange();
+    
+    /**
+     * @brief Fork and exec a command with its cgroup and capture (caller holds mutex_)
+     * @param index Index of the command in the commands vector
+     * @param green Start the instance as green instead of blue
+     * @param standby Mark the instance as a warm pool standby
+     * @param listenFd Listener to pass instead of the command's own (-1 = the command's)
+     * @return Process ID on success, -1 on failure
+     */
+    pid_t launch(size_t index, bool green, bool standby, int listenFd = -1);
+    
+    /**
+     * @brief Start a command unless a checkpoint restore has to run first (caller holds mutex_)
+     * @param index Index of the command in the commands vector
+     * @param alreadyRunning If given, set to whether the process was already running
+     * @param restore Set to true if the caller has to run restore()
+     * @return As start()
+     */
+    pid_t startLocked(size_t index, bool* alreadyRunning, bool& restore);
+    
+    /**
+     * @brief Get (and on first use bind) the listener of a command (caller holds mutex_)
+     * @param index Index of the command in the commands vector
+     * @return Listening socket, or -1 if it cannot be bound
+     */
+    int listener(size_t index);
+    
+    /**
+     * @brief Bind a second listener for a swap that gets no connections yet (caller holds mutex_)
+     * @param index Index of the command in the commands vector
+     * @return Listening socket, or -1 on failure
+     */
+    int swapListener(size_t index);
+
 };
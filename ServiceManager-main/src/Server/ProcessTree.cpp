@@ -0,0 +1,208 @@
+/**
+ * @file ProcessTree.cpp
+ * @brief Implementation of the per-service process trees and FD leak detection
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "ProcessTree.hpp"
+#include "ProcessDiscovery.hpp"
+#include "ProcessRunner.hpp"
+#include "EventLog.hpp"
+
+#include <fcntl.h>          // open, O_DIRECTORY
+#include <unistd.h>         // read, close, sysconf
+#include <sys/syscall.h>    // SYS_getdents64
+#include <cstdio>           // snprintf
+#include <cstdlib>          // strtoull
+#include <cstring>          // strrchr, strchr
+
+namespace {
+
+constexpr size_t FD_DIRENT_BUFFER = 32768;
+
+struct ProcStat {
+    uint64_t CpuTicks = 0;
+    uint64_t StartTime = 0;
+    uint64_t RssPages = 0;
+    int      Threads = 0;
+};
+
+/// Read CPU time, thread count, start time and RSS from /proc/<pid>/stat
+bool readProcStat(pid_t pid, ProcStat& stat) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buf[1024];
+    ssize_t length = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (length <= 0) {
+        return false;
+    }
+    buf[length] = '\0';
+
+    // Fields resume after the last ')' of the command name
+    char* p = strrchr(buf, ')');
+    if (!p) {
+        return false;
+    }
+    p += 2;
+    for (int field = 3; field <= 24 && p; ++field) {
+        switch (field) {
+            case 14: stat.CpuTicks = strtoull(p, nullptr, 10); break;
+            case 15: stat.CpuTicks += strtoull(p, nullptr, 10); break;
+            case 20: stat.Threads = static_cast<int>(strtol(p, nullptr, 10)); break;
+            case 22: stat.StartTime = strtoull(p, nullptr, 10); break;
+            case 24: stat.RssPages = strtoull(p, nullptr, 10); return true;
+            default: break;
+        }
+        p = strchr(p, ' ');
+        if (p) {
+            ++p;
+        }
+    }
+    return false;
+}
+
+/// Count the entries of /proc/<pid>/fd (-1 if unreadable)
+int countFds(pid_t pid, std::vector<char>& buffer) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/fd", pid);
+    int dir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) {
+        return -1;
+    }
+    int count = 0;
+    for (;;) {
+        long bytes = syscall(SYS_getdents64, dir, buffer.data(), buffer.size());
+        if (bytes <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < bytes;) {
+            // d_ino, d_off, d_reclen, d_type, d_name (see getdents64(2))
+            const char* record = buffer.data() + offset;
+            unsigned short reclen;
+            memcpy(&reclen, record + 16, sizeof(reclen));
+            if (record[19] != '.') {
+                ++count;
+            }
+            offset += reclen;
+        }
+    }
+    close(dir);
+    return count;
+}
+
+} // namespace
+
+ProcessTree::ProcessTree(ProcessRunner& runner, const ProcessDiscovery& discovery, EventLog& events)
+    : runner_(runner), discovery_(discovery), events_(events) {
+    size_t count = runner_.getCommandCount();
+    policies_.resize(count);
+    trees_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        command cmd = runner_.getCommand(i);
+        FdLeakPolicy& policy = policies_[i];
+        policy.Window = std::chrono::seconds(static_cast<int64_t>(
+            cmd.optionNumber("fd.leak_window", static_cast<double>(policy.Window.count()))));
+        policy.Growth = static_cast<int>(cmd.optionNumber("fd.leak_growth", policy.Growth));
+    }
+}
+
+void ProcessTree::onSample(const std::vector<ServiceSample>& samples) {
+    static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    static const long pageKb = sysconf(_SC_PAGESIZE) / 1024;
+    auto now = std::chrono::steady_clock::now();
+    std::vector<char> buffer(FD_DIRENT_BUFFER);
+    std::vector<std::vector<TreeProcess>> trees(trees_.size());
+    std::unordered_map<pid_t, Tracked> seen;
+
+    for (size_t i = 0; i < samples.size() && i < trees.size(); ++i) {
+        if (samples[i].Pid <= 0) {
+            continue;
+        }
+        std::vector<ProcEntry> entries = discovery_.descendants(samples[i].Pid);
+        if (entries.empty()) {
+            // Started after the last discovery pass: only the main process is known
+            ProcEntry root;
+            root.Pid = samples[i].Pid;
+            entries.push_back(root);
+        }
+
+        std::unordered_map<pid_t, int> depths;
+        for (const ProcEntry& entry : entries) {
+            ProcStat stat;
+            if (!readProcStat(entry.Pid, stat)) {
+                continue;  // Exited since the pass
+            }
+            TreeProcess process;
+            process.Pid = entry.Pid;
+            process.PPid = entry.PPid;
+            auto parent = depths.find(entry.PPid);
+            process.Depth = parent == depths.end() ? 0 : parent->second + 1;
+            depths[entry.Pid] = process.Depth;
+            process.Cmdline = entry.Cmdline;
+            process.RssKb = stat.RssPages * pageKb;
+            process.Threads = stat.Threads;
+            process.Fds = countFds(entry.Pid, buffer);
+
+            Tracked tracked;
+            auto previous = tracked_.find(entry.Pid);
+            if (previous != tracked_.end() && previous->second.StartTime == stat.StartTime) {
+                tracked = previous->second;
+                std::chrono::duration<double> elapsed = now - tracked.At;
+                if (elapsed.count() > 0 && stat.CpuTicks >= tracked.CpuTicks) {
+                    double seconds = static_cast<double>(stat.CpuTicks - tracked.CpuTicks) / ticksPerSecond;
+                    process.CpuPercent = seconds / elapsed.count() * 100.0;
+                }
+            }
+            tracked.StartTime = stat.StartTime;
+            tracked.CpuTicks = stat.CpuTicks;
+            tracked.At = now;
+            process.FdLeak = checkLeak(i, process, tracked, now);
+            seen[entry.Pid] = tracked;
+            trees[i].push_back(std::move(process));
+        }
+    }
+
+    // Processes no longer in any tree are forgotten
+    tracked_ = std::move(seen);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    trees_ = std::move(trees);
+}
+
+bool ProcessTree::checkLeak(size_t index, TreeProcess& process, Tracked& tracked,
+                            std::chrono::steady_clock::time_point now) {
+    const FdLeakPolicy& policy = policies_[index];
+    if (policy.Growth <= 0 || process.Fds < 0) {
+        return false;
+    }
+    // A drop ends the growth run; the count must rise again for a whole window
+    if (tracked.FdLast < 0 || process.Fds < tracked.FdLast) {
+        tracked.FdBase = process.Fds;
+        tracked.FdSince = now;
+        tracked.Reported = false;
+    }
+    tracked.FdLast = process.Fds;
+
+    bool leaking = now - tracked.FdSince >= policy.Window &&
+                   process.Fds - tracked.FdBase >= policy.Growth;
+    if (leaking && !tracked.Reported) {
+        tracked.Reported = true;
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now - tracked.FdSince).count();
+        events_.record(static_cast<int>(index), "fd.leak",
+                       "PID " + std::to_string(process.Pid) + " FD count grew from " +
+                       std::to_string(tracked.FdBase) + " to " + std::to_string(process.Fds) +
+                       " over " + std::to_string(seconds) + "s without decreasing: " + process.Cmdline);
+    }
+    return leaking;
+}
+
+std::vector<TreeProcess> ProcessTree::tree(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index < trees_.size() ? trees_[index] : std::vector<TreeProcess>();
+}
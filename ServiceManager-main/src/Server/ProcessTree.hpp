@@ -0,0 +1,110 @@
+/**
+ * @file ProcessTree.hpp
+ * @brief Per-service process trees with CPU, memory and FD usage, and FD leak detection
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+#include "ResourceSampler.hpp"
+
+class ProcessRunner;
+class ProcessDiscovery;
+class EventLog;
+
+/**
+ * @brief One process of a service's tree at the last sampling tick
+ */
+struct TreeProcess {
+    pid_t       Pid = -1;
+    pid_t       PPid = -1;
+    int         Depth = 0;         ///< 0 for the service's main process
+    std::string Cmdline;
+    double      CpuPercent = 0.0;  ///< Usage since the previous tick (100 = one full core)
+    uint64_t    RssKb = 0;
+    int         Threads = 0;
+    int         Fds = -1;          ///< Open file descriptors (-1 if unreadable)
+    bool        FdLeak = false;    ///< FD count grew without pause for the leak window
+};
+
+/**
+ * @brief FD leak detection settings of a service
+ *
+ * Read from the service's options:
+ * - fd.leak_window  seconds the FD count of a process must keep growing
+ * - fd.leak_growth  FDs it must have gained over that time (0 disables detection)
+ */
+struct FdLeakPolicy {
+    std::chrono::seconds Window{60};
+    int                  Growth = 64;
+};
+
+/**
+ * @brief Sampler listener keeping the process tree of every service
+ *
+ * Runs after ProcessDiscovery::scan() on each sampler tick and walks the
+ * parent-to-children index built by that pass, so the tick costs one /proc
+ * listing for all services together, plus a stat read and an fd directory
+ * listing per process that belongs to a service tree.
+ *
+ * The same per-process FD counts drive leak detection: a process whose FD
+ * count never decreases for "@fd.leak_window" seconds while growing by at
+ * least "@fd.leak_growth" is reported once with an fd.leak event, and again
+ * only after its count has dropped.
+ */
+class ProcessTree {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param discovery Discovery scanner providing the /proc index
+     * @param events Event log receiving leak events
+     */
+    ProcessTree(ProcessRunner& runner, const ProcessDiscovery& discovery, EventLog& events);
+
+    ProcessTree(const ProcessTree&) = delete;
+    ProcessTree& operator=(const ProcessTree&) = delete;
+
+    /**
+     * @brief Refresh all trees (register with ResourceSampler::addListener after the discovery scan)
+     * @param samples Latest samples indexed like the commands
+     */
+    void onSample(const std::vector<ServiceSample>& samples);
+
+    /**
+     * @brief Get the tree of a service, depth-first with the main process first
+     * @param index Command index
+     */
+    std::vector<TreeProcess> tree(size_t index) const;
+
+private:
+    struct Tracked {
+        uint64_t StartTime = 0;   ///< Guards against PID reuse
+        uint64_t CpuTicks = 0;    ///< utime + stime at the previous tick
+        std::chrono::steady_clock::time_point At;
+        int      FdBase = -1;     ///< FD count when the current growth run started
+        int      FdLast = -1;
+        std::chrono::steady_clock::time_point FdSince;
+        bool     Reported = false;
+    };
+
+    ProcessRunner&                  runner_;
+    const ProcessDiscovery&         discovery_;
+    EventLog&                       events_;
+    std::vector<FdLeakPolicy>       policies_;
+    std::unordered_map<pid_t, Tracked> tracked_;  ///< Sampler thread only
+    mutable std::mutex              mutex_;       ///< Guards trees_
+    std::vector<std::vector<TreeProcess>> trees_;
+
+    bool checkLeak(size_t index, TreeProcess& process, Tracked& tracked,
+                   std::chrono::steady_clock::time_point now);
+};
@@ -0,0 +1,202 @@
+/**
+ * @file ResourceSampler.cpp
+ * @brief Implementation of periodic per-service resource sampling
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "ResourceSampler.hpp"
+#include "ProcessRunner.hpp"
+#include "CgroupManager.hpp"
+#include "ContainerStats.hpp"
+
+#include <unistd.h>     // sysconf
+#include <fstream>      // std::ifstream
+#include <sstream>      // std::istringstream
+#include <string>       // std::string
+
+ResourceSampler::ResourceSampler(ProcessRunner& runner, const CgroupManager* cgroups,
+                                 std::chrono::milliseconds interval)
+    : runner_(runner), cgroups_(cgroups), interval_(interval) {
+    counters_.resize(runner_.getCommandCount());
+    samples_.resize(runner_.getCommandCount());
+}
+
+ResourceSampler::~ResourceSampler() {
+    stop();
+}
+
+void ResourceSampler::addListener(Listener listener) {
+    listeners_.push_back(std::move(listener));
+}
+
+void ResourceSampler::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&ResourceSampler::run, this);
+}
+
+void ResourceSampler::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::vector<ServiceSample> ResourceSampler::latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_;
+}
+
+void ResourceSampler::run() {
+    while (running_) {
+        tick();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        wakeup_.wait_for(lock, interval_, [this] { return !running_; });
+    }
+}
+
+void ResourceSampler::tick() {
+    runner_.reap();
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<ServiceSample> fresh(counters_.size());
+
+    for (size_t i = 0; i < counters_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        ServiceSample& sample = fresh[i];
+        Counter& counter = counters_[i];
+
+        if (cmd.Status != RUNNING || cmd.Pid <= 0) {
+            counter = Counter();
+            continue;
+        }
+        sample.Pid = cmd.Pid;
+        sample.ServicePid = cmd.Pid;
+
+        uint64_t cpuTimeUs = 0;
+        uint64_t rssKb = 0;
+        if (cmd.Mode == 'D') {
+            ContainerUsage usage;
+            if (!containers_ || !containers_->sample(i, cmd, usage)) {
+                counter = Counter();
+                continue;
+            }
+            cpuTimeUs = usage.CpuTimeUs;
+            rssKb = usage.MemoryBytes / 1024;
+            sample.IoReadBytes = usage.IoReadBytes;
+            sample.IoWriteBytes = usage.IoWriteBytes;
+        } else {
+            // A sandbox's PID is its supervisor, a fork of ServiceMN, not the service
+            pid_t pid = cmd.Mode == 'S' ? sandboxedService(cmd.Pid) : cmd.Pid;
+            sample.ServicePid = pid;
+            bool haveProcess = pid > 0 && readProcess(pid, cpuTimeUs, rssKb);
+            uint64_t cgroupCpuUs = 0;
+            if (readCgroupCpu(i, cgroupCpuUs)) {
+                cpuTimeUs = cgroupCpuUs;  // Includes every descendant of the service
+            } else if (!haveProcess) {
+                counter = Counter();
+                continue;
+            }
+        }
+        sample.CpuTimeUs = cpuTimeUs;
+        sample.RssKb = rssKb;
+
+        // First reading for this PID only establishes the baseline
+        if (counter.Pid == cmd.Pid && cpuTimeUs >= counter.CpuTimeUs) {
+            auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - counter.At).count();
+            if (elapsedUs > 0) {
+                sample.CpuPercent = 100.0 * static_cast<double>(cpuTimeUs - counter.CpuTimeUs)
+                                    / static_cast<double>(elapsedUs);
+            }
+        }
+        counter.Pid = cmd.Pid;
+        counter.CpuTimeUs = cpuTimeUs;
+        counter.At = now;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_ = fresh;
+    }
+
+    for (const auto& listener : listeners_) {
+        listener(fresh);
+    }
+}
+
+bool ResourceSampler::readProcess(pid_t pid, uint64_t& cpuTimeUs, uint64_t& rssKb) const {
+    static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    static const long pageSizeKb = sysconf(_SC_PAGESIZE) / 1024;
+
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) {
+        return false;
+    }
+
+    // The command name may contain spaces; fields resume after the last ')'
+    auto close = line.rfind(')');
+    if (close == std::string::npos) {
+        return false;
+    }
+    std::istringstream fields(line.substr(close + 2));
+    std::string field;
+    uint64_t utime = 0, stime = 0, rssPages = 0;
+    for (int n = 3; fields >> field; ++n) {
+        if (n == 14) {
+            utime = std::stoull(field);
+        } else if (n == 15) {
+            stime = std::stoull(field);
+        } else if (n == 24) {
+            rssPages = std::stoull(field);
+            break;
+        }
+    }
+
+    cpuTimeUs = (utime + stime) * 1000000ULL / static_cast<uint64_t>(ticksPerSecond);
+    rssKb = rssPages * static_cast<uint64_t>(pageSizeKb);
+    return true;
+}
+
+/**
+ * Supervisor -> sandbox init (PID 1 inside) -> service, found through the
+ * children lists of the first two. -1 while the service is not forked yet.
+ */
+pid_t ResourceSampler::sandboxedService(pid_t supervisor) {
+    pid_t pid = supervisor;
+    for (int level = 0; level < 2; ++level) {
+        std::string task = std::to_string(pid);
+        std::ifstream children("/proc/" + task + "/task/" + task + "/children");
+        if (!(children >> pid)) {
+            return -1;
+        }
+    }
+    return pid;
+}
+
+bool ResourceSampler::readCgroupCpu(size_t index, uint64_t& cpuTimeUs) const {
+    std::string stat;
+    if (!cgroups_ || !cgroups_->readControl(index, "cpu.stat", stat)) {
+        return false;
+    }
+    std::istringstream lines(stat);
+    std::string key;
+    uint64_t value;
+    while (lines >> key >> value) {
+        if (key == "usage_usec") {
+            cpuTimeUs = value;
+            return true;
+        }
+    }
+    return false;
+}
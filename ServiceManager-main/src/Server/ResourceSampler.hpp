@@ -0,0 +1,129 @@
+/**
+ * @file ResourceSampler.hpp
+ * @brief Periodic per-service CPU and memory sampling
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+class ProcessRunner;
+class CgroupManager;
+class ContainerStats;
+
+/**
+ * @brief Resource usage of one service at the last sampling tick
+ */
+struct ServiceSample {
+    pid_t    Pid = -1;            ///< Main process ID (-1 if not running)
+    pid_t    ServicePid = -1;     ///< Service process (for 'S' the sandboxed service, -1 until forked)
+    double   CpuPercent = 0.0;    ///< CPU usage since last tick (100 = one full core)
+    uint64_t RssKb = 0;           ///< Resident set size in KiB
+    uint64_t CpuTimeUs = 0;       ///< Cumulative CPU time in microseconds
+    uint64_t IoReadBytes = 0;     ///< Cumulative block I/O (Docker services)
+    uint64_t IoWriteBytes = 0;
+};
+
+/**
+ * @brief Background thread sampling resource usage of all managed services
+ *
+ * Every tick the sampler reaps exited children, reads CPU time and RSS of each
+ * running service (from its cgroup when available, otherwise from
+ * /proc/<pid>/stat; Docker containers through ContainerStats) and hands the
+ * fresh samples to registered listeners. A sandboxed ('S') service is read
+ * from its service process, two levels below the supervisor ServiceMN tracks.
+ * Listeners run on the sampler thread and must not block for long.
+ */
+class ResourceSampler {
+public:
+    using Listener = std::function<void(const std::vector<ServiceSample>&)>;
+
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param cgroups Optional cgroup manager for whole-service accounting
+     * @param interval Sampling period
+     */
+    ResourceSampler(ProcessRunner& runner, const CgroupManager* cgroups,
+                    std::chrono::milliseconds interval);
+
+    /**
+     * @brief Destructor - stops the sampling thread
+     */
+    ~ResourceSampler();
+
+    ResourceSampler(const ResourceSampler&) = delete;
+    ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+    /**
+     * @brief Register a callback invoked after every tick
+     * @param listener Callback receiving samples indexed like the commands
+     *
+     * Must be called before start().
+     */
+    void addListener(Listener listener);
+
+    /**
+     * @brief Sample Docker services from their container cgroups
+     * @param containers Container sampler (nullptr leaves Docker services unsampled)
+     *
+     * Must be called before start().
+     */
+    void setContainerStats(ContainerStats* containers) { containers_ = containers; }
+
+    /**
+     * @brief Start the sampling thread
+     */
+    void start();
+
+    /**
+     * @brief Stop the sampling thread and wait for it to exit
+     */
+    void stop();
+
+    /**
+     * @brief Get the most recent samples
+     * @return Copy of the samples, indexed like the commands
+     */
+    std::vector<ServiceSample> latest() const;
+
+    /**
+     * @brief Get the sampling period
+     */
+    std::chrono::milliseconds interval() const { return interval_; }
+
+private:
+    struct Counter {
+        pid_t    Pid = -1;                 ///< PID the counter belongs to
+        uint64_t CpuTimeUs = 0;            ///< CPU time at the previous tick
+        std::chrono::steady_clock::time_point At; ///< Time of the previous tick
+    };
+
+    ProcessRunner&             runner_;     ///< Source of PIDs
+    const CgroupManager*       cgroups_;    ///< Optional cgroup accounting
+    ContainerStats*            containers_ = nullptr; ///< Optional Docker container accounting
+    std::chrono::milliseconds  interval_;   ///< Sampling period
+    std::vector<Listener>      listeners_;  ///< Tick callbacks
+    std::vector<Counter>       counters_;   ///< Previous CPU readings (sampler thread only)
+    mutable std::mutex         mutex_;      ///< Guards samples_ and wakeup
+    std::condition_variable    wakeup_;     ///< Interrupts the sleep on stop()
+    std::vector<ServiceSample> samples_;    ///< Latest published samples
+    std::atomic<bool>          running_{false}; ///< Thread keep-alive flag
+    std::thread                thread_;     ///< Sampling thread
+
+    void run();
+    void tick();
+    bool readProcess(pid_t pid, uint64_t& cpuTimeUs, uint64_t& rssKb) const;
+    bool readCgroupCpu(size_t index, uint64_t& cpuTimeUs) const;
+    static pid_t sandboxedService(pid_t supervisor);
+};
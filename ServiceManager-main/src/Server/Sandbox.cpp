@@ -0,0 +1,263 @@
+/**
+ * @file Sandbox.cpp
+ * @brief Implementation of the namespace sandbox
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "Sandbox.hpp"
+
+#include <fcntl.h>          // open, AT_FDCWD
+#include <unistd.h>         // fork, execvp, chdir, getuid, syscall
+#include <signal.h>         // sigaction, sigprocmask, sigwaitinfo, kill
+#include <net/if.h>         // ifreq, IFF_UP
+#include <sys/ioctl.h>      // ioctl, SIOCGIFFLAGS, SIOCSIFFLAGS
+#include <sys/mount.h>      // mount, MS_*
+#include <sys/prctl.h>      // prctl, PR_SET_PDEATHSIG
+#include <sys/socket.h>     // socket
+#include <sys/syscall.h>    // SYS_clone3, SYS_mount_setattr
+#include <sys/wait.h>       // waitpid
+#include <sched.h>          // CLONE_NEW*
+#include <cerrno>           // errno
+#include <cstdint>          // uint64_t
+#include <cstdio>           // perror, snprintf
+#include <cstdlib>          // getenv, setenv
+#include <cstring>          // strerror
+#include <iostream>         // std::cerr
+#include <sstream>          // std::istringstream
+
+namespace {
+
+// From <linux/sched.h> and <linux/mount.h>, which clash with the glibc headers
+// (renamed, as newer glibc defines the mount ones in <sys/mount.h>)
+struct CloneArgs {
+    uint64_t Flags;
+    uint64_t PidFd;
+    uint64_t ChildTid;
+    uint64_t ParentTid;
+    uint64_t ExitSignal;
+    uint64_t Stack;
+    uint64_t StackSize;
+    uint64_t Tls;
+};
+
+struct MountAttr {
+    uint64_t AttrSet;
+    uint64_t AttrClr;
+    uint64_t Propagation;
+    uint64_t UsernsFd;
+};
+
+constexpr uint64_t ATTR_READ_ONLY = 0x00000001;
+constexpr unsigned int AT_RECURSIVE_FLAG = 0x8000;
+
+constexpr int FORWARDED_SIGNALS[] = {SIGTERM, SIGINT, SIGHUP, SIGQUIT, SIGUSR1, SIGUSR2};
+
+/// Tell ServiceMN why the service never reached exec() (see ProcessRunner::launch)
+void reportFailure(int fd) {
+    if (fd >= 0) {
+        int error = errno != 0 ? errno : EINVAL;
+        ssize_t written = write(fd, &error, sizeof(error));
+        (void)written;
+    }
+}
+
+bool writeFile(const char* path, const std::string& value) {
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t written = write(fd, value.data(), value.size());
+    close(fd);
+    return written == static_cast<ssize_t>(value.size());
+}
+
+bool setReadOnly(const char* path, bool readOnly) {
+    MountAttr attr = {};
+    (readOnly ? attr.AttrSet : attr.AttrClr) = ATTR_READ_ONLY;
+    return syscall(SYS_mount_setattr, AT_FDCWD, path, AT_RECURSIVE_FLAG, &attr, sizeof(attr)) == 0;
+}
+
+/// Bring up the loopback interface of a fresh network namespace
+bool loopbackUp() {
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    ifreq request = {};
+    snprintf(request.ifr_name, sizeof(request.ifr_name), "lo");
+    bool ok = ioctl(fd, SIOCGIFFLAGS, &request) == 0;
+    request.ifr_flags |= IFF_UP;
+    ok = ok && ioctl(fd, SIOCSIFFLAGS, &request) == 0;
+    close(fd);
+    return ok;
+}
+
+/// Map root to the creator's IDs and build the filesystem view (sandbox init side)
+bool setupNamespaces(const SandboxPolicy& policy, uid_t uid, gid_t gid) {
+    // Unprivileged gid mappings require setgroups() to be disabled first
+    if (!writeFile("/proc/self/setgroups", "deny") ||
+        !writeFile("/proc/self/uid_map", "0 " + std::to_string(uid) + " 1") ||
+        !writeFile("/proc/self/gid_map", "0 " + std::to_string(gid) + " 1")) {
+        perror("Sandbox: user namespace mapping failed");
+        return false;
+    }
+
+    // Keep every mount change inside the sandbox
+    if (mount(nullptr, "/", nullptr, MS_REC | MS_PRIVATE, nullptr) != 0) {
+        perror("Sandbox: making mounts private failed");
+        return false;
+    }
+    if (!setReadOnly("/", true)) {
+        perror("Sandbox: read-only root failed");
+        return false;
+    }
+    for (const std::string& path : policy.Writable) {
+        if (mount(path.c_str(), path.c_str(), nullptr, MS_BIND | MS_REC, nullptr) != 0 ||
+            !setReadOnly(path.c_str(), false)) {
+            std::cerr << "Sandbox: cannot make " << path << " writable: " << strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    std::string tmpfsOptions = "mode=1777,size=" + std::to_string(policy.TmpfsMb) + "m";
+    if (mount("tmpfs", "/tmp", "tmpfs", MS_NOSUID | MS_NODEV, tmpfsOptions.c_str()) != 0) {
+        perror("Sandbox: tmpfs on /tmp failed");
+        return false;
+    }
+    if (mount("proc", "/proc", "proc", MS_NOSUID | MS_NODEV | MS_NOEXEC, nullptr) != 0) {
+        perror("Sandbox: mounting /proc failed");
+        return false;
+    }
+    if (policy.PrivateNetwork && !loopbackUp()) {
+        perror("Sandbox: loopback setup failed");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Forward signals to a child and reap until it exits
+ * @param child Process to supervise
+ * @param signals Blocked set of forwarded signals plus SIGCHLD
+ * @return Exit code mirroring the child's status (128 + signal if killed)
+ */
+int supervise(pid_t child, const sigset_t& signals) {
+    for (;;) {
+        siginfo_t info;
+        int sig = sigwaitinfo(&signals, &info);
+        if (sig < 0) {
+            continue;  // EINTR
+        }
+        if (sig != SIGCHLD) {
+            kill(child, sig);
+            continue;
+        }
+        // Orphans are reparented to the sandbox init, so reap everything
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            if (pid == child) {
+                return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+            }
+        }
+    }
+}
+
+void ignoreHandler(int) {
+}
+
+} // namespace
+
+SandboxPolicy SandboxPolicy::fromCommand(const command& cmd) {
+    SandboxPolicy policy;
+    policy.PrivateNetwork = cmd.option("sandbox.network", "host") == "private";
+    policy.TmpfsMb = static_cast<int>(cmd.optionNumber("sandbox.tmpfs_mb", policy.TmpfsMb));
+    std::istringstream paths(cmd.option("sandbox.rw"));
+    std::string path;
+    while (std::getline(paths, path, ':')) {
+        if (!path.empty()) {
+            policy.Writable.push_back(path);
+        }
+    }
+    return policy;
+}
+
+void Sandbox::exec(const command& cmd, char* const argv[], int execFd) {
+    SandboxPolicy policy = SandboxPolicy::fromCommand(cmd);
+    uid_t uid = getuid();
+    gid_t gid = getgid();
+
+    // Blocked before cloning so no signal is lost before the supervisors wait for them
+    sigset_t signals;
+    sigset_t original;
+    sigemptyset(&signals);
+    for (int sig : FORWARDED_SIGNALS) {
+        sigaddset(&signals, sig);
+    }
+    sigaddset(&signals, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &signals, &original);
+
+    CloneArgs args = {};
+    args.Flags = CLONE_NEWUSER | CLONE_NEWNS | CLONE_NEWPID | (policy.PrivateNetwork ? CLONE_NEWNET : 0);
+    args.ExitSignal = SIGCHLD;
+    long init = syscall(SYS_clone3, &args, sizeof(args));
+    if (init < 0) {
+        reportFailure(execFd);
+        perror("Sandbox: clone3 failed");
+        _exit(1);
+    }
+
+    if (init == 0) {
+        // SANDBOX INIT (PID 1)
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (!setupNamespaces(policy, uid, gid)) {
+            reportFailure(execFd);
+            _exit(1);
+        }
+        // PID 1 only receives the signals it has a handler for
+        struct sigaction action = {};
+        action.sa_handler = ignoreHandler;
+        for (int sig : FORWARDED_SIGNALS) {
+            sigaction(sig, &action, nullptr);
+        }
+
+        pid_t service = fork();
+        if (service < 0) {
+            reportFailure(execFd);
+            perror("Sandbox: fork failed");
+            _exit(1);
+        }
+        if (service == 0) {
+            // SERVICE: exec() resets the handlers, the mask must be restored by hand
+            sigprocmask(SIG_SETMASK, &original, nullptr);
+            // Re-enter the working directory through the sandbox's mounts
+            if (!cmd.Folder.empty() && cmd.Folder != "." && chdir(cmd.Folder.c_str()) != 0) {
+                reportFailure(execFd);
+                perror("Sandbox: chdir failed");
+                _exit(1);
+            }
+            // sd_listen_fds() only accepts the listener if LISTEN_PID is the
+            // service itself, which is this PID inside the namespace
+            if (getenv("LISTEN_FDS")) {
+                char listenPid[16];
+                snprintf(listenPid, sizeof(listenPid), "%d", static_cast<int>(getpid()));
+                setenv("LISTEN_PID", listenPid, 1);
+            }
+            execvp(argv[0], argv);
+            reportFailure(execFd);
+            perror("Sandbox: execvp failed");
+            _exit(1);
+        }
+        // Only the service may hold the exec-confirm pipe, or its EOF never arrives
+        if (execFd >= 0) {
+            close(execFd);
+        }
+        _exit(supervise(service, signals));
+    }
+
+    // OUTER CHILD: stands in for the sandbox in ServiceMN's PID namespace
+    if (execFd >= 0) {
+        close(execFd);
+    }
+    _exit(supervise(static_cast<pid_t>(init), signals));
+}
@@ -0,0 +1,66 @@
+/**
+ * @file Sandbox.hpp
+ * @brief Namespace sandbox for 'S' mode services
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "command.hpp"
+
+/**
+ * @brief Sandbox settings of a service
+ *
+ * Read from the service's options:
+ * - sandbox.network   "host" (default) to share the host network, "private" for loopback only
+ * - sandbox.tmpfs_mb  size of the private tmpfs mounted on /tmp (default 64)
+ * - sandbox.rw        colon-separated host paths that stay writable
+ */
+struct SandboxPolicy {
+    bool                     PrivateNetwork = false;
+    int                      TmpfsMb = 64;
+    std::vector<std::string> Writable;
+
+    /**
+     * @brief Read the policy from a command's options
+     * @param cmd Command to read
+     */
+    static SandboxPolicy fromCommand(const command& cmd);
+};
+
+/**
+ * @brief Runs a command in fresh user, mount, PID and optionally network namespaces
+ *
+ * Gives container-like isolation without a daemon or an image: the forked
+ * child of ProcessRunner::launch() calls clone3() with CLONE_NEWUSER,
+ * CLONE_NEWNS and CLONE_NEWPID (plus CLONE_NEWNET for a private network).
+ * The user namespace maps root inside to ServiceMN's own UID, so no
+ * privileges are needed. The new child becomes PID 1 of the sandbox: it
+ * makes every mount read-only, mounts a private tmpfs on /tmp and a fresh
+ * /proc, re-enables the "@sandbox.rw" paths, then forks and execs the
+ * service. That's one fork, one clone3 and one exec more than a plain start,
+ * instead of a docker round trip and container setup.
+ *
+ * ServiceMN tracks the outer child. It and the sandbox init forward
+ * SIGTERM, SIGINT, SIGHUP, SIGQUIT, SIGUSR1 and SIGUSR2 to the service
+ * (PID 1 only receives signals it handles, so the service itself cannot
+ * be PID 1), reap orphans, and exit with the service's status, 128 plus
+ * the signal number if it was killed. SIGKILL on the outer child tears
+ * the whole sandbox down through the init's parent-death signal.
+ */
+class Sandbox {
+public:
+    /**
+     * @brief Replace the calling child with the sandboxed command (never returns)
+     * @param cmd Command to run; its working directory is entered inside the sandbox
+     * @param argv Command line, null-terminated
+     * @param execFd Write end of the exec-confirm pipe, handed down to the service (-1 if none)
+     *
+     * Must be called from a single-threaded process, i.e. after fork().
+     */
+    [[noreturn]] static void exec(const command& cmd, char* const argv[], int execFd);
+};
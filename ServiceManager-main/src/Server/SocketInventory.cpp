@@ -0,0 +1,226 @@
+/**
+ * @file SocketInventory.cpp
+ * @brief Implementation of the netlink sock_diag socket inventory
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "SocketInventory.hpp"
+#include "ProcessTree.hpp"
+
+#include <fcntl.h>               // open, O_DIRECTORY
+#include <unistd.h>              // readlinkat, close
+#include <arpa/inet.h>           // inet_ntop, ntohs
+#include <netinet/in.h>          // IPPROTO_TCP, IPPROTO_UDP
+#include <sys/socket.h>          // socket, sendto, recv
+#include <sys/syscall.h>         // SYS_getdents64
+#include <linux/inet_diag.h>     // inet_diag_req_v2, inet_diag_msg
+#include <linux/netlink.h>       // nlmsghdr, NLMSG_*
+#include <linux/sock_diag.h>     // SOCK_DIAG_BY_FAMILY
+#include <cerrno>                // errno
+#include <cstdio>                // snprintf
+#include <cstdlib>               // strtoull
+#include <cstring>               // memcpy, strncmp, strerror
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 65536;
+
+// TCP states as reported in idiag_state (include/net/tcp_states.h)
+constexpr uint8_t TCP_STATE_ESTABLISHED = 1;
+constexpr uint8_t TCP_STATE_SYN_RECV = 3;
+constexpr uint8_t TCP_STATE_TIME_WAIT = 6;
+constexpr uint8_t TCP_STATE_CLOSE = 7;
+constexpr uint8_t TCP_STATE_LISTEN = 10;
+constexpr uint8_t TCP_STATE_NEW_SYN_RECV = 12;
+
+// Time-wait and request sockets belong to no process (inode 0); on busy hosts they
+// are most of the table, so the kernel is asked not to dump them at all
+constexpr uint32_t OWNED_STATES = ~((1u << TCP_STATE_SYN_RECV) | (1u << TCP_STATE_TIME_WAIT) |
+                                   (1u << TCP_STATE_NEW_SYN_RECV));
+
+const char* tcpStateName(uint8_t state) {
+    static const char* const names[] = {
+        "UNKNOWN", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2",
+        "TIME_WAIT", "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING", "NEW_SYN_RECV"
+    };
+    return state < sizeof(names) / sizeof(names[0]) ? names[state] : "UNKNOWN";
+}
+
+std::string formatAddress(uint8_t family, const uint32_t* address) {
+    char text[INET6_ADDRSTRLEN] = "";
+    inet_ntop(family, address, text, sizeof(text));
+    return text;
+}
+
+} // namespace
+
+SocketInventory::SocketInventory(const ProcessTree& trees, size_t count)
+    : trees_(trees), count_(count), buffer_(BUFFER_SIZE) {
+}
+
+std::vector<ServiceSockets> SocketInventory::services() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (stats_.Scans == 0 || now - scannedAt_ >= MIN_INTERVAL) {
+        scannedAt_ = now;
+        if (!scan()) {
+            services_.clear();
+        }
+    }
+    return services_;
+}
+
+SocketScanStats SocketInventory::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool SocketInventory::scan() {
+    auto start = std::chrono::steady_clock::now();
+    stats_.Scans++;
+    stats_.Dumped = 0;
+    stats_.Matched = 0;
+    stats_.Error.clear();
+
+    std::unordered_map<uint64_t, size_t> owners;
+    collectInodes(owners);
+
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0) {
+        stats_.Error = std::string("netlink socket: ") + strerror(errno);
+        return false;
+    }
+    std::vector<ServiceSockets> services(count_);
+    bool ok = dump(fd, AF_INET, IPPROTO_TCP, owners, services) &&
+              dump(fd, AF_INET6, IPPROTO_TCP, owners, services) &&
+              dump(fd, AF_INET, IPPROTO_UDP, owners, services) &&
+              dump(fd, AF_INET6, IPPROTO_UDP, owners, services);
+    close(fd);
+
+    stats_.DurationMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    if (ok) {
+        services_ = std::move(services);
+    }
+    return ok;
+}
+
+void SocketInventory::collectInodes(std::unordered_map<uint64_t, size_t>& owners) {
+    for (size_t i = 0; i < count_; ++i) {
+        for (const TreeProcess& process : trees_.tree(i)) {
+            char path[32];
+            snprintf(path, sizeof(path), "/proc/%d/fd", process.Pid);
+            int dir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dir < 0) {
+                continue;
+            }
+            for (;;) {
+                long bytes = syscall(SYS_getdents64, dir, buffer_.data(), buffer_.size());
+                if (bytes <= 0) {
+                    break;
+                }
+                for (long offset = 0; offset < bytes;) {
+                    // d_ino, d_off, d_reclen, d_type, d_name (see getdents64(2))
+                    const char* record = buffer_.data() + offset;
+                    unsigned short reclen;
+                    memcpy(&reclen, record + 16, sizeof(reclen));
+                    offset += reclen;
+                    const char* name = record + 19;
+                    if (name[0] == '.') {
+                        continue;
+                    }
+                    char link[64];
+                    ssize_t length = readlinkat(dir, name, link, sizeof(link) - 1);
+                    if (length <= 8 || strncmp(link, "socket:[", 8) != 0) {
+                        continue;
+                    }
+                    link[length] = '\0';
+                    // Forked workers share their parent's sockets; the first holder wins
+                    owners.emplace(strtoull(link + 8, nullptr, 10), i);
+                }
+            }
+            close(dir);
+        }
+    }
+}
+
+bool SocketInventory::dump(int fd, uint8_t family, uint8_t protocol,
+                           const std::unordered_map<uint64_t, size_t>& owners,
+                           std::vector<ServiceSockets>& services) {
+    struct {
+        nlmsghdr         Header;
+        inet_diag_req_v2 Request;
+    } message = {};
+    message.Header.nlmsg_len = sizeof(message);
+    message.Header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.Header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.Header.nlmsg_seq = static_cast<uint32_t>(stats_.Scans);
+    message.Request.sdiag_family = family;
+    message.Request.sdiag_protocol = protocol;
+    message.Request.idiag_states = OWNED_STATES;  // No extensions, so replies stay minimal
+
+    sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(fd, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+        stats_.Error = std::string("sock_diag request: ") + strerror(errno);
+        return false;
+    }
+
+    const char* proto = protocol == IPPROTO_TCP ? (family == AF_INET ? "tcp" : "tcp6")
+                                                : (family == AF_INET ? "udp" : "udp6");
+    for (;;) {
+        ssize_t length = recv(fd, buffer_.data(), buffer_.size(), 0);
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            stats_.Error = std::string("sock_diag dump: ") + strerror(errno);
+            return false;
+        }
+        int remaining = static_cast<int>(length);
+        for (auto* header = reinterpret_cast<nlmsghdr*>(buffer_.data()); NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE) {
+                return true;
+            }
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                auto* error = static_cast<nlmsgerr*>(NLMSG_DATA(header));
+                // A protocol the kernel was built without simply has no sockets
+                if (error->error == -ENOENT) {
+                    return true;
+                }
+                stats_.Error = std::string("sock_diag dump: ") + strerror(-error->error);
+                return false;
+            }
+            stats_.Dumped++;
+            const auto* socket = static_cast<const inet_diag_msg*>(NLMSG_DATA(header));
+            auto owner = owners.find(socket->idiag_inode);
+            if (owner == owners.end()) {
+                continue;
+            }
+            stats_.Matched++;
+            ServiceSockets& service = services[owner->second];
+            service.Sockets++;
+
+            // Unconnected UDP sockets are reported as CLOSE: they are the bound "listeners"
+            bool listening = protocol == IPPROTO_TCP ? socket->idiag_state == TCP_STATE_LISTEN
+                                                     : socket->idiag_state == TCP_STATE_CLOSE;
+            if (listening) {
+                ListeningSocket listener;
+                listener.Protocol = proto;
+                listener.Address = formatAddress(family, socket->id.idiag_src);
+                listener.Port = ntohs(socket->id.idiag_sport);
+                listener.RecvQ = socket->idiag_rqueue;
+                listener.SendQ = socket->idiag_wqueue;
+                service.Listening.push_back(std::move(listener));
+            } else {
+                service.States[protocol == IPPROTO_TCP ? tcpStateName(socket->idiag_state)
+                               : socket->idiag_state == TCP_STATE_ESTABLISHED ? "UDP_CONNECTED"
+                               : "UDP_OTHER"]++;
+                service.RecvQ += socket->idiag_rqueue;
+                service.SendQ += socket->idiag_wqueue;
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file SocketInventory.hpp
+ * @brief Per-service listening ports and connection counts via netlink sock_diag
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ProcessTree;
+
+/**
+ * @brief A listening TCP socket or bound UDP socket of a service
+ */
+struct ListeningSocket {
+    std::string Protocol;   ///< "tcp", "tcp6", "udp" or "udp6"
+    std::string Address;    ///< Local address ("0.0.0.0", "::", ...)
+    uint16_t    Port = 0;
+    uint32_t    RecvQ = 0;  ///< TCP: connections waiting in accept(); UDP: unread bytes
+    uint32_t    SendQ = 0;  ///< TCP: accept backlog; UDP: unsent bytes
+};
+
+/**
+ * @brief Internet sockets held by the process tree of one service
+ */
+struct ServiceSockets {
+    std::vector<ListeningSocket> Listening;
+    std::map<std::string, int>   States;      ///< Connection count per TCP state ("ESTABLISHED", ...)
+    int                          Sockets = 0; ///< TCP and UDP sockets held, listening ones included
+    uint64_t                     RecvQ = 0;   ///< Unread bytes over all connections
+    uint64_t                     SendQ = 0;   ///< Unacknowledged or unsent bytes over all connections
+};
+
+/**
+ * @brief Statistics of the last inventory
+ */
+struct SocketScanStats {
+    uint64_t    Scans = 0;
+    size_t      Dumped = 0;        ///< Sockets returned by the kernel in the last scan
+    size_t      Matched = 0;       ///< Of those, sockets held by a service
+    double      DurationMs = 0.0;  ///< Wall time of the last scan
+    std::string Error;             ///< Why the last scan failed ("" on success)
+};
+
+/**
+ * @brief On-demand socket inventory of all services
+ *
+ * A scan first collects the socket inodes open in each service's process
+ * tree (as kept by ProcessTree, so no extra /proc listing), then asks the
+ * kernel for every TCP and UDP socket with NETLINK_SOCK_DIAG dumps and keeps
+ * only those inodes. The dumps are binary, already split per socket and
+ * carry the queue sizes, so nothing is formatted by the kernel or parsed
+ * here, unlike /proc/net/tcp; time-wait and request sockets, which no
+ * process owns, are filtered out by the kernel before they are copied.
+ *
+ * Scans run on request; a result younger than MIN_INTERVAL is reused so
+ * polling clients cannot turn the inventory into a busy loop.
+ */
+class SocketInventory {
+public:
+    static constexpr std::chrono::milliseconds MIN_INTERVAL{1000};
+
+    /**
+     * @brief Constructor
+     * @param trees Process trees of the services
+     * @param count Number of managed commands
+     */
+    SocketInventory(const ProcessTree& trees, size_t count);
+
+    SocketInventory(const SocketInventory&) = delete;
+    SocketInventory& operator=(const SocketInventory&) = delete;
+
+    /**
+     * @brief Get the sockets of every service, scanning first if the last result is stale
+     * @return Sockets indexed like the commands (empty on failure, see stats().Error)
+     */
+    std::vector<ServiceSockets> services();
+
+    /**
+     * @brief Get statistics of the last scan
+     */
+    SocketScanStats stats() const;
+
+private:
+    const ProcessTree&          trees_;
+    size_t                      count_;
+    mutable std::mutex          mutex_;  ///< Guards everything below
+    std::vector<ServiceSockets> services_;
+    SocketScanStats             stats_;
+    std::chrono::steady_clock::time_point scannedAt_;
+    std::vector<char>           buffer_; ///< Reused for fd listings and netlink replies
+
+    bool scan();
+    void collectInodes(std::unordered_map<uint64_t, size_t>& owners);
+    bool dump(int fd, uint8_t family, uint8_t protocol,
+              const std::unordered_map<uint64_t, size_t>& owners, std::vector<ServiceSockets>& services);
+};
@@ -0,0 +1,241 @@
+/**
+ * @file StartupBoost.cpp
+ * @brief Implementation of the startup CPU/IO boost
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "StartupBoost.hpp"
+#include "CgroupManager.hpp"
+#include "EventLog.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // syscall
+#include <sys/resource.h>   // setpriority, getpriority
+#include <sys/syscall.h>    // SYS_ioprio_get, SYS_ioprio_set
+#include <algorithm>        // std::clamp
+#include <cerrno>           // errno
+#include <cstdio>           // snprintf
+#include <filesystem>       // std::filesystem::directory_iterator
+#include <sstream>          // std::istringstream
+
+namespace {
+
+// From <linux/ioprio.h>, which older kernel headers do not ship
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+constexpr int IOPRIO_CLASS_BE = 2;
+
+int readNice(pid_t pid) {
+    errno = 0;
+    int value = getpriority(PRIO_PROCESS, static_cast<id_t>(pid));
+    return errno == 0 ? value : 0;
+}
+
+/**
+ * @brief Extract the default weight of a cgroup weight file
+ * @param text "100" (cpu.weight) or "default 100" followed by per-device lines (io.weight)
+ */
+std::string defaultWeight(const std::string& text) {
+    std::istringstream lines(text);
+    std::string first;
+    std::getline(lines, first);
+    if (first.rfind("default ", 0) == 0) {
+        return first.substr(8);
+    }
+    return first;
+}
+
+} // namespace
+
+StartupBoost::StartupBoost(ProcessRunner& runner, Orchestrator& orchestrator,
+                           const CgroupManager& cgroups, EventLoop& loop, EventLog& events)
+    : runner_(runner), orchestrator_(orchestrator), cgroups_(cgroups), loop_(loop), events_(events) {
+    services_.resize(runner_.getCommandCount());
+    for (size_t i = 0; i < services_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        if (cmd.option("boost") != "1") {
+            continue;
+        }
+        if (cmd.Mode != 'C') {
+            events_.record(static_cast<int>(i), "boost.config", std::string("@boost is ignored for ") +
+                           (cmd.Mode == 'S' ? "sandboxed" : "Docker") + " services");
+            continue;
+        }
+        BoostPolicy& policy = services_[i].Policy;
+        policy.Enabled = true;
+        policy.CpuWeight = std::clamp(static_cast<int>(cmd.optionNumber("boost.cpu_weight", policy.CpuWeight)), 1, 10000);
+        policy.IoWeight = std::clamp(static_cast<int>(cmd.optionNumber("boost.io_weight", policy.IoWeight)), 1, 10000);
+        policy.Nice = std::clamp(static_cast<int>(cmd.optionNumber("boost.nice", policy.Nice)), -20, 19);
+        policy.IoNice = std::clamp(static_cast<int>(cmd.optionNumber("boost.ionice", policy.IoNice)), 0, 7);
+        policy.Timeout = std::chrono::milliseconds(static_cast<int64_t>(
+            cmd.optionNumber("boost.timeout", policy.Timeout.count() / 1000.0) * 1000));
+    }
+}
+
+bool StartupBoost::enabled(size_t index) const {
+    return index < services_.size() && services_[index].Policy.Enabled;
+}
+
+void StartupBoost::spawned(size_t index, pid_t pid) {
+    if (!enabled(index)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Service& service = services_[index];
+    const BoostPolicy& policy = service.Policy;
+
+    // A restart while still boosted keeps the steady-state values saved by the first boost
+    bool boosted = service.Stats.Active;
+    std::string mechanism;
+    if (cgroups_.available()) {
+        std::string current;
+        if ((boosted && !service.CpuWeight.empty()) ||
+            (cgroups_.readControl(index, "cpu.weight", current) &&
+             cgroups_.writeControl(index, "cpu.weight", std::to_string(policy.CpuWeight)))) {
+            if (!boosted) {
+                service.CpuWeight = defaultWeight(current);
+            }
+            mechanism = "cpu.weight";
+        }
+        current.clear();
+        if ((boosted && !service.IoWeight.empty()) ||
+            (cgroups_.readControl(index, "io.weight", current) &&
+             cgroups_.writeControl(index, "io.weight", "default " + std::to_string(policy.IoWeight)))) {
+            if (!boosted) {
+                service.IoWeight = defaultWeight(current);
+            }
+            mechanism += mechanism.empty() ? "io.weight" : ",io.weight";
+        }
+    }
+
+    // Per-thread fallbacks for whatever the cgroup could not boost
+    if (service.CpuWeight.empty()) {
+        int original = readNice(pid);
+        if (setTaskPriorities(pid, &policy.Nice, nullptr)) {
+            if (!service.Niced) {
+                service.OriginalNice = original;
+            }
+            service.Niced = true;
+            mechanism += mechanism.empty() ? "nice" : ",nice";
+        }
+    }
+    if (service.IoWeight.empty()) {
+        int original = static_cast<int>(syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, pid));
+        int ioprio = (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | policy.IoNice;
+        if (original >= 0 && setTaskPriorities(pid, nullptr, &ioprio)) {
+            if (!service.IoNiced) {
+                service.OriginalIoprio = original;
+            }
+            service.IoNiced = true;
+            mechanism += mechanism.empty() ? "ionice" : ",ionice";
+        }
+    }
+
+    if (mechanism.empty()) {
+        events_.record(static_cast<int>(index), "boost.failed",
+                       "Could not raise the priority of PID " + std::to_string(pid) +
+                       " (lowering nice needs CAP_SYS_NICE)");
+        return;
+    }
+
+    uint64_t generation = ++service.Generation;
+    service.Pid = pid;
+    service.Since = std::chrono::steady_clock::now();
+    service.Stats.Active = true;
+    service.Stats.Mechanism = mechanism;
+    service.Stats.Boosts++;
+    events_.record(static_cast<int>(index), "boost.start",
+                   "Boosted PID " + std::to_string(pid) + " until ready (" + mechanism + ")");
+
+    std::chrono::milliseconds timeout = policy.Timeout;
+    loop_.post([this, index, pid, generation, timeout]() {
+        int timer = loop_.runAfter(timeout, [this, index, generation]() {
+            restore(index, generation, "boost.timeout expired", true);
+        });
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (services_[index].Generation == generation && services_[index].Stats.Active) {
+                services_[index].TimerId = timer;
+            }
+        }
+        spawn(watch(index, pid, generation));
+    });
+}
+
+Task<void> StartupBoost::watch(size_t index, pid_t pid, uint64_t generation) {
+    bool ready = co_await orchestrator_.instanceReady(index, pid);
+    restore(index, generation, ready ? "ready" : "not ready", false);
+}
+
+void StartupBoost::restore(size_t index, uint64_t generation, const std::string& reason, bool timedOut) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Service& service = services_[index];
+    if (service.Generation != generation || !service.Stats.Active) {
+        return;  // Superseded by a newer instance, or already restored
+    }
+    if (service.TimerId != 0) {
+        if (!timedOut) {
+            loop_.cancelTimer(service.TimerId);
+        }
+        service.TimerId = 0;
+    }
+
+    if (!service.CpuWeight.empty()) {
+        cgroups_.writeControl(index, "cpu.weight", service.CpuWeight);
+    }
+    if (!service.IoWeight.empty()) {
+        cgroups_.writeControl(index, "io.weight", "default " + service.IoWeight);
+    }
+    if (service.Niced) {
+        setTaskPriorities(service.Pid, &service.OriginalNice, nullptr);
+    }
+    if (service.IoNiced) {
+        setTaskPriorities(service.Pid, nullptr, &service.OriginalIoprio);
+    }
+
+    std::chrono::duration<double, std::milli> boosted = std::chrono::steady_clock::now() - service.Since;
+    char duration[32];
+    snprintf(duration, sizeof(duration), "%.2fs", boosted.count() / 1000.0);
+    events_.record(static_cast<int>(index), "boost.end",
+                   "Restored steady-state priority of PID " + std::to_string(service.Pid) +
+                   " after " + duration + " (" + reason + ")");
+
+    service.CpuWeight.clear();
+    service.IoWeight.clear();
+    service.Niced = false;
+    service.IoNiced = false;
+    service.Stats.Active = false;
+    service.Stats.Mechanism.clear();
+    service.Stats.LastMs = boosted.count();
+    if (timedOut) {
+        service.Stats.TimedOut++;
+    }
+}
+
+BoostStats StartupBoost::stats(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index < services_.size() ? services_[index].Stats : BoostStats();
+}
+
+bool StartupBoost::setTaskPriorities(pid_t pid, const int* nice, const int* ioprio) {
+    // Nice values and I/O priorities are per thread, so every task has to be updated
+    std::error_code ec;
+    bool any = false;
+    std::filesystem::directory_iterator tasks("/proc/" + std::to_string(pid) + "/task", ec);
+    for (; !ec && tasks != std::filesystem::directory_iterator(); tasks.increment(ec)) {
+        try {
+            int tid = std::stoi(tasks->path().filename().string());
+            if (nice && setpriority(PRIO_PROCESS, static_cast<id_t>(tid), *nice) == 0) {
+                any = true;
+            }
+            if (ioprio && syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, tid, *ioprio) == 0) {
+                any = true;
+            }
+        } catch (const std::exception&) {
+            continue;
+        }
+    }
+    return any;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file StartupBoost.hpp
+ * @brief Temporary CPU/IO priority boost while services initialise
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+class CgroupManager;
+class EventLog;
+
+/**
+ * @brief Per-service startup boost settings
+ *
+ * Read from the service's options:
+ * - boost           "1" to boost the service while it starts
+ * - boost.cpu_weight cpu.weight of the service cgroup while boosted (1-10000)
+ * - boost.io_weight io.weight of the service cgroup while boosted (1-10000)
+ * - boost.nice      nice value while boosted, used without a cgroup
+ * - boost.ionice    best-effort I/O priority level while boosted (0-7), used without io.weight
+ * - boost.timeout   seconds after which the boost ends even if the service is not ready
+ */
+struct BoostPolicy {
+    bool                      Enabled = false;
+    int                       CpuWeight = 1000;
+    int                       IoWeight = 1000;
+    int                       Nice = -5;
+    int                       IoNice = 0;
+    std::chrono::milliseconds Timeout{60000};
+};
+
+/**
+ * @brief Boost state of one service exposed to the API
+ */
+struct BoostStats {
+    bool        Active = false;  ///< The current instance is boosted
+    std::string Mechanism;       ///< e.g. "cpu.weight,io.weight" or "nice,ionice" while active
+    uint64_t    Boosts = 0;      ///< Starts boosted so far
+    uint64_t    TimedOut = 0;    ///< Boosts ended by boost.timeout instead of readiness
+    double      LastMs = 0;      ///< Duration of the latest finished boost
+};
+
+/**
+ * @brief Raises a service's CPU and I/O priority from spawn until it is ready
+ *
+ * Services compete hardest for CPU and disk while they initialise. A native
+ * service with "@boost=1" gets a higher cpu.weight and io.weight on its
+ * cgroup as soon as it is forked, or, without cgroups, a lower nice value
+ * and a higher best-effort I/O priority on its threads. The steady-state
+ * values are read before boosting and restored once the orchestrator's
+ * readiness check passes, the instance exits, or "@boost.timeout" expires,
+ * whichever comes first. Standbys of the warm pool, restored checkpoints
+ * and Docker services are not boosted.
+ */
+class StartupBoost {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Provides the readiness check ending a boost
+     * @param cgroups Cgroup manager used for cpu.weight and io.weight
+     * @param loop Loop the readiness waits run on
+     * @param events Event log receiving boost events
+     */
+    StartupBoost(ProcessRunner& runner, Orchestrator& orchestrator, const CgroupManager& cgroups,
+                 EventLoop& loop, EventLog& events);
+
+    StartupBoost(const StartupBoost&) = delete;
+    StartupBoost& operator=(const StartupBoost&) = delete;
+
+    /**
+     * @brief Check whether a service is boosted while it starts
+     * @param index Command index
+     */
+    bool enabled(size_t index) const;
+
+    /**
+     * @brief Boost a freshly forked instance (callable from any thread)
+     * @param index Command index
+     * @param pid Forked instance
+     *
+     * Called by ProcessRunner with its lock held; does not call back into it.
+     */
+    void spawned(size_t index, pid_t pid);
+
+    /**
+     * @brief Get the boost state of a service
+     * @param index Command index
+     */
+    BoostStats stats(size_t index) const;
+
+private:
+    struct Service {
+        BoostPolicy Policy;
+        pid_t       Pid = -1;
+        uint64_t    Generation = 0;   ///< Incremented by every boost
+        int         TimerId = 0;      ///< boost.timeout timer (loop thread only)
+        std::chrono::steady_clock::time_point Since;
+        std::string CpuWeight;        ///< Steady-state cpu.weight ("" = not changed)
+        std::string IoWeight;         ///< Steady-state io.weight ("" = not changed)
+        bool        Niced = false;
+        int         OriginalNice = 0;
+        bool        IoNiced = false;
+        int         OriginalIoprio = 0;
+        BoostStats  Stats;
+    };
+
+    ProcessRunner&       runner_;
+    Orchestrator&        orchestrator_;
+    const CgroupManager& cgroups_;
+    EventLoop&           loop_;
+    EventLog&            events_;
+    mutable std::mutex   mutex_;  ///< Guards services_
+    std::vector<Service> services_;
+
+    Task<void> watch(size_t index, pid_t pid, uint64_t generation);
+    void restore(size_t index, uint64_t generation, const std::string& reason, bool timedOut);
+    static bool setTaskPriorities(pid_t pid, const int* nice, const int* ioprio);
+};
@@ -0,0 +1,177 @@
+/**
+ * @file StatusPage.cpp
+ * @brief Implementation of the shared-memory status page writer
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "StatusPage.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // ftruncate, close, unlink, getpid
+#include <fcntl.h>          // open, O_CREAT
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/syscall.h>    // SYS_futex
+#include <linux/futex.h>    // FUTEX_WAKE
+#include <climits>          // INT_MAX
+#include <cstdio>           // perror, rename
+#include <cstring>          // memcmp, memcpy, strncpy
+#include <chrono>           // std::chrono
+#include <new>              // placement new
+
+namespace {
+
+constexpr std::chrono::milliseconds STATUS_REFRESH{100};
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Bump a futex word and wake every process waiting on it
+ */
+void bumpAndWake(std::atomic<uint32_t>& word) {
+    word.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+StatusPage::StatusPage(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop,
+                       const std::string& path)
+    : runner_(runner), orchestrator_(orchestrator), loop_(loop), path_(path) {
+}
+
+StatusPage::~StatusPage() {
+    if (map_) {
+        munmap(map_, size_);
+        unlink(path_.c_str());
+    }
+}
+
+bool StatusPage::open() {
+    size_t count = runner_.getCommandCount();
+    size_ = sizeof(StatusPageHeader) + count * (sizeof(StatusSlot) + sizeof(std::atomic<uint32_t>));
+
+    std::string temporary = path_ + ".tmp";
+    int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        perror("StatusPage: open failed");
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        perror("StatusPage: ftruncate failed");
+        close(fd);
+        unlink(temporary.c_str());
+        return false;
+    }
+    map_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map_ == MAP_FAILED) {
+        perror("StatusPage: mmap failed");
+        map_ = nullptr;
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    // The file is zero-filled; construct the header in place
+    header_ = new (map_) StatusPageHeader{};
+    header_->Magic = STATUS_PAGE_MAGIC;
+    header_->Version = STATUS_PAGE_VERSION;
+    header_->SlotCount = static_cast<uint32_t>(count);
+    header_->SlotSize = sizeof(StatusSlot);
+    header_->ServerPid = getpid();
+    slots_ = reinterpret_cast<StatusSlot*>(static_cast<char*>(map_) + sizeof(StatusPageHeader));
+    futexes_ = reinterpret_cast<std::atomic<uint32_t>*>(slots_ + count);  // Zero-filled by ftruncate
+    current_.assign(count, StatusSlot{});
+    readyPids_.assign(count, -1);
+    for (size_t i = 0; i < count; ++i) {
+        command cmd = runner_.getCommand(i);
+        strncpy(current_[i].Desc, cmd.Desc.c_str(), sizeof(current_[i].Desc) - 1);
+        current_[i].Mode = static_cast<uint8_t>(cmd.Mode);
+        current_[i].Pid = -1;
+        slots_[i] = current_[i];
+    }
+    header_->HeartbeatMs.store(nowMs(), std::memory_order_release);
+
+    if (rename(temporary.c_str(), path_.c_str()) != 0) {
+        perror("StatusPage: rename failed");
+        munmap(map_, size_);
+        map_ = nullptr;
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StatusPage::start() {
+    if (!map_) {
+        return;
+    }
+    loop_.post([this]() {
+        loop_.addTimer(STATUS_REFRESH, [this]() { refresh(); });
+        refresh();
+    });
+}
+
+void StatusPage::notify() {
+    if (map_) {
+        loop_.post([this]() { refresh(); });
+    }
+}
+
+void StatusPage::refresh() {
+    int64_t now = nowMs();
+    std::vector<StatusSlot> next = current_;
+    for (size_t i = 0; i < next.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        StatusSlot& slot = next[i];
+        bool running = cmd.Status == RUNNING && cmd.Pid > 0;
+        if (running && cmd.Pid != slot.Pid) {
+            spawn(watchReady(i, cmd.Pid));
+            if (slot.StartedMs != 0) {
+                ++slot.Restarts;
+            }
+            if (slot.State != STATUS_DEAD) {
+                slot.ExitedMs = now;  // Replaced between two refreshes
+            }
+            slot.StartedMs = now;
+        } else if (!running && slot.State != STATUS_DEAD) {
+            slot.ExitedMs = now;
+        }
+        slot.State = !running ? STATUS_DEAD : readyPids_[i] == cmd.Pid ? STATUS_READY : STATUS_RUNNING;
+        slot.Pid = running ? cmd.Pid : -1;
+        slot.Adopted = running && cmd.Adopted ? 1 : 0;
+    }
+
+    if (memcmp(next.data(), current_.data(), next.size() * sizeof(StatusSlot)) != 0) {
+        // Seqlock write: odd while the slots are inconsistent
+        uint64_t sequence = header_->Sequence.load(std::memory_order_relaxed);
+        header_->Sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(static_cast<void*>(slots_), next.data(), next.size() * sizeof(StatusSlot));
+        header_->Sequence.store(sequence + 2, std::memory_order_release);
+
+        // Wake waiters only after the new slots are visible
+        for (size_t i = 0; i < next.size(); ++i) {
+            if (memcmp(&next[i], &current_[i], sizeof(StatusSlot)) != 0) {
+                bumpAndWake(futexes_[i]);
+            }
+        }
+        bumpAndWake(header_->Changes);
+        current_.swap(next);
+    }
+    header_->HeartbeatMs.store(now, std::memory_order_release);
+}
+
+Task<void> StatusPage::watchReady(size_t index, pid_t pid) {
+    // Shares the probe of the orchestrated start (or warm pool) of the instance
+    bool ready = co_await orchestrator_.instanceReady(index, pid);
+    if (ready) {
+        // A probe that already finished resumes us inside refresh(); publish on the next turn
+        readyPids_[index] = pid;
+        notify();
+    }
+}
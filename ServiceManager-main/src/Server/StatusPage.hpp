@@ -0,0 +1,89 @@
+/**
+ * @file StatusPage.hpp
+ * @brief Publishes service states in a read-only shared-memory page
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+#include "StatusPageFormat.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+
+/**
+ * @brief Writer of the status page (see StatusPageFormat.hpp)
+ *
+ * The page is a file (normally in /dev/shm) mapped by ServiceMN and by any
+ * number of local readers. Every refresh on the event loop compares the
+ * services' states with the previous refresh and rewrites the slots under
+ * the seqlock only when something changed, so readers polling the page
+ * cost neither syscalls nor API load. Each change also bumps the slot's
+ * futex word and wakes readers blocked in FUTEX_WAIT on it. The file is
+ * created under a temporary name and renamed into place, so readers never
+ * map a page with an incomplete header, and it is removed when ServiceMN
+ * shuts down.
+ *
+ * Refreshes run periodically and on notify(), which the process runner
+ * calls on every state change. A new instance is published as RUNNING and
+ * becomes READY once the service's readiness check passes.
+ */
+class StatusPage {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Provides the services' readiness checks
+     * @param loop Loop the refreshes run on
+     * @param path File to publish
+     */
+    StatusPage(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop,
+               const std::string& path);
+
+    /**
+     * @brief Destructor - unmaps and removes the page
+     */
+    ~StatusPage();
+
+    StatusPage(const StatusPage&) = delete;
+    StatusPage& operator=(const StatusPage&) = delete;
+
+    /**
+     * @brief Create and map the page
+     * @return false if the file could not be created
+     */
+    bool open();
+
+    /**
+     * @brief Start refreshing the page (callable from any thread)
+     */
+    void start();
+
+    /**
+     * @brief Publish state changes now instead of at the next refresh (callable from any thread)
+     */
+    void notify();
+
+private:
+    ProcessRunner&          runner_;
+    Orchestrator&           orchestrator_;
+    EventLoop&              loop_;
+    std::string             path_;
+    void*                   map_ = nullptr;
+    size_t                  size_ = 0;
+    StatusPageHeader*       header_ = nullptr;
+    StatusSlot*             slots_ = nullptr;
+    std::atomic<uint32_t>*  futexes_ = nullptr;  ///< One futex word per slot
+    std::vector<StatusSlot> current_;  ///< Last published slots (loop thread only)
+    std::vector<pid_t>      readyPids_;  ///< Instances that passed the readiness check (loop thread only)
+
+    void refresh();
+    Task<void> watchReady(size_t index, pid_t pid);
+};
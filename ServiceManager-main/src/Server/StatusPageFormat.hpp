@@ -0,0 +1,84 @@
+/**
+ * @file StatusPageFormat.hpp
+ * @brief Memory layout of the shared-memory status page
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Magic value starting the page ("SMST" little-endian)
+ */
+constexpr uint32_t STATUS_PAGE_MAGIC = 0x54534d53;
+
+/**
+ * @brief Layout version; readers reject pages with a different version
+ */
+constexpr uint32_t STATUS_PAGE_VERSION = 2;
+
+/**
+ * @brief State of a service slot
+ */
+enum StatusSlotState : uint32_t {
+    STATUS_DEAD = 0,     ///< Not running
+    STATUS_RUNNING = 1,  ///< Running (started, handed out, restored or adopted), not yet ready
+    STATUS_READY = 2     ///< Running and the service's readiness check passed
+};
+
+/**
+ * @brief Header at offset 0 of the page
+ *
+ * The page is the header, SlotCount StatusSlots, then SlotCount futex
+ * words (std::atomic<uint32_t>, one per slot). The slots are protected by
+ * a seqlock: ServiceMN makes Sequence odd, rewrites the slots, then makes
+ * it even again. A reader loads Sequence (acquire), retries while it is
+ * odd, copies the slots, issues an acquire fence and loads Sequence again;
+ * the copy is consistent if both loads returned the same value. Readers
+ * never write to the page, so any number of them cost ServiceMN nothing.
+ *
+ * HeartbeatMs is updated on every refresh even when nothing changed, so a
+ * reader can tell a live page from one left behind by a crashed server.
+ *
+ * After publishing a change of a slot, ServiceMN increments the slot's
+ * futex word and Changes, and wakes their (shared, not private) futex
+ * waiters. A reader waiting for a state loads the word, checks the slot
+ * and, if the state is not reached yet, calls FUTEX_WAIT with the loaded
+ * value; a change between the check and the wait makes FUTEX_WAIT return
+ * at once, so no transition is missed.
+ */
+struct StatusPageHeader {
+    uint32_t              Magic;        ///< STATUS_PAGE_MAGIC
+    uint32_t              Version;      ///< STATUS_PAGE_VERSION
+    uint32_t              SlotCount;    ///< Slots following the header
+    uint32_t              SlotSize;     ///< sizeof(StatusSlot)
+    std::atomic<uint64_t> Sequence;     ///< Seqlock counter, odd while slots are written
+    std::atomic<int64_t>  HeartbeatMs;  ///< Wall-clock time of the latest refresh
+    int32_t               ServerPid;    ///< PID of the publishing ServiceMN
+    std::atomic<uint32_t> Changes;      ///< Futex word bumped on every published change
+    uint32_t              Reserved[6];  ///< Zero
+};
+
+static_assert(sizeof(StatusPageHeader) == 64, "StatusPageHeader must stay 64 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock counter must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == 4, "Futex words must be 32 bits");
+
+/**
+ * @brief One service, at index SlotIndex in the config
+ */
+struct StatusSlot {
+    char     Desc[48];    ///< Service description, NUL-terminated (truncated)
+    uint32_t State;       ///< StatusSlotState
+    int32_t  Pid;         ///< Main process ID (-1 if not running)
+    uint32_t Restarts;    ///< Instances started after the first one
+    uint8_t  Mode;        ///< 'C' (native), 'S' (sandboxed) or 'D' (Docker)
+    uint8_t  Adopted;     ///< 1 if the instance was started outside ServiceMN
+    uint8_t  Reserved[2]; ///< Zero
+    int64_t  StartedMs;   ///< Wall-clock time the current (or last) instance was seen starting
+    int64_t  ExitedMs;    ///< Wall-clock time the last instance was seen exiting (0 = never)
+};
+
+static_assert(sizeof(StatusSlot) == 80, "StatusSlot must stay 80 bytes");
@@ -0,0 +1,234 @@
+/**
+ * @file UringEventLoop.cpp
+ * @brief Implementation of the io_uring event loop backend
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "UringEventLoop.hpp"
+
+#include <poll.h>           // POLLIN, POLLOUT, POLLRDHUP, POLLHUP, POLLERR
+#include <unistd.h>         // close, syscall
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/syscall.h>    // __NR_io_uring_setup, __NR_io_uring_enter
+#include <algorithm>        // std::max
+#include <cerrno>           // errno
+#include <cstdio>           // perror
+#include <cstring>          // memset
+
+namespace {
+
+constexpr unsigned RING_ENTRIES = 1024;
+constexpr uint64_t TIMEOUT_TAG = ~0ULL;      // user_data of the wait timeout
+constexpr uint64_t REMOVE_TAG = ~0ULL - 1;   // user_data of POLL_REMOVE requests
+
+template <typename T>
+T* ringField(void* ring, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+UringEventLoop::~UringEventLoop() {
+    stop();
+    if (sqes_) {
+        munmap(sqes_, sqesSize_);
+    }
+    if (cqRing_ && cqRing_ != sqRing_) {
+        munmap(cqRing_, cqRingSize_);
+    }
+    if (sqRing_) {
+        munmap(sqRing_, sqRingSize_);
+    }
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+    }
+}
+
+bool UringEventLoop::setup() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+    if (ringFd_ < 0) {
+        return false;  // ENOSYS, or disabled through kernel.io_uring_disabled
+    }
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+
+    void* sq = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd_, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+        perror("UringEventLoop: mmap of submission ring failed");
+        return false;
+    }
+    sqRing_ = sq;
+    void* cq = sq;
+    if (!singleMmap) {
+        cq = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd_, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) {
+            perror("UringEventLoop: mmap of completion ring failed");
+            return false;
+        }
+    }
+    cqRing_ = cq;
+
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        perror("UringEventLoop: mmap of submission entries failed");
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sqHead_ = ringField<unsigned>(sqRing_, params.sq_off.head);
+    sqTail_ = ringField<unsigned>(sqRing_, params.sq_off.tail);
+    sqMask_ = *ringField<unsigned>(sqRing_, params.sq_off.ring_mask);
+    sqEntries_ = *ringField<unsigned>(sqRing_, params.sq_off.ring_entries);
+    sqArray_ = ringField<unsigned>(sqRing_, params.sq_off.array);
+    cqHead_ = ringField<unsigned>(cqRing_, params.cq_off.head);
+    cqTail_ = ringField<unsigned>(cqRing_, params.cq_off.tail);
+    cqMask_ = *ringField<unsigned>(cqRing_, params.cq_off.ring_mask);
+    cqes_ = ringField<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+    return true;
+}
+
+int UringEventLoop::enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    ++syscalls_;
+    int submitted = static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete,
+                                             flags, nullptr, 0));
+    if (submitted > 0) {
+        unsubmitted_ -= static_cast<unsigned>(submitted);
+    }
+    return submitted;
+}
+
+io_uring_sqe* UringEventLoop::nextSqe() {
+    unsigned tail = *sqTail_;
+    if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_) {
+        // Queue full: hand the batch to the kernel without waiting
+        if (enter(unsubmitted_, 0, 0) < 0) {
+            perror("UringEventLoop: io_uring_enter failed");
+            return nullptr;
+        }
+    }
+    unsigned index = tail & sqMask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray_[index] = index;
+    return sqe;
+}
+
+void UringEventLoop::armPoll(uint64_t token, int fd, uint32_t interest) {
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) {
+        return;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = (interest & EVENT_READABLE ? POLLIN | POLLRDHUP : 0) |
+                         (interest & EVENT_WRITABLE ? POLLOUT : 0);
+    sqe->user_data = token;
+    __atomic_store_n(sqTail_, *sqTail_ + 1, __ATOMIC_RELEASE);
+    ++unsubmitted_;
+}
+
+bool UringEventLoop::watch(int fd, IoCallback callback, uint32_t interest) {
+    uint64_t token = nextToken_++;
+    watches_[token] = std::make_shared<Watch>(Watch{fd, std::move(callback), interest});
+    tokens_[fd] = token;
+    armPoll(token, fd, interest);
+    return true;
+}
+
+void UringEventLoop::unwatch(int fd) {
+    auto it = tokens_.find(fd);
+    if (it == tokens_.end()) {
+        return;
+    }
+    // The pending poll holds its own file reference, so the caller may close
+    // the descriptor right away; the removal is submitted with the next wait
+    io_uring_sqe* sqe = nextSqe();
+    if (sqe) {
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = it->second;
+        sqe->user_data = REMOVE_TAG;
+        __atomic_store_n(sqTail_, *sqTail_ + 1, __ATOMIC_RELEASE);
+        ++unsubmitted_;
+    }
+    watches_.erase(it->second);
+    tokens_.erase(it);
+}
+
+void UringEventLoop::wait(int timeoutMs) {
+    if (timeoutMs >= 0 && !timeoutArmed_) {
+        io_uring_sqe* sqe = nextSqe();
+        if (sqe) {
+            timeout_.tv_sec = timeoutMs / 1000;
+            timeout_.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<uint64_t>(&timeout_);
+            sqe->len = 1;
+            sqe->off = 1;  // Also completes as soon as anything else completes
+            sqe->user_data = TIMEOUT_TAG;
+            __atomic_store_n(sqTail_, *sqTail_ + 1, __ATOMIC_RELEASE);
+            ++unsubmitted_;
+            timeoutArmed_ = true;
+        }
+    }
+
+    if (enter(unsubmitted_, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EBUSY) {
+        perror("UringEventLoop: io_uring_enter failed");
+        return;
+    }
+
+    // Copy the batch out first: callbacks queue new submissions
+    batch_.clear();
+    unsigned head = *cqHead_;
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cqMask_];
+        batch_.push_back(Completion{cqe.user_data, cqe.res});
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    for (const auto& completion : batch_) {
+        if (completion.Token == TIMEOUT_TAG) {
+            timeoutArmed_ = false;
+            continue;
+        }
+        auto it = watches_.find(completion.Token);
+        if (completion.Token == REMOVE_TAG || it == watches_.end()) {
+            continue;  // Removal results and polls cancelled by unwatch()
+        }
+        std::shared_ptr<Watch> watch = it->second;
+        uint32_t flags = 0;
+        if (completion.Result < 0) {
+            flags = EVENT_HANGUP;
+        } else {
+            if (completion.Result & POLLIN) {
+                flags |= EVENT_READABLE;
+            }
+            if (completion.Result & POLLOUT) {
+                flags |= EVENT_WRITABLE;
+            }
+            if (completion.Result & (POLLHUP | POLLRDHUP | POLLERR)) {
+                flags |= EVENT_HANGUP;
+            }
+        }
+        ++events_;
+        watch->Callback(flags);
+        // A failed poll is reported once; the owner is expected to unwatch
+        if (completion.Result >= 0 && watches_.count(completion.Token)) {
+            armPoll(completion.Token, watch->Fd, watch->Interest);
+        }
+    }
+}
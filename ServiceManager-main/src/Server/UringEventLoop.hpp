@@ -0,0 +1,89 @@
+/**
+ * @file UringEventLoop.hpp
+ * @brief io_uring backend of the event loop
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+
+#include "EventLoop.hpp"
+
+/**
+ * @brief io_uring event loop using raw system calls
+ *
+ * Readiness is requested with one-shot IORING_OP_POLL_ADD entries. After a
+ * callback the poll is re-armed by writing a new submission queue entry,
+ * which costs no system call: re-arms, POLL_REMOVEs and the wait timeout
+ * (an IORING_OP_TIMEOUT that also completes on the first other completion)
+ * are all submitted by the single io_uring_enter() that waits for the next
+ * batch of completions. One-shot polls are used instead of multishot ones
+ * because re-arming re-checks readiness: a callback that leaves data in a
+ * pipe is reported again, like level-triggered epoll.
+ */
+class UringEventLoop : public EventLoop {
+public:
+    UringEventLoop() = default;
+    ~UringEventLoop() override;
+
+    const char* name() const override { return "io_uring"; }
+    bool watch(int fd, IoCallback callback, uint32_t interest = EVENT_READABLE) override;
+    void unwatch(int fd) override;
+
+protected:
+    bool setup() override;
+    void wait(int timeoutMs) override;
+
+private:
+    struct Watch {
+        int        Fd;
+        IoCallback Callback;
+        uint32_t   Interest;
+    };
+
+    struct Completion {
+        uint64_t Token;
+        int32_t  Result;
+    };
+
+    int ringFd_ = -1;
+
+    // Submission queue (shared with the kernel)
+    void*          sqRing_ = nullptr;
+    size_t         sqRingSize_ = 0;
+    unsigned*      sqHead_ = nullptr;
+    unsigned*      sqTail_ = nullptr;
+    unsigned       sqMask_ = 0;
+    unsigned       sqEntries_ = 0;
+    unsigned*      sqArray_ = nullptr;
+    io_uring_sqe*  sqes_ = nullptr;
+    size_t         sqesSize_ = 0;
+    unsigned       unsubmitted_ = 0;
+
+    // Completion queue (shared with the kernel)
+    void*          cqRing_ = nullptr;
+    size_t         cqRingSize_ = 0;
+    unsigned*      cqHead_ = nullptr;
+    unsigned*      cqTail_ = nullptr;
+    unsigned       cqMask_ = 0;
+    io_uring_cqe*  cqes_ = nullptr;
+
+    bool                 timeoutArmed_ = false;
+    __kernel_timespec    timeout_ = {};  ///< Must outlive the TIMEOUT submission
+    uint64_t             nextToken_ = 1;
+    std::unordered_map<uint64_t, std::shared_ptr<Watch>> watches_;  ///< Token -> watch
+    std::unordered_map<int, uint64_t> tokens_;                      ///< Descriptor -> token
+    std::vector<Completion> batch_;  ///< Completions being dispatched
+
+    io_uring_sqe* nextSqe();
+    void armPoll(uint64_t token, int fd, uint32_t interest);
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags);
+};
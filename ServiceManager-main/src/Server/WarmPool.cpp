@@ -0,0 +1,232 @@
+/**
+ * @file WarmPool.cpp
+ * @brief Implementation of the warm pool of standby instances
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#include "WarmPool.hpp"
+#include "AsyncOps.hpp"
+#include "EventLog.hpp"
+#include "Orchestrator.hpp"
+#include "ProcessRunner.hpp"
+
+#include <unistd.h>         // close
+#include <algorithm>        // std::find
+#include <csignal>          // kill, SIGTERM, SIGKILL, SIGUSR1
+#include <cstdlib>          // atoi
+
+namespace {
+
+constexpr std::chrono::milliseconds RETRY_DELAY{5000};
+
+bool erasePid(std::vector<pid_t>& pids, pid_t pid) {
+    auto it = std::find(pids.begin(), pids.end(), pid);
+    if (it == pids.end()) {
+        return false;
+    }
+    pids.erase(it);
+    return true;
+}
+
+} // namespace
+
+WarmPool::WarmPool(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop,
+                   EventLog& events, size_t concurrency)
+    : runner_(runner), orchestrator_(orchestrator), loop_(loop), events_(events),
+      concurrency_(std::max<size_t>(concurrency, 1)) {
+    pools_.resize(runner_.getCommandCount());
+
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        command cmd = runner_.getCommand(i);
+        Pool& pool = pools_[i];
+        double size = cmd.optionNumber("pool.size", 0);
+        if (size <= 0) {
+            continue;
+        }
+        if (cmd.Mode != 'C') {
+            events_.record(static_cast<int>(i), "pool.config",
+                           "Warm pools are only supported for native services");
+            continue;
+        }
+        // A "@listen" socket is ServiceMN's: it accepts connections before the standby has initialised
+        if (!cmd.option("listen").empty()) {
+            bool notify = cmd.option("notify") == "1" || cmd.optionNumber("watchdog", 0) > 0;
+            double readyTcp = cmd.optionNumber("ready.tcp", 0);
+            if (readyTcp != 0 && readyTcp == cmd.optionNumber("listen", 0)) {
+                events_.record(static_cast<int>(i), "pool.config",
+                               "@ready.tcp on the @listen port is answered by ServiceMN's own socket, "
+                               "pool disabled; use @notify or @ready.delay");
+                continue;
+            }
+            if (!notify && readyTcp == 0 && cmd.option("ready.delay").empty()) {
+                events_.record(static_cast<int>(i), "pool.config",
+                               "Pooled @listen services need @notify or @ready.delay, pool disabled");
+                continue;
+            }
+        }
+        pool.Size = static_cast<size_t>(size);
+        pool.Stats.Size = pool.Size;
+
+        std::string activate = cmd.option("pool.activate");
+        if (!activate.empty()) {
+            pool.ActivateSignal = parseSignal(activate);
+            if (pool.ActivateSignal <= 0) {
+                events_.record(static_cast<int>(i), "pool.config",
+                               "Unknown pool.activate signal '" + activate + "', not signalling");
+                pool.ActivateSignal = 0;
+            }
+        }
+    }
+}
+
+int WarmPool::parseSignal(const std::string& name) {
+    std::string bare = name.compare(0, 3, "SIG") == 0 ? name.substr(3) : name;
+    if (bare == "USR1") {
+        return SIGUSR1;
+    } else if (bare == "USR2") {
+        return SIGUSR2;
+    } else if (bare == "HUP") {
+        return SIGHUP;
+    } else if (bare == "CONT") {
+        return SIGCONT;
+    }
+    return bare.find_first_not_of("0123456789") == std::string::npos ? atoi(bare.c_str()) : -1;
+}
+
+void WarmPool::start() {
+    loop_.post([this]() {
+        for (size_t i = 0; i < pools_.size(); ++i) {
+            refill(i);
+        }
+    });
+}
+
+void WarmPool::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& pool : pools_) {
+        for (pid_t pid : pool.Standbys) {
+            kill(pid, SIGTERM);
+        }
+        pool.Standbys.clear();
+        pool.Ready.clear();
+        pool.Size = 0;  // No refills during shutdown
+    }
+}
+
+pid_t WarmPool::take(size_t index) {
+    pid_t pid;
+    int signal;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (index >= pools_.size() || pools_[index].Ready.empty()) {
+            return -1;
+        }
+        Pool& pool = pools_[index];
+        pid = pool.Ready.front();
+        pool.Ready.erase(pool.Ready.begin());
+        erasePid(pool.Standbys, pid);
+        ++pool.Stats.HandedOut;
+        signal = pool.ActivateSignal;
+    }
+    if (signal > 0) {
+        kill(pid, signal);
+    }
+    loop_.post([this, index]() { refill(index); });
+    return pid;
+}
+
+WarmPoolStats WarmPool::stats(size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= pools_.size()) {
+        return WarmPoolStats();
+    }
+    WarmPoolStats stats = pools_[index].Stats;
+    stats.Ready = pools_[index].Ready.size();
+    return stats;
+}
+
+void WarmPool::refill(size_t index) {
+    size_t missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Pool& pool = pools_[index];
+        size_t present = pool.Ready.size() + pool.Stats.Warming;
+        missing = pool.Size > present ? pool.Size - present : 0;
+        pool.Stats.Warming += missing;
+    }
+    for (size_t i = 0; i < missing; ++i) {
+        spawn(warm(index));
+    }
+}
+
+Task<void> WarmPool::warm(size_t index) {
+    while (active_ >= concurrency_) {
+        slotFreed_.reset();
+        co_await slotFreed_.wait();
+    }
+    ++active_;
+
+    auto started = std::chrono::steady_clock::now();
+    pid_t pid = runner_.startStandby(index);
+    int pidfd = pid > 0 ? openPidfd(pid) : -1;
+    if (pidfd >= 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pools_[index].Standbys.push_back(pid);
+    }
+    bool ready = pidfd >= 0 && co_await orchestrator_.instanceReady(index, pid);
+
+    --active_;
+    slotFreed_.set();
+
+    bool keep;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Pool& pool = pools_[index];
+        --pool.Stats.Warming;
+        // stop() may have run while this standby was warming up
+        keep = ready && std::find(pool.Standbys.begin(), pool.Standbys.end(), pid) != pool.Standbys.end();
+        if (keep) {
+            pool.Ready.push_back(pid);
+            pool.Stats.LastWarmMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - started).count();
+        } else if (!ready) {
+            erasePid(pool.Standbys, pid);
+            ++pool.Stats.Failed;
+        }
+    }
+
+    if (!keep) {
+        if (pidfd >= 0) {
+            signalPidfd(pidfd, SIGKILL);
+            close(pidfd);
+        }
+        if (!ready) {
+            events_.record(static_cast<int>(index), "pool.failed",
+                           "Standby instance did not become ready, retrying in " +
+                           std::to_string(RETRY_DELAY.count() / 1000) + " s");
+            co_await sleepFor(loop_, RETRY_DELAY);
+            refill(index);
+        }
+        co_return;
+    }
+
+    // Watch the standby; after take() it is the service's instance and simply runs on
+    co_await childExit(loop_, pidfd, std::chrono::milliseconds(-1));
+    close(pidfd);
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Pool& pool = pools_[index];
+        idle = erasePid(pool.Ready, pid);
+        erasePid(pool.Standbys, pid);
+        if (idle) {
+            ++pool.Stats.Lost;
+        }
+    }
+    if (idle) {
+        events_.record(static_cast<int>(index), "pool.lost",
+                       "Standby instance (PID " + std::to_string(pid) + ") exited while idle");
+        refill(index);
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file WarmPool.hpp
+ * @brief Pre-started standby instances for services with slow startup
+ * @version 1.0
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "Coroutine.hpp"
+
+class ProcessRunner;
+class Orchestrator;
+class EventLog;
+
+/**
+ * @brief Per-service warm pool state exposed to the API
+ */
+struct WarmPoolStats {
+    size_t   Size = 0;        ///< Standby instances kept ready ("@pool.size")
+    size_t   Ready = 0;       ///< Initialised standbys waiting to be handed out
+    size_t   Warming = 0;     ///< Standbys started or queued but not ready yet
+    uint64_t HandedOut = 0;   ///< Standbys that became the service's instance
+    uint64_t Failed = 0;      ///< Standbys that never became ready
+    uint64_t Lost = 0;        ///< Ready standbys that exited while idle
+    double   LastWarmMs = 0;  ///< Start-to-ready time of the latest standby
+};
+
+/**
+ * @brief Keeps initialised-but-idle instances of services ready
+ *
+ * A native service with "@pool.size=K" gets K standby instances started
+ * with SERVICEMN_STANDBY=1. A standby counts as ready once the service's
+ * readiness check passes. ProcessRunner::start() then hands a ready standby
+ * out instead of forking, optionally signalling it ("@pool.activate=USR1"),
+ * and the pool refills in the background. Warm-ups of all pools together
+ * are limited to a fixed number at a time so that refilling does not
+ * starve running services. Everything except take() and stats() runs on
+ * the event loop thread.
+ */
+class WarmPool {
+public:
+    /**
+     * @brief Constructor
+     * @param runner Process runner owning the managed commands
+     * @param orchestrator Provides the services' readiness checks
+     * @param loop Loop the warm-ups run on
+     * @param events Event log receiving pool events
+     * @param concurrency Maximum standbys warming up at once
+     */
+    WarmPool(ProcessRunner& runner, Orchestrator& orchestrator, EventLoop& loop, EventLog& events,
+             size_t concurrency);
+
+    /**
+     * @brief Fill all pools (callable from any thread)
+     */
+    void start();
+
+    /**
+     * @brief Terminate all standby instances that were not handed out
+     */
+    void stop();
+
+    /**
+     * @brief Hand out a ready standby (callable from any thread)
+     * @param index Command index
+     * @return Process ID of the standby, or -1 if none is ready
+     */
+    pid_t take(size_t index);
+
+    /**
+     * @brief Get the pool state of a service
+     * @param index Command index
+     */
+    WarmPoolStats stats(size_t index) const;
+
+private:
+    struct Pool {
+        size_t             Size = 0;
+        int                ActivateSignal = 0;
+        std::vector<pid_t> Ready;     ///< Oldest first
+        std::vector<pid_t> Standbys;  ///< All standbys not handed out
+        WarmPoolStats      Stats;
+    };
+
+    ProcessRunner&    runner_;
+    Orchestrator&     orchestrator_;
+    EventLoop&        loop_;
+    EventLog&         events_;
+    size_t            concurrency_;
+    size_t            active_ = 0;   ///< Warm-ups in progress (loop thread only)
+    AsyncEvent        slotFreed_;    ///< Set when a warm-up finishes (loop thread only)
+    mutable std::mutex mutex_;       ///< Guards pools_
+    std::vector<Pool> pools_;
+
+    void refill(size_t index);
+    Task<void> warm(size_t index);
+    static int parseSignal(const std::string& name);
+};
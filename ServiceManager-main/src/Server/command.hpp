@@ -6,6 +6,8 @@
  */
 
 #pragma once
+#include <map>
+#include <stdexcept>
 #include <string>
 
 /**
@@ -25,10 +27,12 @@ enum STATUS {
 struct command {
     std::string Desc;           ///< Human-readable description of the command
     std::string Path;           ///< Command path or Docker image name
-    char        Mode = 'C';     ///< Execution mode: 'C' for command, 'D' for Docker
+    char        Mode = 'C';     ///< Execution mode: 'C' for command, 'S' for sandboxed command, 'D' for Docker
     std::string Folder = ".";   ///< Working directory for command execution
     short       Status = DEAD;  ///< Current process status (DEAD/RUNNING)
     int         Pid = -1;       ///< Process ID when running (-1 if not running)
+    bool        Adopted = false; ///< Running instance was started outside ServiceMN
+    std::map<std::string, std::string> Options; ///< Per-service "@key=value" options from the config
     
     /**
      * @brief Default constructor
@@ -39,10 +43,47 @@ struct command {
      * @brief Constructor with basic parameters
      * @param desc Process description
      * @param path Command path or Docker image
-     * @param mode Execution mode ('C' or 'D')
+     * @param mode Execution mode ('C', 'S' or 'D')
      * @param folder Working directory
      */
     command(const std::string& desc, const std::string& path, 
             char mode = 'C', const std::string& folder = ".") 
         : Desc(desc), Path(path), Mode(mode), Folder(folder) {}
+    
+    /**
+     * @brief Look up a per-service option
+     * @param key Option name (without the leading '@')
+     * @param fallback Value returned when the option is not set
+     * @return Option value or fallback
+     */
+    std::string option(const std::string& key, const std::string& fallback = "") const {
+        auto it = Options.find(key);
+        return it != Options.end() ? it->second : fallback;
+    }
+    
+    /**
+     * @brief Look up a numeric per-service option
+     * @param key Option name (without the leading '@')
+     * @param fallback Value returned when the option is not set or not a number
+     * @return Parsed option value or fallback
+     */
+    double optionNumber(const std::string& key, double fallback) const {
+        auto it = Options.find(key);
+        if (it == Options.end()) {
+            return fallback;
+        }
+        try {
+            return std::stod(it->second);
+        } catch (const std::exception&) {
+            return fallback;
+        }
+    }
+    
+    /**
+     * @brief Check whether the command runs as a process forked by ServiceMN
+     * @return true for plain ('C') and sandboxed ('S') commands, false for Docker
+     */
+    bool native() const {
+        return Mode == 'C' || Mode == 'S';
+    }
 };
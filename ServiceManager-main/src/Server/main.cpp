@@ -10,6 +10,32 @@
  * Endpoints:
  * - GET /process/list - Returns JSON array of all processes and their status
  * - POST /process/control - Controls processes (start/stop/kill/status)
+ * - GET /process/stats - Returns sampled CPU/memory usage, throttle and startup boost state
+ * - GET /events - Returns automatic actions taken by the server
+ * - GET /process/discovered - Returns externally started instances of services
+ * - GET /process/tree - Returns a service's process tree with CPU, RSS and FD counts
+ * - GET /process/sockets - Returns listening ports and connection counts per service
+ * - GET /process/memory - Returns memory policies and their KSM, THP and hugetlb effect
+ * - GET /process/logs - Returns captured stdout/stderr of a process
+ * - GET /process/logs/search - Finds lines in captured output
+ * - GET /manager/loop - Reports the I/O loop backend and counters
+ * - POST /process/orchestrate - Queues a restart, stop, start, swap or dependency boot
+ * - POST /process/rollout - Rolling restart of a service group
+ * - GET /operations - Returns progress of orchestrated operations
+ * - GET /process/pool - Returns warm pool state of pooled services
+ * - GET /process/scale - Returns autoscaling state of replica groups
+ * - GET /process/checkpoint - Returns CRIU checkpoint state of services
+ * - POST /process/checkpoint - Takes a fresh checkpoint of a running service
+ * - GET /audit - Returns recorded control operations, newest first
+ * - GET /process/notify - Returns sd_notify() readiness, status and watchdog state
+ * - GET /analysis/boot - Returns blame and critical chain of a recorded boot
+ * - GET /process/prefetch - Returns recorded file working sets and prefetch counters
+ * 
+ * Every POST (control operation) is recorded in an append-only audit file
+ * (see AuditFormat.hpp).
+ * 
+ * Service states are also published in a shared-memory status page for
+ * local readers (see StatusPageFormat.hpp).
  */
 
 #include <iostream>
@@ -19,21 +45,102 @@
 #include <limits>
 #include <filesystem>
 #include <cstdlib>
+#include <algorithm>
 
 #include "command.hpp"
 #include "httplib.h"
 #include "ProcessRunner.hpp"
+#include "CgroupManager.hpp"
+#include "EventLog.hpp"
+#include "ResourceSampler.hpp"
+#include "CpuGovernor.hpp"
+#include "ProcessDiscovery.hpp"
+#include "LogStore.hpp"
+#include "LogCollector.hpp"
+#include "LogSearch.hpp"
+#include "EventLoop.hpp"
+#include "EventLoopBenchmark.hpp"
+#include "Orchestrator.hpp"
+#include "WarmPool.hpp"
+#include "Autoscaler.hpp"
+#include "Checkpointer.hpp"
+#include "StatusPage.hpp"
+#include "AuditLog.hpp"
+#include "NotifyMonitor.hpp"
+#include "BootAnalyzer.hpp"
+#include "StartupBoost.hpp"
+#include "ProcessTree.hpp"
+#include "SocketInventory.hpp"
+#include "ContainerStats.hpp"
+#include "ExecCache.hpp"
+#include "Prefetcher.hpp"
+#include "MemoryPolicy.hpp"
 
 // Configuration constants
 constexpr int DEFAULT_PORT = 6755;
 constexpr const char* DEFAULT_CONFIG_PATH = "./config/cmds.conf";
 constexpr const char* FALLBACK_CONFIG_PATH = "/home/raima/.sermn/cmds.conf";
+constexpr int DEFAULT_SAMPLE_INTERVAL_MS = 1000;
+constexpr int DEFAULT_LOG_SEGMENT_MB = 64;
+constexpr int DEFAULT_LOG_KEEP_SEGMENTS = 8;
+constexpr size_t DEFAULT_LOG_TAIL_BYTES = 65536;
+constexpr size_t DEFAULT_SEARCH_LIMIT = 100;
+constexpr size_t MAX_SEARCH_LIMIT = 10000;
+constexpr size_t BENCH_EVENTLOOP_ROUNDS = 100;
+constexpr int DEFAULT_POOL_CONCURRENCY = 2;
+constexpr const char* DEFAULT_CRIU_PATH = "criu";
+constexpr const char* DEFAULT_STATUS_PAGE_PREFIX = "/dev/shm/servicemn-";
+constexpr const char* DEFAULT_AUDIT_PATH = "./audit.bin";
+constexpr const char* DEFAULT_NOTIFY_SOCKET_PREFIX = "@servicemn-notify-";
+constexpr size_t DEFAULT_AUDIT_LIMIT = 100;
+constexpr const char* DEFAULT_PREFETCH_PATH = "./prefetch.list";
 
 // Global variables
 std::vector<command> g_commands;
 std::unique_ptr<ProcessRunner> g_processRunner;
 std::string g_configPath;
 int g_port = DEFAULT_PORT;
+std::string g_cgroupRoot;
+int g_sampleIntervalMs = DEFAULT_SAMPLE_INTERVAL_MS;
+CpuAction g_defaultCpuAction = CpuAction::Off;
+std::unique_ptr<CgroupManager> g_cgroups;
+std::unique_ptr<EventLog> g_eventLog;
+std::unique_ptr<ResourceSampler> g_sampler;
+std::unique_ptr<CpuGovernor> g_cpuGovernor;
+DiscoveryMode g_defaultDiscoveryMode = DiscoveryMode::Flag;
+std::unique_ptr<ProcessDiscovery> g_discovery;
+EventBackend g_eventBackend = EventBackend::Auto;
+std::unique_ptr<EventLoop> g_eventLoop;
+std::string g_logDir;
+int g_logSegmentMb = DEFAULT_LOG_SEGMENT_MB;
+int g_logKeepSegments = DEFAULT_LOG_KEEP_SEGMENTS;
+LogMode g_defaultLogMode = LogMode::Splice;
+LogBudget g_defaultLogBudget;
+std::unique_ptr<LogStore> g_logStore;
+std::unique_ptr<LogCollector> g_logCollector;
+std::unique_ptr<Orchestrator> g_orchestrator;
+int g_poolConcurrency = DEFAULT_POOL_CONCURRENCY;
+std::unique_ptr<WarmPool> g_warmPool;
+std::unique_ptr<Autoscaler> g_autoscaler;
+std::string g_criuPath = DEFAULT_CRIU_PATH;
+std::unique_ptr<Checkpointer> g_checkpointer;
+std::string g_statusPagePath;  // Empty = DEFAULT_STATUS_PAGE_PREFIX + port
+std::unique_ptr<StatusPage> g_statusPage;
+std::string g_auditPath = DEFAULT_AUDIT_PATH;
+std::unique_ptr<AuditLog> g_auditLog;
+std::string g_notifySocketPath;  // Empty = DEFAULT_NOTIFY_SOCKET_PREFIX + port
+std::unique_ptr<NotifyMonitor> g_notifyMonitor;
+std::unique_ptr<BootAnalyzer> g_bootAnalyzer;
+std::unique_ptr<StartupBoost> g_startupBoost;
+std::unique_ptr<ProcessTree> g_processTree;
+std::unique_ptr<SocketInventory> g_socketInventory;
+std::unique_ptr<ContainerStats> g_containerStats;
+std::unique_ptr<ExecCache> g_execCache;
+bool g_checkOnly = false;
+std::string g_prefetchPath = DEFAULT_PREFETCH_PATH;
+std::unique_ptr<Prefetcher> g_prefetcher;
+thread_local int64_t t_requestStartUs = 0;  // Wall clock at the start of the current request
+thread_local std::chrono::steady_clock::time_point t_requestStart;
 
 // Function declarations
 int initializeSystem();
@@ -41,6 +148,7 @@ bool loadConfiguration();
 void startHttpServer();
 void printUsage(const char* programName);
 std::string escapeJsonString(const std::string& input);
+void auditRequest(const httplib::Request& req, const httplib::Response& res);
 
 /**
  * @brief Main entry point
@@ -77,6 +185,176 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: --port requires a port number" << std::endl;
                 return 1;
             }
+        } else if (arg == "--cgroup-root") {
+            if (i + 1 < argc) {
+                g_cgroupRoot = argv[++i];
+            } else {
+                std::cerr << "Error: --cgroup-root requires a directory" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--sample-interval") {
+            if (i + 1 < argc) {
+                try {
+                    g_sampleIntervalMs = std::stoi(argv[++i]);
+                    if (g_sampleIntervalMs < 100) {
+                        throw std::out_of_range("Interval too small");
+                    }
+                } catch (const std::exception&) {
+                    std::cerr << "Error: Invalid sample interval (minimum 100 ms)" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --sample-interval requires milliseconds" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--cpu-policy") {
+            if (i + 1 < argc) {
+                if (!CpuGovernor::parseAction(argv[++i], g_defaultCpuAction)) {
+                    std::cerr << "Error: --cpu-policy must be off, cpumax or nice" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --cpu-policy requires a policy name" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--discovery") {
+            if (i + 1 < argc) {
+                if (!ProcessDiscovery::parseMode(argv[++i], g_defaultDiscoveryMode)) {
+                    std::cerr << "Error: --discovery must be off, flag or adopt" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --discovery requires a mode" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--event-loop") {
+            if (i + 1 < argc) {
+                if (!EventLoop::parseBackend(argv[++i], g_eventBackend)) {
+                    std::cerr << "Error: --event-loop must be auto, uring or epoll" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --event-loop requires a backend" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--bench-eventloop") {
+            if (i + 1 < argc) {
+                try {
+                    int pipes = std::stoi(argv[++i]);
+                    if (pipes <= 0) {
+                        throw std::out_of_range("Value must be positive");
+                    }
+                    return runEventLoopBenchmark(static_cast<size_t>(pipes), BENCH_EVENTLOOP_ROUNDS);
+                } catch (const std::exception&) {
+                    std::cerr << "Error: --bench-eventloop requires a positive number" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --bench-eventloop requires a number of pipes" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--check") {
+            g_checkOnly = true;
+        } else if (arg == "--log-dir") {
+            if (i + 1 < argc) {
+                g_logDir = argv[++i];
+            } else {
+                std::cerr << "Error: --log-dir requires a directory" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--log-mode") {
+            if (i + 1 < argc) {
+                if (!LogCollector::parseMode(argv[++i], g_defaultLogMode)) {
+                    std::cerr << "Error: --log-mode must be off, splice, buffered or indexed" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --log-mode requires a mode" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--log-rate-bytes" || arg == "--log-rate-lines") {
+            if (i + 1 < argc) {
+                try {
+                    double value = std::stod(argv[++i]);
+                    if (value < 0) {
+                        throw std::out_of_range("Value must not be negative");
+                    }
+                    (arg == "--log-rate-bytes" ? g_defaultLogBudget.BytesPerSec
+                                               : g_defaultLogBudget.LinesPerSec) = value;
+                } catch (const std::exception&) {
+                    std::cerr << "Error: " << arg << " requires a non-negative number" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: " << arg << " requires a number" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--pool-concurrency") {
+            if (i + 1 < argc) {
+                try {
+                    g_poolConcurrency = std::stoi(argv[++i]);
+                    if (g_poolConcurrency <= 0) {
+                        throw std::out_of_range("Value must be positive");
+                    }
+                } catch (const std::exception&) {
+                    std::cerr << "Error: --pool-concurrency requires a positive number" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: --pool-concurrency requires a number" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--status-page") {
+            if (i + 1 < argc) {
+                g_statusPagePath = argv[++i];
+            } else {
+                std::cerr << "Error: --status-page requires a path or off" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--notify-socket") {
+            if (i + 1 < argc) {
+                g_notifySocketPath = argv[++i];
+            } else {
+                std::cerr << "Error: --notify-socket requires a path" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--audit-log") {
+            if (i + 1 < argc) {
+                g_auditPath = argv[++i];
+            } else {
+                std::cerr << "Error: --audit-log requires a path or off" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--prefetch") {
+            if (i + 1 < argc) {
+                g_prefetchPath = argv[++i];
+            } else {
+                std::cerr << "Error: --prefetch requires a path or off" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--criu") {
+            if (i + 1 < argc) {
+                g_criuPath = argv[++i];
+            } else {
+                std::cerr << "Error: --criu requires a path" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--log-segment-mb" || arg == "--log-keep") {
+            if (i + 1 < argc) {
+                try {
+                    int value = std::stoi(argv[++i]);
+                    if (value <= 0) {
+                        throw std::out_of_range("Value must be positive");
+                    }
+                    (arg == "--log-keep" ? g_logKeepSegments : g_logSegmentMb) = value;
+                } catch (const std::exception&) {
+                    std::cerr << "Error: " << arg << " requires a positive number" << std::endl;
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: " << arg << " requires a number" << std::endl;
+                return 1;
+            }
         } else {
             std::cerr << "Error: Unknown argument " << arg << std::endl;
             printUsage(argv[0]);
@@ -94,8 +372,158 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Resolve every executable and working directory up front, reporting all problems at once
+    g_execCache = std::make_unique<ExecCache>(g_commands);
+    auto preflightStart = std::chrono::steady_clock::now();
+    std::vector<PreflightProblem> problems = g_execCache->preflight();
+    for (size_t i = 0; i < g_commands.size(); ++i) {
+        MemoryPolicy memory;
+        std::string error;
+        if (g_commands[i].native() && !MemoryPolicy::fromCommand(g_commands[i], memory, error)) {
+            problems.push_back({i, error});
+        }
+    }
+    std::stable_sort(problems.begin(), problems.end(),
+                     [](const PreflightProblem& a, const PreflightProblem& b) { return a.Service < b.Service; });
+    auto preflightMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - preflightStart).count();
+    for (const PreflightProblem& problem : problems) {
+        std::cerr << (g_checkOnly ? "❌ " : "⚠️  ") << "[" << problem.Service << "] "
+                  << g_commands[problem.Service].Desc << ": " << problem.Message << std::endl;
+    }
+    std::cout << "🔎 Preflight: " << g_commands.size() << " services checked in " << preflightMs
+              << " ms, " << problems.size() << " problem(s)" << std::endl;
+    if (g_checkOnly) {
+        return problems.empty() ? 0 : 1;
+    }
+    
     // Create process runner
     g_processRunner = std::make_unique<ProcessRunner>(g_commands);
+    g_eventLog = std::make_unique<EventLog>();
+    g_cgroups = std::make_unique<CgroupManager>(g_cgroupRoot);
+    g_processRunner->setCgroupManager(g_cgroups.get());
+    g_processRunner->setExecCache(g_execCache.get());
+    
+    // Shared I/O loop for pipes and timers
+    g_eventLoop = EventLoop::create(g_eventBackend);
+    if (!g_eventLoop) {
+        std::cerr << "❌ Failed to initialize the event loop" << std::endl;
+        return 1;
+    }
+    std::cout << "🔁 Event loop backend: " << g_eventLoop->name() << std::endl;
+    
+    // Capture service output when a log directory is configured
+    g_logStore = std::make_unique<LogStore>(g_logDir,
+                                            static_cast<uint64_t>(g_logSegmentMb) << 20,
+                                            static_cast<size_t>(g_logKeepSegments));
+    g_logCollector = std::make_unique<LogCollector>(*g_processRunner, *g_logStore, *g_eventLog,
+                                                    *g_eventLoop, g_defaultLogMode,
+                                                    g_defaultLogBudget);
+    g_logCollector->start();
+    g_eventLoop->start();
+    g_execCache->watch(*g_eventLoop);
+    g_processRunner->setLogCollector(g_logCollector.get());
+    g_orchestrator = std::make_unique<Orchestrator>(*g_processRunner, *g_eventLoop, *g_eventLog);
+    g_bootAnalyzer = std::make_unique<BootAnalyzer>(*g_processRunner, *g_eventLoop);
+    g_orchestrator->setBootAnalyzer(g_bootAnalyzer.get());
+    g_processRunner->setBootAnalyzer(g_bootAnalyzer.get());
+    
+    // Warm the page cache with the files of the services a boot is about to start
+    if (g_prefetchPath != "off") {
+        g_prefetcher = std::make_unique<Prefetcher>(*g_processRunner, g_prefetchPath);
+        if (g_prefetcher->open()) {
+            g_orchestrator->setPrefetcher(g_prefetcher.get());
+            std::cout << "📦 Prefetch sets: " << g_prefetchPath << std::endl;
+        } else {
+            std::cerr << "⚠️  Prefetch sets " << g_prefetchPath << " could not be read, prefetch disabled" << std::endl;
+            g_prefetcher.reset();
+        }
+    }
+    
+    // Prioritise @boost services until they are ready
+    g_startupBoost = std::make_unique<StartupBoost>(*g_processRunner, *g_orchestrator, *g_cgroups,
+                                                    *g_eventLoop, *g_eventLog);
+    g_processRunner->setStartupBoost(g_startupBoost.get());
+    
+    // Exact readiness and hang detection for services speaking sd_notify()
+    if (g_notifySocketPath.empty()) {
+        g_notifySocketPath = DEFAULT_NOTIFY_SOCKET_PREFIX + std::to_string(g_port);
+    }
+    g_notifyMonitor = std::make_unique<NotifyMonitor>(*g_processRunner, *g_orchestrator, *g_eventLoop,
+                                                      *g_eventLog, g_notifySocketPath);
+    if (g_notifySocketPath == "off") {
+        std::cout << "📨 Notify socket: disabled" << std::endl;
+    } else if (g_notifyMonitor->open()) {
+        g_processRunner->setNotifyMonitor(g_notifyMonitor.get());
+        g_orchestrator->setNotifyMonitor(g_notifyMonitor.get());
+        g_notifyMonitor->start();
+        std::cout << "📨 Notify socket: " << g_notifySocketPath << std::endl;
+    } else {
+        std::cerr << "⚠️  Notify socket " << g_notifySocketPath << " not bound, @notify services use the probes" << std::endl;
+    }
+    
+    // Keep standby instances of slow-starting services ready
+    g_warmPool = std::make_unique<WarmPool>(*g_processRunner, *g_orchestrator, *g_eventLoop,
+                                            *g_eventLog, static_cast<size_t>(g_poolConcurrency));
+    g_processRunner->setWarmPool(g_warmPool.get());
+    g_warmPool->start();
+    
+    // Restore heavyweight services from CRIU images instead of cold-starting them
+    g_checkpointer = std::make_unique<Checkpointer>(*g_processRunner, *g_orchestrator, *g_eventLoop,
+                                                    *g_eventLog, g_criuPath);
+    g_processRunner->setCheckpointer(g_checkpointer.get());
+    g_checkpointer->start();
+    
+    // Publish statuses for local readers that should not poll the API
+    if (g_statusPagePath.empty()) {
+        g_statusPagePath = DEFAULT_STATUS_PAGE_PREFIX + std::to_string(g_port);
+    }
+    if (g_statusPagePath != "off") {
+        g_statusPage = std::make_unique<StatusPage>(*g_processRunner, *g_orchestrator, *g_eventLoop,
+                                                    g_statusPagePath);
+        if (g_statusPage->open()) {
+            g_processRunner->setChangeListener([]() { g_statusPage->notify(); });
+            g_statusPage->start();
+            std::cout << "📄 Status page: " << g_statusPagePath << std::endl;
+        } else {
+            std::cerr << "⚠️  Status page " << g_statusPagePath << " not published" << std::endl;
+        }
+    }
+    
+    // Sample resource usage and police CPU hogs in the background
+    g_sampler = std::make_unique<ResourceSampler>(*g_processRunner, g_cgroups.get(),
+                                                  std::chrono::milliseconds(g_sampleIntervalMs));
+    g_containerStats = std::make_unique<ContainerStats>(g_commands.size(), *g_eventLoop, *g_eventLog);
+    g_sampler->setContainerStats(g_containerStats.get());
+    g_cpuGovernor = std::make_unique<CpuGovernor>(*g_processRunner, *g_cgroups, *g_eventLog,
+                                                  g_defaultCpuAction);
+    g_discovery = std::make_unique<ProcessDiscovery>(*g_processRunner, *g_eventLog,
+                                                     g_defaultDiscoveryMode);
+    g_discovery->scan();
+    g_processTree = std::make_unique<ProcessTree>(*g_processRunner, *g_discovery, *g_eventLog);
+    g_socketInventory = std::make_unique<SocketInventory>(*g_processTree, g_commands.size());
+    g_sampler->addListener([](const std::vector<ServiceSample>& samples) {
+        g_cpuGovernor->onSample(samples);
+        g_discovery->scan();
+        g_processTree->onSample(samples);  // Walks the index built by the scan
+    });
+    g_sampler->start();
+    
+    // Scale replica groups between their @scale.min and @scale.max
+    g_autoscaler = std::make_unique<Autoscaler>(*g_processRunner, *g_orchestrator, *g_sampler,
+                                                *g_eventLoop, *g_eventLog);
+    g_autoscaler->start();
+    
+    // Record who controlled which service
+    if (g_auditPath != "off") {
+        g_auditLog = std::make_unique<AuditLog>(g_auditPath);
+        if (g_auditLog->open()) {
+            std::cout << "🧾 Audit log: " << g_auditPath << std::endl;
+        } else {
+            std::cerr << "⚠️  Audit log " << g_auditPath << " could not be opened, auditing disabled" << std::endl;
+            g_auditLog.reset();
+        }
+    }
     
     std::cout << "✅ Loaded " << g_commands.size() << " commands from configuration" << std::endl;
     std::cout << "🌐 Starting HTTP server on port " << g_port << std::endl;
@@ -103,6 +531,19 @@ int main(int argc, char* argv[]) {
     // Start HTTP server
     startHttpServer();
     
+    g_autoscaler->stop();
+    g_sampler->stop();
+    g_warmPool->stop();
+    g_logCollector->stop();
+    g_eventLoop->stop();
+    if (g_prefetcher) {
+        g_prefetcher->stop();
+    }
+    g_processRunner->setChangeListener(nullptr);
+    g_statusPage.reset();
+    if (g_auditLog) {
+        g_auditLog->stop();
+    }
     return 0;
 }
 
@@ -143,9 +584,10 @@ int initializeSystem() {
  * Line 1: Number of commands (N)
  * For each command (N times):
  *   Line 1: Description
- *   Line 2: Mode (C for command, D for Docker)
+ *   Line 2: Mode (C for command, S for sandboxed command, D for Docker)
  *   Line 3: Path/Command
  *   Line 4: Working directory
+ *   Optional lines: "@key=value" per-service options (e.g. @cpu.policy=cpumax)
  */
 bool loadConfiguration() {
     std::ifstream file(g_configPath);
@@ -182,9 +624,9 @@ bool loadConfiguration() {
         file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         
         // Validate mode
-        if (cmd.Mode != 'C' && cmd.Mode != 'D') {
+        if (cmd.Mode != 'C' && cmd.Mode != 'S' && cmd.Mode != 'D') {
             std::cerr << "❌ Invalid mode '" << cmd.Mode << "' for command " << i 
-                      << ". Must be 'C' (command) or 'D' (Docker)" << std::endl;
+                      << ". Must be 'C' (command), 'S' (sandboxed command) or 'D' (Docker)" << std::endl;
             return false;
         }
         
@@ -200,6 +642,19 @@ bool loadConfiguration() {
             return false;
         }
         
+        // Read optional "@key=value" option lines
+        while (file.peek() == '@') {
+            std::string optionLine;
+            std::getline(file, optionLine);
+            auto eq = optionLine.find('=');
+            if (eq == std::string::npos || eq == 1) {
+                std::cerr << "❌ Invalid option line '" << optionLine << "' for command " << i
+                          << ". Expected @key=value" << std::endl;
+                return false;
+            }
+            cmd.Options[optionLine.substr(1, eq - 1)] = optionLine.substr(eq + 1);
+        }
+        
         // Validate required fields
         if (cmd.Desc.empty() || cmd.Path.empty()) {
             std::cerr << "❌ Empty description or path for command " << i << std::endl;
@@ -207,7 +662,7 @@ bool loadConfiguration() {
         }
         
         g_commands.push_back(std::move(cmd));
-        std::cout << "📝 Loaded: " << cmd.Desc << " (" << cmd.Mode << ")" << std::endl;
+        std::cout << "📝 Loaded: " << g_commands.back().Desc << " (" << g_commands.back().Mode << ")" << std::endl;
     }
     
     return true;
@@ -215,27 +670,131 @@ bool loadConfiguration() {
 
 /**
  * @brief Escape special characters in JSON strings
+ *
+ * Captured output and request text are arbitrary bytes: control characters
+ * become \u00XX escapes and invalid UTF-8 sequences are replaced by U+FFFD,
+ * so the result is always valid JSON.
  */
 std::string escapeJsonString(const std::string& input) {
     std::string result;
     result.reserve(input.length() * 2); // Reserve space for potential escaping
     
-    for (char c : input) {
-        switch (c) {
-            case '"':  result += "\\\""; break;
-            case '\\': result += "\\\\"; break;
-            case '\b': result += "\\b";  break;
-            case '\f': result += "\\f";  break;
-            case '\n': result += "\\n";  break;
-            case '\r': result += "\\r";  break;
-            case '\t': result += "\\t";  break;
-            default:   result += c;      break;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(input.data());
+    size_t length = input.size();
+    for (size_t i = 0; i < length;) {
+        unsigned char c = bytes[i];
+        if (c < 0x80) {
+            switch (c) {
+                case '"':  result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\b': result += "\\b";  break;
+                case '\f': result += "\\f";  break;
+                case '\n': result += "\\n";  break;
+                case '\r': result += "\\r";  break;
+                case '\t': result += "\\t";  break;
+                default:
+                    if (c < 0x20) {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        result += escaped;
+                    } else {
+                        result += static_cast<char>(c);
+                    }
+                    break;
+            }
+            ++i;
+            continue;
+        }
+        
+        // Length and smallest second byte of a well-formed sequence (RFC 3629)
+        size_t size = 0;
+        unsigned char low = 0x80, high = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            size = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            size = 3;
+            low = c == 0xE0 ? 0xA0 : 0x80;   // No overlong forms
+            high = c == 0xED ? 0x9F : 0xBF;  // No surrogates
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            size = 4;
+            low = c == 0xF0 ? 0x90 : 0x80;
+            high = c == 0xF4 ? 0x8F : 0xBF;  // Nothing above U+10FFFF
+        }
+        bool valid = size > 0 && i + size <= length && bytes[i + 1] >= low && bytes[i + 1] <= high;
+        for (size_t k = 2; valid && k < size; ++k) {
+            valid = (bytes[i + k] & 0xC0) == 0x80;
+        }
+        if (valid) {
+            result.append(input, i, size);
+            i += size;
+        } else {
+            result += "\xEF\xBF\xBD";  // U+FFFD replacement character
+            ++i;
         }
     }
     
     return result;
 }
 
+/**
+ * @brief Queue an audit record for a handled control request
+ * 
+ * Runs on the HTTP worker thread; AuditLog::record() only copies the
+ * record into its lock-free queue.
+ */
+void auditRequest(const httplib::Request& req, const httplib::Response& res) {
+    AuditEntry entry;
+    entry.TimestampUs = t_requestStartUs;
+    entry.LatencyUs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t_requestStart).count());
+    entry.Status = res.status;
+    entry.Client = req.remote_addr + ":" + std::to_string(req.remote_port);
+    
+    if (req.path == "/process/control") {
+        entry.Operation = AUDIT_CONTROL;
+        entry.Action = req.get_param_value("fn");
+    } else if (req.path == "/process/orchestrate") {
+        entry.Operation = AUDIT_ORCHESTRATE;
+        entry.Action = req.get_param_value("op");
+    } else if (req.path == "/process/rollout") {
+        entry.Operation = AUDIT_ROLLOUT;
+        entry.Action = req.has_param("action") ? req.get_param_value("action") : "start";
+    } else if (req.path == "/process/checkpoint") {
+        entry.Operation = AUDIT_CHECKPOINT;
+        entry.Action = "dump";
+    } else {
+        entry.Action = req.path;
+    }
+    
+    // Target as requested: a service ID, a group or an operation
+    if (req.has_param("id")) {
+        entry.Target = req.get_param_value("id");
+        char* end = nullptr;
+        long id = strtol(entry.Target.c_str(), &end, 10);
+        if (!entry.Target.empty() && *end == '\0' && id >= 0 && id < static_cast<long>(g_commands.size())) {
+            entry.Service = static_cast<int>(id);
+        }
+    } else if (req.has_param("group")) {
+        entry.Target = "group " + req.get_param_value("group");
+    } else if (req.has_param("operation")) {
+        entry.Target = "operation " + req.get_param_value("operation");
+    }
+    // Response body on one line, whitespace runs collapsed
+    for (char c : res.body) {
+        if (entry.Result.size() >= AUDIT_MAX_RESULT) {
+            break;
+        }
+        if (isspace(static_cast<unsigned char>(c))) {
+            if (!entry.Result.empty() && entry.Result.back() != ' ') {
+                entry.Result += ' ';
+            }
+        } else {
+            entry.Result += c;
+        }
+    }
+    g_auditLog->record(entry);
+}
+
 /**
  * @brief Start HTTP server and handle requests
  */
@@ -244,12 +803,22 @@ void startHttpServer() {
     
     // Enable CORS for web interface
     server.set_pre_routing_handler([](const httplib::Request&, httplib::Response& res) {
+        t_requestStart = std::chrono::steady_clock::now();
+        t_requestStartUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
         res.set_header("Access-Control-Allow-Origin", "*");
         res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
         res.set_header("Access-Control-Allow-Headers", "Content-Type");
         return httplib::Server::HandlerResponse::Unhandled;
     });
     
+    // Audit control operations once handled, before the response is sent
+    server.set_post_routing_handler([](const httplib::Request& req, httplib::Response& res) {
+        if (g_auditLog && req.method == "POST") {
+            auditRequest(req, res);
+        }
+    });
+    
     // Handle OPTIONS requests for CORS
     server.Options(".*", [](const httplib::Request&, httplib::Response& res) {
         return; // Headers already set in pre-routing handler
@@ -267,11 +836,11 @@ void startHttpServer() {
                     jsonResponse += ",\n";
                 }
                 
-                const auto& cmd = g_commands[i];
+                command cmd = g_processRunner->getCommand(i);
                 jsonResponse += "  {\n";
                 jsonResponse += "    \"id\": " + std::to_string(i) + ",\n";
                 jsonResponse += "    \"desc\": \"" + escapeJsonString(cmd.Desc) + "\",\n";
-                jsonResponse += "    \"status\": \"" + (cmd.Status == RUNNING ? "RUNNING" : "DEAD") + "\",\n";
+                jsonResponse += "    \"status\": \"" + std::string(cmd.Status == RUNNING ? "RUNNING" : "DEAD") + "\",\n";
                 jsonResponse += "    \"mode\": \"" + std::string(1, cmd.Mode) + "\",\n";
                 jsonResponse += "    \"pid\": " + std::to_string(cmd.Pid) + "\n";
                 jsonResponse += "  }";
@@ -325,12 +894,24 @@ void startHttpServer() {
             
             // Execute requested function
             if (function == "start") {
-                if (g_commands[id].Status == RUNNING) {
-                    res.set_content("Process is already running (PID: " + 
-                                  std::to_string(g_commands[id].Pid) + ")", "text/plain");
+                // The sampler's last /proc pass tells whether a hand-started copy is running
+                pid_t external = g_processRunner->isRunning(id) ? -1 : g_discovery->externalPid(id);
+                
+                if (external > 0) {
+                    res.status = 409;
+                    res.set_content("Process is already running outside ServiceMN (PID: " +
+                                  std::to_string(external) + ")", "text/plain");
                 } else {
-                    pid_t pid = g_processRunner->start(id);
-                    if (pid > 0) {
+                    // The already-running check happens under the runner's lock
+                    bool alreadyRunning = false;
+                    pid_t pid = g_processRunner->start(id, &alreadyRunning);
+                    if (alreadyRunning) {
+                        res.set_content("Process is already running (PID: " + 
+                                      std::to_string(pid) + ")", "text/plain");
+                    } else if (pid == 0) {
+                        res.status = 202;
+                        res.set_content("Process is being restored from its checkpoint", "text/plain");
+                    } else if (pid > 0) {
                         res.set_content("Process started successfully (PID: " + 
                                       std::to_string(pid) + ")", "text/plain");
                     } else {
@@ -349,12 +930,13 @@ void startHttpServer() {
                 }
                 
             } else if (function == "status") {
-                const auto& cmd = g_commands[id];
+                command cmd = g_processRunner->getCommand(id);
                 std::string statusResponse = "{\n";
                 statusResponse += "  \"id\": " + std::to_string(id) + ",\n";
                 statusResponse += "  \"desc\": \"" + escapeJsonString(cmd.Desc) + "\",\n";
-                statusResponse += "  \"status\": \"" + (cmd.Status == RUNNING ? "RUNNING" : "DEAD") + "\",\n";
-                statusResponse += "  \"pid\": " + std::to_string(cmd.Pid) + "\n";
+                statusResponse += "  \"status\": \"" + std::string(cmd.Status == RUNNING ? "RUNNING" : "DEAD") + "\",\n";
+                statusResponse += "  \"pid\": " + std::to_string(cmd.Pid) + ",\n";
+                statusResponse += "  \"adopted\": " + std::string(cmd.Adopted ? "true" : "false") + "\n";
                 statusResponse += "}";
                 res.set_content(statusResponse, "application/json");
                 
@@ -371,6 +953,1005 @@ void startHttpServer() {
         }
     });
     
+    /**
+     * GET /process/stats - Return sampled resource usage and CPU throttle state
+     */
+    server.Get("/process/stats", [](const httplib::Request&, httplib::Response& res) {
+        try {
+            auto samples = g_sampler->latest();
+            std::string jsonResponse = "[\n";
+            
+            for (size_t i = 0; i < samples.size(); ++i) {
+                if (i > 0) {
+                    jsonResponse += ",\n";
+                }
+                
+                const auto& sample = samples[i];
+                auto throttle = g_cpuGovernor->state(i);
+                char cpu[32];
+                snprintf(cpu, sizeof(cpu), "%.1f", sample.CpuPercent);
+                jsonResponse += "  {\n";
+                jsonResponse += "    \"id\": " + std::to_string(i) + ",\n";
+                jsonResponse += "    \"pid\": " + std::to_string(sample.Pid) + ",\n";
+                jsonResponse += "    \"cpu\": " + std::string(cpu) + ",\n";
+                jsonResponse += "    \"rssKb\": " + std::to_string(sample.RssKb) + ",\n";
+                if (g_commands[i].Mode == 'D') {
+                    jsonResponse += "    \"ioReadBytes\": " + std::to_string(sample.IoReadBytes) + ",\n";
+                    jsonResponse += "    \"ioWriteBytes\": " + std::to_string(sample.IoWriteBytes) + ",\n";
+                    jsonResponse += "    \"cgroup\": \"" + escapeJsonString(g_containerStats->cgroupPath(i)) + "\",\n";
+                }
+                auto capture = g_logCollector->stats(i);
+                jsonResponse += "    \"logBytes\": " + std::to_string(capture.Bytes) + ",\n";
+                jsonResponse += "    \"logSplicedBytes\": " + std::to_string(capture.SplicedBytes) + ",\n";
+                jsonResponse += "    \"logDroppedBytes\": " + std::to_string(capture.DroppedBytes) + ",\n";
+                jsonResponse += "    \"logDroppedLines\": " + std::to_string(capture.DroppedLines) + ",\n";
+                jsonResponse += "    \"logSuppressing\": " + std::string(capture.Suppressing ? "true" : "false") + ",\n";
+                jsonResponse += "    \"throttled\": " + std::string(throttle.Throttled ? "true" : "false") + ",\n";
+                jsonResponse += "    \"throttle\": \"" + throttle.Mechanism + "\",\n";
+                auto boost = g_startupBoost->stats(i);
+                char boostMs[32];
+                snprintf(boostMs, sizeof(boostMs), "%.1f", boost.LastMs);
+                jsonResponse += "    \"boosted\": " + std::string(boost.Active ? "true" : "false") + ",\n";
+                jsonResponse += "    \"boost\": \"" + boost.Mechanism + "\",\n";
+                jsonResponse += "    \"boosts\": " + std::to_string(boost.Boosts) + ",\n";
+                jsonResponse += "    \"boostTimeouts\": " + std::to_string(boost.TimedOut) + ",\n";
+                jsonResponse += "    \"lastBoostMs\": " + std::string(boostMs) + "\n";
+                jsonResponse += "  }";
+            }
+            
+            jsonResponse += "\n]";
+            res.set_content(jsonResponse, "application/json");
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Error in /process/stats: " << e.what() << std::endl;
+            res.status = 500;
+            res.set_content("Internal server error", "text/plain");
+        }
+    });
+    
+    /**
+     * GET /events - Return automatic actions recorded by the server
+     * Parameters:
+     * - since: Only return events with a greater sequence number (optional)
+     */
+    server.Get("/events", [](const httplib::Request& req, httplib::Response& res) {
+        uint64_t since = 0;
+        if (req.has_param("since")) {
+            try {
+                since = std::stoull(req.get_param_value("since"));
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content("Invalid since parameter: must be a number", "text/plain");
+                return;
+            }
+        }
+        
+        auto events = g_eventLog->since(since);
+        std::string jsonResponse = "[\n";
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (i > 0) {
+                jsonResponse += ",\n";
+            }
+            const auto& event = events[i];
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"seq\": " + std::to_string(event.Seq) + ",\n";
+            jsonResponse += "    \"time\": " + std::to_string(event.TimestampMs) + ",\n";
+            jsonResponse += "    \"id\": " + std::to_string(event.Service) + ",\n";
+            jsonResponse += "    \"kind\": \"" + escapeJsonString(event.Kind) + "\",\n";
+            jsonResponse += "    \"message\": \"" + escapeJsonString(event.Message) + "\"\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/tree - Descendant tree of a service at the last sampling tick
+     * 
+     * Parameters:
+     * - id: Process ID (index in commands array)
+     */
+    server.Get("/process/tree", [](const httplib::Request& req, httplib::Response& res) {
+        int id = -1;
+        try {
+            id = std::stoi(req.get_param_value("id"));
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Missing or invalid id parameter", "text/plain");
+            return;
+        }
+        if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+            res.status = 404;
+            res.set_content("Process ID out of range", "text/plain");
+            return;
+        }
+        
+        auto processes = g_processTree->tree(static_cast<size_t>(id));
+        double totalCpu = 0.0;
+        uint64_t totalRss = 0;
+        int64_t totalFds = 0;
+        std::string jsonProcesses;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            const auto& process = processes[i];
+            totalCpu += process.CpuPercent;
+            totalRss += process.RssKb;
+            totalFds += process.Fds > 0 ? process.Fds : 0;
+            char cpu[32];
+            snprintf(cpu, sizeof(cpu), "%.1f", process.CpuPercent);
+            jsonProcesses += i > 0 ? ",\n" : "\n";
+            jsonProcesses += "    {\"pid\": " + std::to_string(process.Pid) +
+                             ", \"ppid\": " + std::to_string(process.PPid) +
+                             ", \"depth\": " + std::to_string(process.Depth) +
+                             ", \"cpu\": " + std::string(cpu) +
+                             ", \"rssKb\": " + std::to_string(process.RssKb) +
+                             ", \"threads\": " + std::to_string(process.Threads) +
+                             ", \"fds\": " + std::to_string(process.Fds) +
+                             ", \"fdLeak\": " + std::string(process.FdLeak ? "true" : "false") +
+                             ", \"cmdline\": \"" + escapeJsonString(process.Cmdline) + "\"}";
+        }
+        char cpu[32];
+        snprintf(cpu, sizeof(cpu), "%.1f", totalCpu);
+        
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"id\": " + std::to_string(id) + ",\n";
+        jsonResponse += "  \"desc\": \"" + escapeJsonString(g_commands[id].Desc) + "\",\n";
+        jsonResponse += "  \"count\": " + std::to_string(processes.size()) + ",\n";
+        jsonResponse += "  \"cpu\": " + std::string(cpu) + ",\n";
+        jsonResponse += "  \"rssKb\": " + std::to_string(totalRss) + ",\n";
+        jsonResponse += "  \"fds\": " + std::to_string(totalFds) + ",\n";
+        jsonResponse += "  \"processes\": [" + jsonProcesses + (processes.empty() ? "]" : "\n  ]") + "\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/sockets - Listening ports, connection counts per state and
+     * queue sizes of each service's process tree
+     * 
+     * Parameters:
+     * - id: Only this service (optional)
+     * - port: Only services listening on this port, e.g. to find who holds it (optional)
+     */
+    server.Get("/process/sockets", [](const httplib::Request& req, httplib::Response& res) {
+        int id = -1;
+        int port = -1;
+        try {
+            if (req.has_param("id")) {
+                id = std::stoi(req.get_param_value("id"));
+            }
+            if (req.has_param("port")) {
+                port = std::stoi(req.get_param_value("port"));
+            }
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Invalid id or port parameter", "text/plain");
+            return;
+        }
+        if (req.has_param("id") && (id < 0 || id >= static_cast<int>(g_commands.size()))) {
+            res.status = 404;
+            res.set_content("Process ID out of range", "text/plain");
+            return;
+        }
+        
+        auto services = g_socketInventory->services();
+        auto stats = g_socketInventory->stats();
+        if (!stats.Error.empty()) {
+            res.status = 503;
+            res.set_content("Socket inventory failed: " + stats.Error, "text/plain");
+            return;
+        }
+        char duration[32];
+        snprintf(duration, sizeof(duration), "%.3f", stats.DurationMs);
+        
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"scan\": {\"scans\": " + std::to_string(stats.Scans) +
+                        ", \"dumped\": " + std::to_string(stats.Dumped) +
+                        ", \"matched\": " + std::to_string(stats.Matched) +
+                        ", \"durationMs\": " + std::string(duration) + "},\n";
+        jsonResponse += "  \"services\": [";
+        bool first = true;
+        for (size_t i = 0; i < services.size(); ++i) {
+            const auto& service = services[i];
+            if (id >= 0 && static_cast<int>(i) != id) {
+                continue;
+            }
+            std::string jsonListening;
+            for (const auto& listener : service.Listening) {
+                if (port >= 0 && listener.Port != port) {
+                    continue;
+                }
+                jsonListening += jsonListening.empty() ? "\n" : ",\n";
+                jsonListening += "        {\"proto\": \"" + listener.Protocol +
+                                 "\", \"address\": \"" + listener.Address +
+                                 "\", \"port\": " + std::to_string(listener.Port) +
+                                 ", \"recvQ\": " + std::to_string(listener.RecvQ) +
+                                 ", \"sendQ\": " + std::to_string(listener.SendQ) + "}";
+            }
+            if (port >= 0 && jsonListening.empty()) {
+                continue;
+            }
+            std::string jsonStates;
+            for (const auto& state : service.States) {
+                jsonStates += jsonStates.empty() ? "" : ", ";
+                jsonStates += "\"" + state.first + "\": " + std::to_string(state.second);
+            }
+            
+            jsonResponse += first ? "\n" : ",\n";
+            first = false;
+            jsonResponse += "    {\n";
+            jsonResponse += "      \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "      \"desc\": \"" + escapeJsonString(g_commands[i].Desc) + "\",\n";
+            jsonResponse += "      \"sockets\": " + std::to_string(service.Sockets) + ",\n";
+            jsonResponse += "      \"recvQ\": " + std::to_string(service.RecvQ) + ",\n";
+            jsonResponse += "      \"sendQ\": " + std::to_string(service.SendQ) + ",\n";
+            jsonResponse += "      \"states\": {" + jsonStates + "},\n";
+            jsonResponse += "      \"listening\": [" + jsonListening + (jsonListening.empty() ? "]" : "\n      ]") + "\n";
+            jsonResponse += "    }";
+        }
+        jsonResponse += first ? "]\n" : "\n  ]\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/discovered - Return running instances of services that were
+     * started outside ServiceMN, plus statistics of the last /proc pass
+     */
+    server.Get("/process/discovered", [](const httplib::Request&, httplib::Response& res) {
+        auto instances = g_discovery->instances();
+        auto stats = g_discovery->stats();
+        char duration[32];
+        snprintf(duration, sizeof(duration), "%.3f", stats.DurationMs);
+        
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"scan\": {\"passes\": " + std::to_string(stats.Passes) +
+                        ", \"pids\": " + std::to_string(stats.Pids) +
+                        ", \"indexed\": " + std::to_string(stats.Indexed) +
+                        ", \"durationMs\": " + std::string(duration) + "},\n";
+        jsonResponse += "  \"instances\": [\n";
+        for (size_t i = 0; i < instances.size(); ++i) {
+            if (i > 0) {
+                jsonResponse += ",\n";
+            }
+            const auto& instance = instances[i];
+            jsonResponse += "    {\n";
+            jsonResponse += "      \"id\": " + std::to_string(instance.Service) + ",\n";
+            jsonResponse += "      \"pid\": " + std::to_string(instance.Entry.Pid) + ",\n";
+            jsonResponse += "      \"cmdline\": \"" + escapeJsonString(instance.Entry.Cmdline) + "\",\n";
+            jsonResponse += "      \"cwd\": \"" + escapeJsonString(instance.Entry.Cwd) + "\",\n";
+            jsonResponse += "      \"exeInode\": " + std::to_string(instance.Entry.ExeIno) + ",\n";
+            jsonResponse += "      \"adopted\": " + std::string(instance.Adopted ? "true" : "false") + "\n";
+            jsonResponse += "    }";
+        }
+        jsonResponse += "\n  ]\n}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/memory - Memory policies of running native services and their effect
+     * 
+     * Parameters:
+     * - id: Process ID (optional, default all)
+     * 
+     * Reads smaps_rollup, status and ksm_stat of every process in each tree.
+     */
+    server.Get("/process/memory", [](const httplib::Request& req, httplib::Response& res) {
+        int id = -1;
+        if (req.has_param("id")) {
+            try {
+                id = std::stoi(req.get_param_value("id"));
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content("Invalid id parameter: must be a number", "text/plain");
+                return;
+            }
+            if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+                res.status = 404;
+                res.set_content("Process ID out of range", "text/plain");
+                return;
+            }
+        }
+        
+        KsmHostState ksm = KsmHostState::read();
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"ksm\": {\"available\": " + std::string(ksm.Available ? "true" : "false") +
+                        ", \"run\": " + std::to_string(ksm.Run) +
+                        ", \"pagesShared\": " + std::to_string(ksm.PagesShared) +
+                        ", \"pagesSharing\": " + std::to_string(ksm.PagesSharing) + "},\n";
+        jsonResponse += "  \"services\": [";
+        bool first = true;
+        for (size_t i = 0; i < g_commands.size(); ++i) {
+            command cmd = g_processRunner->getCommand(i);
+            if ((id >= 0 && static_cast<size_t>(id) != i) || !cmd.native() ||
+                cmd.Status != RUNNING || cmd.Pid <= 0) {
+                continue;
+            }
+            MemoryPolicy policy;
+            std::string error;
+            MemoryPolicy::fromCommand(cmd, policy, error);
+            
+            // The tree of the last sampling tick, or just the main process before the first one
+            MemoryUsage usage;
+            auto processes = g_processTree->tree(i);
+            if (processes.empty()) {
+                usage.add(cmd.Pid, true);
+            }
+            for (const auto& process : processes) {
+                usage.add(process.Pid, process.Depth == 0);
+            }
+            
+            jsonResponse += first ? "\n" : ",\n";
+            first = false;
+            jsonResponse += "    {\n";
+            jsonResponse += "      \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "      \"desc\": \"" + escapeJsonString(cmd.Desc) + "\",\n";
+            jsonResponse += "      \"ksm\": " + std::string(policy.Ksm ? "true" : "false") + ",\n";
+            jsonResponse += "      \"thp\": \"" + std::string(MemoryPolicy::thpName(policy.Thp)) + "\",\n";
+            jsonResponse += "      \"numaNode\": " + std::to_string(policy.PreferredNode) + ",\n";
+            jsonResponse += "      \"error\": \"" + escapeJsonString(error) + "\",\n";
+            jsonResponse += "      \"processes\": " + std::to_string(usage.Processes) + ",\n";
+            jsonResponse += "      \"rssKb\": " + std::to_string(usage.RssKb) + ",\n";
+            jsonResponse += "      \"anonHugeKb\": " + std::to_string(usage.AnonHugeKb) + ",\n";
+            jsonResponse += "      \"fileHugeKb\": " + std::to_string(usage.FileHugeKb) + ",\n";
+            jsonResponse += "      \"hugetlbKb\": " + std::to_string(usage.HugetlbKb) + ",\n";
+            jsonResponse += "      \"ksmMergingPages\": " + std::to_string(usage.KsmMergingPages) + ",\n";
+            jsonResponse += "      \"ksmProfitBytes\": " + std::to_string(usage.KsmProfitBytes) + ",\n";
+            jsonResponse += "      \"ksmMergeAny\": " + std::string(usage.KsmMergeAny ? "true" : "false") + ",\n";
+            jsonResponse += "      \"thpDisabled\": " + std::string(usage.ThpDisabled ? "true" : "false") + "\n";
+            jsonResponse += "    }";
+        }
+        jsonResponse += first ? "]\n" : "\n  ]\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/logs - Return the most recent captured output of a process
+     * Parameters:
+     * - id: Process ID (index in commands array)
+     * - bytes: Maximum number of output bytes (optional, default 64 KiB)
+     * - timestamps: "1" to prefix each captured chunk with its capture time
+     */
+    server.Get("/process/logs", [](const httplib::Request& req, httplib::Response& res) {
+        if (!g_logStore->enabled()) {
+            res.status = 404;
+            res.set_content("Output capture is disabled (start the server with --log-dir)", "text/plain");
+            return;
+        }
+        
+        int id;
+        size_t bytes = DEFAULT_LOG_TAIL_BYTES;
+        try {
+            id = std::stoi(req.get_param_value("id"));
+            if (req.has_param("bytes")) {
+                bytes = std::stoull(req.get_param_value("bytes"));
+            }
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Invalid id or bytes parameter: must be a number", "text/plain");
+            return;
+        }
+        if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+            res.status = 404;
+            res.set_content("Process ID out of range", "text/plain");
+            return;
+        }
+        
+        bool timestamps = req.get_param_value("timestamps") == "1";
+        std::string output;
+        for (const auto& chunk : g_logStore->tail(id, bytes)) {
+            if (timestamps) {
+                time_t seconds = static_cast<time_t>(chunk.TimestampUs / 1000000);
+                struct tm utc;
+                gmtime_r(&seconds, &utc);
+                char stamp[48];
+                size_t length = strftime(stamp, sizeof(stamp), "[%Y-%m-%dT%H:%M:%S", &utc);
+                snprintf(stamp + length, sizeof(stamp) - length, ".%06lldZ %s] ",
+                         static_cast<long long>(chunk.TimestampUs % 1000000),
+                         chunk.Stream == LOG_STDERR ? "err" : chunk.Stream == LOG_MARKER ? "---" : "out");
+                output += stamp;
+            }
+            output += chunk.Data;
+        }
+        res.set_content(output, "application/octet-stream");
+    });
+    
+    /**
+     * GET /process/logs/search - Find lines in a process's captured output
+     * Parameters:
+     * - id: Process ID (index in commands array)
+     * - q: Fixed string to search for
+     * - since: Unix time in seconds; older output is skipped (optional)
+     * - limit: Maximum number of matching lines (optional, default 100)
+     */
+    server.Get("/process/logs/search", [](const httplib::Request& req, httplib::Response& res) {
+        if (!g_logStore->enabled()) {
+            res.status = 404;
+            res.set_content("Output capture is disabled (start the server with --log-dir)", "text/plain");
+            return;
+        }
+        
+        std::string pattern = req.get_param_value("q");
+        if (pattern.empty()) {
+            res.status = 400;
+            res.set_content("Missing required parameter: q", "text/plain");
+            return;
+        }
+        
+        int id;
+        int64_t sinceUs = 0;
+        size_t limit = DEFAULT_SEARCH_LIMIT;
+        try {
+            id = std::stoi(req.get_param_value("id"));
+            if (req.has_param("since")) {
+                sinceUs = static_cast<int64_t>(std::stod(req.get_param_value("since")) * 1e6);
+            }
+            if (req.has_param("limit")) {
+                limit = std::min<size_t>(std::stoull(req.get_param_value("limit")), MAX_SEARCH_LIMIT);
+            }
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Invalid id, since or limit parameter: must be a number", "text/plain");
+            return;
+        }
+        if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+            res.status = 404;
+            res.set_content("Process ID out of range", "text/plain");
+            return;
+        }
+        
+        LogSearch search(*g_logStore);
+        auto result = search.search(id, pattern, sinceUs, limit);
+        
+        char duration[32];
+        snprintf(duration, sizeof(duration), "%.3f", result.DurationMs);
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"truncated\": " + std::string(result.Truncated ? "true" : "false") + ",\n";
+        jsonResponse += "  \"bytesScanned\": " + std::to_string(result.BytesScanned) + ",\n";
+        jsonResponse += "  \"durationMs\": " + std::string(duration) + ",\n";
+        jsonResponse += "  \"matches\": [\n";
+        for (size_t i = 0; i < result.Matches.size(); ++i) {
+            if (i > 0) {
+                jsonResponse += ",\n";
+            }
+            const auto& match = result.Matches[i];
+            jsonResponse += "    {\"segment\": \"" + match.Segment + "\"" +
+                            ", \"offset\": " + std::to_string(match.Offset) +
+                            ", \"line\": " + std::to_string(match.Line) +
+                            ", \"time\": " + std::to_string(match.TimestampUs / 1000) +
+                            ", \"stream\": \"" + (match.Stream == LOG_STDERR ? "stderr" : "stdout") + "\"" +
+                            ", \"text\": \"" + escapeJsonString(match.Text) + "\"}";
+        }
+        jsonResponse += "\n  ]\n}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /manager/loop - Event loop backend and counters
+     */
+    server.Get("/manager/loop", [](const httplib::Request&, httplib::Response& res) {
+        auto stats = g_eventLoop->stats();
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"backend\": \"" + std::string(g_eventLoop->name()) + "\",\n";
+        jsonResponse += "  \"syscalls\": " + std::to_string(stats.Syscalls) + ",\n";
+        jsonResponse += "  \"waits\": " + std::to_string(stats.Waits) + ",\n";
+        jsonResponse += "  \"events\": " + std::to_string(stats.Events) + ",\n";
+        jsonResponse += "  \"timers\": " + std::to_string(stats.Timers) + "\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * POST /process/orchestrate - Queue a multi-step operation
+     * 
+     * Parameters:
+     * - op: restart, stop, start, boot or swap
+     * - id: Process ID (optional for boot: all services)
+     * 
+     * Returns 202 with the operation ID; progress is reported by GET /operations.
+     */
+    server.Post("/process/orchestrate", [](const httplib::Request& req, httplib::Response& res) {
+        OperationKind kind;
+        if (!req.has_param("op") || !Orchestrator::parseKind(req.get_param_value("op"), kind)) {
+            res.status = 400;
+            res.set_content("Missing or invalid op parameter: restart, stop, start, boot or swap", "text/plain");
+            return;
+        }
+        int id = -1;
+        if (req.has_param("id")) {
+            try {
+                id = std::stoi(req.get_param_value("id"));
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content("Invalid id parameter: must be a number", "text/plain");
+                return;
+            }
+            if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+                res.status = 404;
+                res.set_content("Process ID out of range", "text/plain");
+                return;
+            }
+        } else if (kind != OperationKind::Boot) {
+            res.status = 400;
+            res.set_content("Missing required parameter: id", "text/plain");
+            return;
+        }
+        
+        uint64_t operation = g_orchestrator->submit(kind, id);
+        res.status = 202;
+        res.set_content("{\"operation\": " + std::to_string(operation) + "}", "application/json");
+    });
+    
+    /**
+     * POST /process/rollout - Rolling restart of a service group
+     * 
+     * Parameters:
+     * - group: Value of the members' @group option
+     * - maxUnavailable: Members down at once, count or percentage (default: 25%)
+     * - maxSurge: Extra instances at once, count or percentage (default: 25%)
+     * 
+     * Or, to control a paused rollout:
+     * - operation: Operation ID returned when the rollout was queued
+     * - action: resume or abort
+     */
+    server.Post("/process/rollout", [](const httplib::Request& req, httplib::Response& res) {
+        if (req.has_param("operation")) {
+            std::string action = req.get_param_value("action");
+            uint64_t operation = 0;
+            try {
+                operation = std::stoull(req.get_param_value("operation"));
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content("Invalid operation parameter: must be a number", "text/plain");
+                return;
+            }
+            if (action != "resume" && action != "abort") {
+                res.status = 400;
+                res.set_content("Invalid action parameter: resume or abort", "text/plain");
+                return;
+            }
+            if (!g_orchestrator->controlRollout(operation, action == "resume")) {
+                res.status = 404;
+                res.set_content("No rollout in progress with this operation ID", "text/plain");
+                return;
+            }
+            res.set_content("Rollout " + action + " requested", "text/plain");
+            return;
+        }
+        
+        if (!req.has_param("group")) {
+            res.status = 400;
+            res.set_content("Missing required parameter: group", "text/plain");
+            return;
+        }
+        std::string maxUnavailable = req.has_param("maxUnavailable") ?
+            req.get_param_value("maxUnavailable") : "25%";
+        std::string maxSurge = req.has_param("maxSurge") ? req.get_param_value("maxSurge") : "25%";
+        std::string error;
+        uint64_t operation = g_orchestrator->submitRollout(req.get_param_value("group"),
+                                                           maxUnavailable, maxSurge, error);
+        if (operation == 0) {
+            res.status = error.find("already") != std::string::npos ? 409 : 400;
+            res.set_content(error, "text/plain");
+            return;
+        }
+        res.status = 202;
+        res.set_content("{\"operation\": " + std::to_string(operation) + "}", "application/json");
+    });
+    
+    /**
+     * GET /operations - Recent orchestrated operations, oldest first
+     */
+    server.Get("/operations", [](const httplib::Request&, httplib::Response& res) {
+        auto operations = g_orchestrator->operations();
+        std::string jsonResponse = "[\n";
+        for (size_t i = 0; i < operations.size(); ++i) {
+            if (i > 0) {
+                jsonResponse += ",\n";
+            }
+            const auto& operation = operations[i];
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"operation\": " + std::to_string(operation.Id) + ",\n";
+            jsonResponse += "    \"op\": \"" + std::string(Orchestrator::kindName(operation.Kind)) + "\",\n";
+            jsonResponse += "    \"id\": " + std::to_string(operation.Service) + ",\n";
+            if (operation.Kind == OperationKind::Rollout) {
+                jsonResponse += "    \"group\": \"" + escapeJsonString(operation.Group) + "\",\n";
+                jsonResponse += "    \"completed\": " + std::to_string(operation.Completed) + ",\n";
+                jsonResponse += "    \"total\": " + std::to_string(operation.Total) + ",\n";
+            }
+            jsonResponse += "    \"state\": \"" + operation.State + "\",\n";
+            jsonResponse += "    \"step\": \"" + escapeJsonString(operation.Step) + "\",\n";
+            jsonResponse += "    \"message\": \"" + escapeJsonString(operation.Message) + "\",\n";
+            jsonResponse += "    \"started\": " + std::to_string(operation.StartedMs) + ",\n";
+            jsonResponse += "    \"finished\": " + std::to_string(operation.FinishedMs) + "\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /analysis/boot - Timeline of a boot ranked by activation time, with its critical chain
+     * 
+     * Parameters:
+     * - operation: Operation ID of the boot (optional, default: the most recent boot)
+     */
+    server.Get("/analysis/boot", [](const httplib::Request& req, httplib::Response& res) {
+        uint64_t operation = 0;
+        if (req.has_param("operation")) {
+            try {
+                operation = std::stoull(req.get_param_value("operation"));
+            } catch (const std::exception&) {
+                res.status = 400;
+                res.set_content("Invalid operation parameter: must be a number", "text/plain");
+                return;
+            }
+        }
+        BootAnalysis analysis;
+        if (!g_bootAnalyzer->analysis(operation, analysis)) {
+            res.status = 404;
+            res.set_content("No such boot recorded; start one with POST /process/orchestrate?op=boot",
+                            "text/plain");
+            return;
+        }
+        
+        auto ms = [](double value) {
+            char text[32];
+            snprintf(text, sizeof(text), "%.1f", value);
+            return std::string(value < 0 ? "-1" : text);
+        };
+        auto timingsJson = [&ms](const std::vector<BootTiming>& timings) {
+            std::string json = "[";
+            for (size_t i = 0; i < timings.size(); ++i) {
+                const BootTiming& timing = timings[i];
+                std::string after;
+                for (size_t dependency : timing.After) {
+                    after += (after.empty() ? "" : ", ") + std::to_string(dependency);
+                }
+                json += i > 0 ? ",\n" : "\n";
+                json += "    {\"id\": " + std::to_string(timing.Index) +
+                        ", \"desc\": \"" + escapeJsonString(timing.Desc) + "\"" +
+                        ", \"state\": \"" + timing.State + "\"" +
+                        ", \"after\": [" + after + "]" +
+                        ", \"pid\": " + std::to_string(timing.Pid) +
+                        ", \"spawnMs\": " + ms(timing.SpawnMs) +
+                        ", \"execMs\": " + ms(timing.ExecMs) +
+                        ", \"readyMs\": " + ms(timing.ReadyMs) +
+                        ", \"doneMs\": " + ms(timing.DoneMs) +
+                        ", \"activationMs\": " + ms(timing.activationMs()) +
+                        ", \"execError\": \"" + escapeJsonString(timing.ExecError) + "\"}";
+            }
+            return json + (timings.empty() ? "]" : "\n  ]");
+        };
+        
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"operation\": " + std::to_string(analysis.Operation) + ",\n";
+        jsonResponse += "  \"id\": " + std::to_string(analysis.Service) + ",\n";
+        jsonResponse += "  \"state\": \"" + analysis.State + "\",\n";
+        jsonResponse += "  \"started\": " + std::to_string(analysis.StartedMs) + ",\n";
+        jsonResponse += "  \"totalMs\": " + ms(analysis.TotalMs) + ",\n";
+        jsonResponse += "  \"blame\": " + timingsJson(analysis.Blame) + ",\n";
+        jsonResponse += "  \"criticalChain\": " + timingsJson(analysis.CriticalChain) + "\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/pool - Warm pool state of services with @pool.size
+     */
+    server.Get("/process/pool", [](const httplib::Request&, httplib::Response& res) {
+        std::string jsonResponse = "[\n";
+        bool first = true;
+        for (size_t i = 0; i < g_commands.size(); ++i) {
+            WarmPoolStats stats = g_warmPool->stats(i);
+            if (stats.Size == 0) {
+                continue;
+            }
+            char warmMs[32];
+            snprintf(warmMs, sizeof(warmMs), "%.1f", stats.LastWarmMs);
+            if (!first) {
+                jsonResponse += ",\n";
+            }
+            first = false;
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "    \"desc\": \"" + escapeJsonString(g_commands[i].Desc) + "\",\n";
+            jsonResponse += "    \"size\": " + std::to_string(stats.Size) + ",\n";
+            jsonResponse += "    \"ready\": " + std::to_string(stats.Ready) + ",\n";
+            jsonResponse += "    \"warming\": " + std::to_string(stats.Warming) + ",\n";
+            jsonResponse += "    \"handedOut\": " + std::to_string(stats.HandedOut) + ",\n";
+            jsonResponse += "    \"failed\": " + std::to_string(stats.Failed) + ",\n";
+            jsonResponse += "    \"lost\": " + std::to_string(stats.Lost) + ",\n";
+            jsonResponse += "    \"lastWarmMs\": " + std::string(warmMs) + "\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/notify - sd_notify() state of services with @notify or @watchdog
+     */
+    server.Get("/process/notify", [](const httplib::Request&, httplib::Response& res) {
+        std::string jsonResponse = "[\n";
+        bool first = true;
+        for (size_t i = 0; i < g_commands.size(); ++i) {
+            if (!g_notifyMonitor->enabled(i)) {
+                continue;
+            }
+            NotifyStats stats = g_notifyMonitor->stats(i);
+            if (!first) {
+                jsonResponse += ",\n";
+            }
+            first = false;
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "    \"desc\": \"" + escapeJsonString(g_commands[i].Desc) + "\",\n";
+            jsonResponse += "    \"pid\": " + std::to_string(stats.Pid) + ",\n";
+            jsonResponse += "    \"ready\": " + std::string(stats.Ready ? "true" : "false") + ",\n";
+            jsonResponse += "    \"state\": \"" + stats.State + "\",\n";
+            jsonResponse += "    \"status\": \"" + escapeJsonString(stats.Status) + "\",\n";
+            jsonResponse += "    \"errno\": " + std::to_string(stats.Errno) + ",\n";
+            jsonResponse += "    \"watchdogMs\": " + std::to_string(stats.WatchdogUs / 1000) + ",\n";
+            jsonResponse += "    \"lastPing\": " + std::to_string(stats.LastPingMs) + ",\n";
+            jsonResponse += "    \"messages\": " + std::to_string(stats.Messages) + ",\n";
+            jsonResponse += "    \"pings\": " + std::to_string(stats.Pings) + ",\n";
+            jsonResponse += "    \"misses\": " + std::to_string(stats.Misses) + "\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/scale - Autoscaling state of groups with @scale.max
+     */
+    server.Get("/process/scale", [](const httplib::Request&, httplib::Response& res) {
+        std::string jsonResponse = "[\n";
+        bool first = true;
+        for (const auto& status : g_autoscaler->status()) {
+            char value[32];
+            snprintf(value, sizeof(value), "%.2f", status.Value);
+            char target[32];
+            snprintf(target, sizeof(target), "%.2f", status.Target);
+            if (!first) {
+                jsonResponse += ",\n";
+            }
+            first = false;
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"group\": \"" + escapeJsonString(status.Group) + "\",\n";
+            jsonResponse += "    \"metric\": \"" + escapeJsonString(status.Metric) + "\",\n";
+            jsonResponse += "    \"min\": " + std::to_string(status.Min) + ",\n";
+            jsonResponse += "    \"max\": " + std::to_string(status.Max) + ",\n";
+            jsonResponse += "    \"current\": " + std::to_string(status.Current) + ",\n";
+            jsonResponse += "    \"desired\": " + std::to_string(status.Desired) + ",\n";
+            jsonResponse += "    \"value\": " + std::string(value) + ",\n";
+            jsonResponse += "    \"target\": " + std::string(target) + ",\n";
+            jsonResponse += "    \"error\": \"" + escapeJsonString(status.Error) + "\",\n";
+            jsonResponse += "    \"lastAction\": \"" + status.LastAction + "\",\n";
+            jsonResponse += "    \"lastActionAt\": " + std::to_string(status.LastActionMs) + "\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/prefetch - Recorded working sets and prefetch counters
+     * 
+     * Parameters:
+     * - id: Process index (optional, lists the files of one service)
+     */
+    server.Get("/process/prefetch", [](const httplib::Request& req, httplib::Response& res) {
+        if (!g_prefetcher) {
+            res.status = 404;
+            res.set_content("Prefetch is disabled (--prefetch off)", "text/plain");
+            return;
+        }
+        int id = -1;
+        if (req.has_param("id")) {
+            try {
+                id = std::stoi(req.get_param_value("id"));
+            } catch (const std::exception&) {
+                id = -1;
+            }
+            if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+                res.status = 404;
+                res.set_content("Invalid process ID", "text/plain");
+                return;
+            }
+        }
+        
+        PrefetchStats stats = g_prefetcher->stats();
+        char lastBootMs[32];
+        snprintf(lastBootMs, sizeof(lastBootMs), "%.1f", stats.LastBootMs);
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"file\": \"" + escapeJsonString(g_prefetcher->path()) + "\",\n";
+        jsonResponse += "  \"boots\": " + std::to_string(stats.Boots) + ",\n";
+        jsonResponse += "  \"services\": " + std::to_string(stats.Services) + ",\n";
+        jsonResponse += "  \"files\": " + std::to_string(stats.Files) + ",\n";
+        jsonResponse += "  \"bytes\": " + std::to_string(stats.Bytes) + ",\n";
+        jsonResponse += "  \"missing\": " + std::to_string(stats.Missing) + ",\n";
+        jsonResponse += "  \"lastBootMs\": " + std::string(lastBootMs) + ",\n";
+        jsonResponse += "  \"sets\": [";
+        bool first = true;
+        for (size_t i = 0; i < g_commands.size(); ++i) {
+            if (id >= 0 && static_cast<size_t>(id) != i) {
+                continue;
+            }
+            PrefetchSet set = g_prefetcher->set(i);
+            jsonResponse += first ? "\n" : ",\n";
+            first = false;
+            jsonResponse += "    {\n";
+            jsonResponse += "      \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "      \"desc\": \"" + escapeJsonString(g_commands[i].Desc) + "\",\n";
+            jsonResponse += "      \"recorded\": " + std::to_string(set.Recorded.size()) + ",\n";
+            jsonResponse += "      \"configured\": " + std::to_string(set.Configured.size());
+            if (id >= 0) {
+                jsonResponse += ",\n      \"files\": [";
+                set.Configured.insert(set.Configured.end(), set.Recorded.begin(), set.Recorded.end());
+                for (size_t f = 0; f < set.Configured.size(); ++f) {
+                    jsonResponse += (f == 0 ? "\n" : ",\n");
+                    jsonResponse += "        \"" + escapeJsonString(set.Configured[f]) + "\"";
+                }
+                jsonResponse += set.Configured.empty() ? "]" : "\n      ]";
+            }
+            jsonResponse += "\n    }";
+        }
+        jsonResponse += first ? "]\n" : "\n  ]\n";
+        jsonResponse += "}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * GET /process/checkpoint - CRIU checkpoint state of services with @criu.dir
+     */
+    server.Get("/process/checkpoint", [](const httplib::Request&, httplib::Response& res) {
+        std::string jsonResponse = "[\n";
+        bool first = true;
+        for (size_t i = 0; i < g_commands.size(); ++i) {
+            CheckpointStats stats = g_checkpointer->stats(i);
+            if (stats.Dir.empty()) {
+                continue;
+            }
+            char dumpMs[32];
+            snprintf(dumpMs, sizeof(dumpMs), "%.1f", stats.LastDumpMs);
+            char restoreMs[32];
+            snprintf(restoreMs, sizeof(restoreMs), "%.1f", stats.LastRestoreMs);
+            if (!first) {
+                jsonResponse += ",\n";
+            }
+            first = false;
+            jsonResponse += "  {\n";
+            jsonResponse += "    \"id\": " + std::to_string(i) + ",\n";
+            jsonResponse += "    \"desc\": \"" + escapeJsonString(g_commands[i].Desc) + "\",\n";
+            jsonResponse += "    \"dir\": \"" + escapeJsonString(stats.Dir) + "\",\n";
+            jsonResponse += "    \"image\": " + std::string(stats.Image ? "true" : "false") + ",\n";
+            jsonResponse += "    \"dumping\": " + std::string(stats.Dumping ? "true" : "false") + ",\n";
+            jsonResponse += "    \"checkpoints\": " + std::to_string(stats.Checkpoints) + ",\n";
+            jsonResponse += "    \"restores\": " + std::to_string(stats.Restores) + ",\n";
+            jsonResponse += "    \"failures\": " + std::to_string(stats.Failures) + ",\n";
+            jsonResponse += "    \"lastDumpMs\": " + std::string(dumpMs) + ",\n";
+            jsonResponse += "    \"lastRestoreMs\": " + std::string(restoreMs) + ",\n";
+            jsonResponse += "    \"error\": \"" + escapeJsonString(stats.LastError) + "\"\n";
+            jsonResponse += "  }";
+        }
+        jsonResponse += "\n]";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
+    /**
+     * POST /process/checkpoint - Replace the image of a running service
+     * 
+     * Parameters:
+     * - id: Process index (required)
+     */
+    server.Post("/process/checkpoint", [](const httplib::Request& req, httplib::Response& res) {
+        if (!req.has_param("id")) {
+            res.status = 400;
+            res.set_content("Missing required parameter: id", "text/plain");
+            return;
+        }
+        int id;
+        try {
+            id = std::stoi(req.get_param_value("id"));
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Invalid id parameter: must be a number", "text/plain");
+            return;
+        }
+        if (id < 0 || id >= static_cast<int>(g_commands.size())) {
+            res.status = 404;
+            res.set_content("Process ID out of range", "text/plain");
+            return;
+        }
+        if (!g_checkpointer->checkpoint(static_cast<size_t>(id))) {
+            res.status = 409;
+            res.set_content("Process has no @criu.dir or is not running", "text/plain");
+            return;
+        }
+        res.status = 202;
+        res.set_content("Checkpoint started", "text/plain");
+    });
+    
+    /**
+     * GET /audit - Recorded control operations, newest first
+     * Parameters:
+     * - since, until: Unix time in seconds bounding the records (optional)
+     * - id: Only operations on this process ID (optional)
+     * - op: Only control, orchestrate, rollout, checkpoint or other (optional)
+     * - limit: Maximum number of records (optional, default 100)
+     */
+    server.Get("/audit", [](const httplib::Request& req, httplib::Response& res) {
+        if (!g_auditLog) {
+            res.status = 404;
+            res.set_content("Auditing is disabled (--audit-log off)", "text/plain");
+            return;
+        }
+        
+        AuditQuery filter;
+        filter.Limit = DEFAULT_AUDIT_LIMIT;
+        try {
+            if (req.has_param("since")) {
+                filter.SinceUs = static_cast<int64_t>(std::stod(req.get_param_value("since")) * 1e6);
+            }
+            if (req.has_param("until")) {
+                filter.UntilUs = static_cast<int64_t>(std::stod(req.get_param_value("until")) * 1e6);
+            }
+            if (req.has_param("id")) {
+                filter.Service = std::stoi(req.get_param_value("id"));
+            }
+            if (req.has_param("limit")) {
+                filter.Limit = std::min<size_t>(std::stoull(req.get_param_value("limit")), MAX_SEARCH_LIMIT);
+            }
+        } catch (const std::exception&) {
+            res.status = 400;
+            res.set_content("Invalid since, until, id or limit parameter: must be a number", "text/plain");
+            return;
+        }
+        if (req.has_param("op")) {
+            std::string op = req.get_param_value("op");
+            for (int code = AUDIT_OTHER; code <= AUDIT_CHECKPOINT; ++code) {
+                if (op == auditOperationName(static_cast<uint8_t>(code))) {
+                    filter.Operation = code;
+                }
+            }
+            if (filter.Operation < 0) {
+                res.status = 400;
+                res.set_content("Invalid op parameter: control, orchestrate, rollout, checkpoint or other", "text/plain");
+                return;
+            }
+        }
+        
+        auto entries = g_auditLog->query(filter);
+        auto stats = g_auditLog->stats();
+        std::string jsonResponse = "{\n";
+        jsonResponse += "  \"file\": \"" + escapeJsonString(g_auditLog->path()) + "\",\n";
+        jsonResponse += "  \"recorded\": " + std::to_string(stats.Recorded) + ",\n";
+        jsonResponse += "  \"written\": " + std::to_string(stats.Written) + ",\n";
+        jsonResponse += "  \"dropped\": " + std::to_string(stats.Dropped) + ",\n";
+        jsonResponse += "  \"bytes\": " + std::to_string(stats.Bytes) + ",\n";
+        jsonResponse += "  \"indexBlocks\": " + std::to_string(stats.Indexes) + ",\n";
+        jsonResponse += "  \"entries\": [\n";
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i > 0) {
+                jsonResponse += ",\n";
+            }
+            const auto& entry = entries[i];
+            jsonResponse += "    {\"time\": " + std::to_string(entry.TimestampUs / 1000) +
+                            ", \"client\": \"" + escapeJsonString(entry.Client) + "\"" +
+                            ", \"op\": \"" + auditOperationName(entry.Operation) + "\"" +
+                            ", \"action\": \"" + escapeJsonString(entry.Action) + "\"" +
+                            ", \"target\": \"" + escapeJsonString(entry.Target) + "\"" +
+                            ", \"id\": " + std::to_string(entry.Service) +
+                            ", \"status\": " + std::to_string(entry.Status) +
+                            ", \"latencyUs\": " + std::to_string(entry.LatencyUs) +
+                            ", \"result\": \"" + escapeJsonString(entry.Result) + "\"}";
+        }
+        jsonResponse += "\n  ]\n}";
+        res.set_content(jsonResponse, "application/json");
+    });
+    
     // Health check endpoint
     server.Get("/health", [](const httplib::Request&, httplib::Response& res) {
         res.set_content("OK", "text/plain");
@@ -380,6 +1961,26 @@ void startHttpServer() {
     std::cout << "🎯 Server endpoints:" << std::endl;
     std::cout << "   GET  /process/list    - List all processes" << std::endl;
     std::cout << "   POST /process/control - Control processes" << std::endl;
+    std::cout << "   GET  /process/stats   - Resource usage and throttling" << std::endl;
+    std::cout << "   GET  /events          - Automatic actions log" << std::endl;
+    std::cout << "   GET  /process/tree    - Process tree with CPU, RSS and FDs" << std::endl;
+    std::cout << "   GET  /process/sockets - Listening ports and connections" << std::endl;
+    std::cout << "   GET  /process/memory  - KSM, THP and NUMA policies and their effect" << std::endl;
+    std::cout << "   GET  /process/discovered - Externally started instances" << std::endl;
+    std::cout << "   GET  /process/logs    - Captured process output" << std::endl;
+    std::cout << "   GET  /process/logs/search - Search captured output" << std::endl;
+    std::cout << "   GET  /manager/loop    - I/O loop backend and counters" << std::endl;
+    std::cout << "   POST /process/orchestrate - Restart/stop/start/boot/swap as an operation" << std::endl;
+    std::cout << "   POST /process/rollout - Rolling restart of a service group" << std::endl;
+    std::cout << "   GET  /operations      - Orchestrated operation progress" << std::endl;
+    std::cout << "   GET  /process/pool    - Warm pool standby instances" << std::endl;
+    std::cout << "   GET  /process/scale   - Replica group autoscaling" << std::endl;
+    std::cout << "   GET  /process/checkpoint - CRIU checkpoint images" << std::endl;
+    std::cout << "   GET  /process/prefetch - Recorded working sets and prefetch counters" << std::endl;
+    std::cout << "   POST /process/checkpoint - Take a fresh checkpoint" << std::endl;
+    std::cout << "   GET  /process/notify  - sd_notify() readiness and watchdogs" << std::endl;
+    std::cout << "   GET  /analysis/boot   - Blame and critical chain of a boot" << std::endl;
+    std::cout << "   GET  /audit           - Recorded control operations" << std::endl;
     std::cout << "   GET  /health          - Health check" << std::endl;
     std::cout << std::endl;
     
@@ -399,6 +2000,25 @@ void printUsage(const char* programName) {
     std::cout << "  -h, --help           Show this help message" << std::endl;
     std::cout << "  -c, --config FILE    Configuration file path" << std::endl;
     std::cout << "  -p, --port PORT      HTTP server port (default: " << DEFAULT_PORT << ")" << std::endl;
+    std::cout << "  --cgroup-root DIR    Delegated cgroup v2 directory for per-service cgroups" << std::endl;
+    std::cout << "  --sample-interval MS Resource sampling period (default: " << DEFAULT_SAMPLE_INTERVAL_MS << ")" << std::endl;
+    std::cout << "  --cpu-policy NAME    Default CPU hog policy: off, cpumax or nice (default: off)" << std::endl;
+    std::cout << "  --discovery MODE     External instance handling: off, flag or adopt (default: flag)" << std::endl;
+    std::cout << "  --log-dir DIR        Capture service stdout/stderr below DIR" << std::endl;
+    std::cout << "  --log-mode MODE      Default capture mode: off, splice, buffered or indexed (default: splice)" << std::endl;
+    std::cout << "  --log-segment-mb N   Log segment size (default: " << DEFAULT_LOG_SEGMENT_MB << ")" << std::endl;
+    std::cout << "  --log-keep N         Segments kept per service (default: " << DEFAULT_LOG_KEEP_SEGMENTS << ")" << std::endl;
+    std::cout << "  --event-loop NAME    I/O loop backend: auto, uring or epoll (default: auto)" << std::endl;
+    std::cout << "  --bench-eventloop N  Compare the I/O loop backends on N pipes and exit" << std::endl;
+    std::cout << "  --check              Preflight the configuration, print all problems and exit" << std::endl;
+    std::cout << "  --log-rate-bytes N   Default output budget in bytes/sec (default: 0 = unlimited)" << std::endl;
+    std::cout << "  --log-rate-lines N   Default output budget in lines/sec (default: 0 = unlimited)" << std::endl;
+    std::cout << "  --pool-concurrency N Warm pool standbys started at once (default: " << DEFAULT_POOL_CONCURRENCY << ")" << std::endl;
+    std::cout << "  --status-page PATH   Shared-memory status page, or off (default: " << DEFAULT_STATUS_PAGE_PREFIX << "<port>)" << std::endl;
+    std::cout << "  --notify-socket PATH NOTIFY_SOCKET for @notify services, or off (default: " << DEFAULT_NOTIFY_SOCKET_PREFIX << "<port>)" << std::endl;
+    std::cout << "  --audit-log PATH     Audit trail of control operations, or off (default: " << DEFAULT_AUDIT_PATH << ")" << std::endl;
+    std::cout << "  --prefetch PATH      Recorded boot working sets, or off (default: " << DEFAULT_PREFETCH_PATH << ")" << std::endl;
+    std::cout << "  --criu PATH          criu binary for @criu.dir services (default: " << DEFAULT_CRIU_PATH << ")" << std::endl;
     std::cout << std::endl;
     std::cout << "Default config locations:" << std::endl;
     std::cout << "  1. " << DEFAULT_CONFIG_PATH << std::endl;
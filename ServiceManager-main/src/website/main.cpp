@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 
 // Platform-specific includes
 #ifdef _WIN32